@@ -0,0 +1,115 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/boost_program_options-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/boost_program_options-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/libboost_program_options-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_program_options-1.74.0/libboost_program_options-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/check_pgn.dir/DependInfo.cmake"
+  "CMakeFiles/check_perft.dir/DependInfo.cmake"
+  "CMakeFiles/check_unit.dir/DependInfo.cmake"
+  "CMakeFiles/check.dir/DependInfo.cmake"
+  "CMakeFiles/kpk-generator.dir/DependInfo.cmake"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/DependInfo.cmake"
+  "CMakeFiles/chessengine.dir/DependInfo.cmake"
+  "CMakeFiles/chess-tune.dir/DependInfo.cmake"
+  "CMakeFiles/chess-match.dir/DependInfo.cmake"
+  "CMakeFiles/chessengine-static.dir/DependInfo.cmake"
+  "CMakeFiles/chess_bench.dir/DependInfo.cmake"
+  "CMakeFiles/example_test.dir/DependInfo.cmake"
+  "CMakeFiles/example2_test.dir/DependInfo.cmake"
+  "CMakeFiles/perft_parser_test.dir/DependInfo.cmake"
+  "CMakeFiles/chessboard_test.dir/DependInfo.cmake"
+  "CMakeFiles/fenrank_test.dir/DependInfo.cmake"
+  "CMakeFiles/fenobject_test.dir/DependInfo.cmake"
+  "CMakeFiles/possible_move_test.dir/DependInfo.cmake"
+  "CMakeFiles/check_test.dir/DependInfo.cmake"
+  "CMakeFiles/game_test.dir/DependInfo.cmake"
+  "CMakeFiles/ai_search_test.dir/DependInfo.cmake"
+  "CMakeFiles/ai_search2_test.dir/DependInfo.cmake"
+  "CMakeFiles/evaluate_test.dir/DependInfo.cmake"
+  "CMakeFiles/uci_communication_test.dir/DependInfo.cmake"
+  "CMakeFiles/board_test.dir/DependInfo.cmake"
+  "CMakeFiles/move_generation_test.dir/DependInfo.cmake"
+  "CMakeFiles/nnue_test.dir/DependInfo.cmake"
+  "CMakeFiles/endgame_test.dir/DependInfo.cmake"
+  "CMakeFiles/syzygy_test.dir/DependInfo.cmake"
+  "CMakeFiles/polyglot_test.dir/DependInfo.cmake"
+  "CMakeFiles/book_builder_test.dir/DependInfo.cmake"
+  "CMakeFiles/pgn_reader_test.dir/DependInfo.cmake"
+  "CMakeFiles/pgn_lexer_test.dir/DependInfo.cmake"
+  "CMakeFiles/san_test.dir/DependInfo.cmake"
+  "CMakeFiles/pgn_validation_test.dir/DependInfo.cmake"
+  "CMakeFiles/epd_test.dir/DependInfo.cmake"
+  "CMakeFiles/trace_test.dir/DependInfo.cmake"
+  "CMakeFiles/sprt_test.dir/DependInfo.cmake"
+  "CMakeFiles/gensfen_test.dir/DependInfo.cmake"
+  "CMakeFiles/tuner_test.dir/DependInfo.cmake"
+  "CMakeFiles/match_test.dir/DependInfo.cmake"
+  )
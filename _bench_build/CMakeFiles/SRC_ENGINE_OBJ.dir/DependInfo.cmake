@@ -0,0 +1,57 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/chess_engine/ai/ai-launcher.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-launcher.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-launcher.cc.o.d"
+  "/root/repo/src/chess_engine/ai/ai-mini.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-mini.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-mini.cc.o.d"
+  "/root/repo/src/chess_engine/ai/bench.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/bench.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/bench.cc.o.d"
+  "/root/repo/src/chess_engine/ai/endgame.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/endgame.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/endgame.cc.o.d"
+  "/root/repo/src/chess_engine/ai/epd-suite.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/epd-suite.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/epd-suite.cc.o.d"
+  "/root/repo/src/chess_engine/ai/evaluation.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/evaluation.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/evaluation.cc.o.d"
+  "/root/repo/src/chess_engine/ai/gensfen.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/gensfen.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/gensfen.cc.o.d"
+  "/root/repo/src/chess_engine/ai/kpk.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/kpk.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/kpk.cc.o.d"
+  "/root/repo/src/chess_engine/ai/search-stats.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/search-stats.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/search-stats.cc.o.d"
+  "/root/repo/src/chess_engine/ai/transposition-table.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/transposition-table.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/transposition-table.cc.o.d"
+  "/root/repo/src/chess_engine/ai/uci.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/uci.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/uci.cc.o.d"
+  "/root/repo/src/chess_engine/board/board.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/board.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/board.cc.o.d"
+  "/root/repo/src/chess_engine/board/chessboard.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/chessboard.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/chessboard.cc.o.d"
+  "/root/repo/src/chess_engine/board/move-generation.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-generation.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-generation.cc.o.d"
+  "/root/repo/src/chess_engine/board/move-initialization.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-initialization.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-initialization.cc.o.d"
+  "/root/repo/src/chess_engine/book/book-builder.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/book-builder.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/book-builder.cc.o.d"
+  "/root/repo/src/chess_engine/book/polyglot.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/polyglot.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/polyglot.cc.o.d"
+  "/root/repo/src/chess_engine/nnue/accumulator.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/accumulator.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/accumulator.cc.o.d"
+  "/root/repo/src/chess_engine/nnue/network.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/network.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/network.cc.o.d"
+  "/root/repo/src/chess_engine/syzygy/table.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/table.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/table.cc.o.d"
+  "/root/repo/src/chess_engine/syzygy/tablebase.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/tablebase.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/tablebase.cc.o.d"
+  "/root/repo/src/listener/listener-manager.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/listener/listener-manager.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/listener/listener-manager.cc.o.d"
+  "/root/repo/src/match/engine-process.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/engine-process.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/engine-process.cc.o.d"
+  "/root/repo/src/match/match.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/match.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/match.cc.o.d"
+  "/root/repo/src/match/sprt.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/sprt.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/sprt.cc.o.d"
+  "/root/repo/src/parsing/epd_parser/epd-parser.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/epd_parser/epd-parser.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/epd_parser/epd-parser.cc.o.d"
+  "/root/repo/src/parsing/option_parser/option-parser.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/option_parser/option-parser.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/option_parser/option-parser.cc.o.d"
+  "/root/repo/src/parsing/perft_parser/perft-parser.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/perft_parser/perft-parser.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/perft_parser/perft-parser.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-database.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-database.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-database.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-exception.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-exception.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-exception.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-lexer.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-lexer.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-lexer.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-move.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-move.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-move.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-parser.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-parser.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-parser.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-reader.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-reader.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-reader.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/pgn-validation.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-validation.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-validation.cc.o.d"
+  "/root/repo/src/parsing/pgn_parser/san.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/san.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/san.cc.o.d"
+  "/root/repo/src/tuner/tuner.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/tuner/tuner.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/tuner/tuner.cc.o.d"
+  "/root/repo/src/utils/mapped-file.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/mapped-file.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/mapped-file.cc.o.d"
+  "/root/repo/src/utils/trace.cc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/trace.cc.o" "gcc" "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/trace.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
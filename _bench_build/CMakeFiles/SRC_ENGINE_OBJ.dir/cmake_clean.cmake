@@ -0,0 +1,88 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-launcher.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-launcher.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-mini.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/ai-mini.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/bench.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/bench.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/endgame.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/endgame.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/epd-suite.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/epd-suite.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/evaluation.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/evaluation.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/gensfen.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/gensfen.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/kpk.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/kpk.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/search-stats.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/search-stats.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/transposition-table.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/transposition-table.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/uci.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/ai/uci.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/board.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/board.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/chessboard.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/chessboard.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-generation.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-generation.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-initialization.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/board/move-initialization.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/book-builder.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/book-builder.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/polyglot.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/book/polyglot.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/accumulator.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/accumulator.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/network.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/nnue/network.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/table.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/table.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/tablebase.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/chess_engine/syzygy/tablebase.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/listener/listener-manager.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/listener/listener-manager.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/engine-process.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/engine-process.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/match.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/match.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/sprt.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/match/sprt.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/epd_parser/epd-parser.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/epd_parser/epd-parser.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/option_parser/option-parser.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/option_parser/option-parser.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/perft_parser/perft-parser.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/perft_parser/perft-parser.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-database.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-database.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-exception.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-exception.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-lexer.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-lexer.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-move.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-move.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-parser.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-parser.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-reader.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-reader.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-validation.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/pgn-validation.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/san.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/parsing/pgn_parser/san.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/tuner/tuner.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/tuner/tuner.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/mapped-file.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/mapped-file.cc.o.d"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/trace.cc.o"
+  "CMakeFiles/SRC_ENGINE_OBJ.dir/src/utils/trace.cc.o.d"
+  "generated/kpk-bitbase.inc"
+  "libSRC_ENGINE_OBJ.a"
+  "libSRC_ENGINE_OBJ.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SRC_ENGINE_OBJ.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
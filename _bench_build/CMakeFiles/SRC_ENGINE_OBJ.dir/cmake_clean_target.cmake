@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libSRC_ENGINE_OBJ.a"
+)
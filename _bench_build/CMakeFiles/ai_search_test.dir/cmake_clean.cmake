@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ai_search_test.dir/tests/unit_tests/ai_search_test.cc.o"
+  "CMakeFiles/ai_search_test.dir/tests/unit_tests/ai_search_test.cc.o.d"
+  "ai_search_test"
+  "ai_search_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ai_search_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
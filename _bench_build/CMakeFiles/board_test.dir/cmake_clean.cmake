@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/board_test.dir/tests/unit_tests/board_test.cc.o"
+  "CMakeFiles/board_test.dir/tests/unit_tests/board_test.cc.o.d"
+  "board_test"
+  "board_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/board_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/book_builder_test.dir/tests/unit_tests/book_builder_test.cc.o"
+  "CMakeFiles/book_builder_test.dir/tests/unit_tests/book_builder_test.cc.o.d"
+  "book_builder_test"
+  "book_builder_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/book_builder_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
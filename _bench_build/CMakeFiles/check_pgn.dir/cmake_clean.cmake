@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/check_pgn"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/check_pgn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
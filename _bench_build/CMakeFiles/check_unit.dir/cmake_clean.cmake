@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/check_unit"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/check_unit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
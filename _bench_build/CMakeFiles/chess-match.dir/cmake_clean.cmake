@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/chess-match"
+  "/root/repo/chess-match.pdb"
+  "CMakeFiles/chess-match.dir/src/match/main.cc.o"
+  "CMakeFiles/chess-match.dir/src/match/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chess-match.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/chess-tune"
+  "/root/repo/chess-tune.pdb"
+  "CMakeFiles/chess-tune.dir/src/tuner/main.cc.o"
+  "CMakeFiles/chess-tune.dir/src/tuner/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chess-tune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/chess_bench.dir/tests/benchmarks/chess_bench.cc.o"
+  "CMakeFiles/chess_bench.dir/tests/benchmarks/chess_bench.cc.o.d"
+  "chess_bench"
+  "chess_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chess_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/chessboard_test.dir/tests/unit_tests/chessboard_test.cc.o"
+  "CMakeFiles/chessboard_test.dir/tests/unit_tests/chessboard_test.cc.o.d"
+  "chessboard_test"
+  "chessboard_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chessboard_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
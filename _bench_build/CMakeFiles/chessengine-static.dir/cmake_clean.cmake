@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/chessengine-static"
+  "/root/repo/chessengine-static.pdb"
+  "CMakeFiles/chessengine-static.dir/src/main.cc.o"
+  "CMakeFiles/chessengine-static.dir/src/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chessengine-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
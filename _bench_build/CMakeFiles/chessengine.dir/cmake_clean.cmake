@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/chessengine"
+  "/root/repo/chessengine.pdb"
+  "CMakeFiles/chessengine.dir/src/main.cc.o"
+  "CMakeFiles/chessengine.dir/src/main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chessengine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
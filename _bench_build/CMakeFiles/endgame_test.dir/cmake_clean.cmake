@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/endgame_test.dir/tests/unit_tests/endgame_test.cc.o"
+  "CMakeFiles/endgame_test.dir/tests/unit_tests/endgame_test.cc.o.d"
+  "endgame_test"
+  "endgame_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/endgame_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
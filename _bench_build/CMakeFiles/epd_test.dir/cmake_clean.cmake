@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/epd_test.dir/tests/unit_tests/epd_test.cc.o"
+  "CMakeFiles/epd_test.dir/tests/unit_tests/epd_test.cc.o.d"
+  "epd_test"
+  "epd_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/epd_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/evaluate_test.dir/tests/unit_tests/evaluate_test.cc.o"
+  "CMakeFiles/evaluate_test.dir/tests/unit_tests/evaluate_test.cc.o.d"
+  "evaluate_test"
+  "evaluate_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/evaluate_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example2_test.dir/tests/unit_tests/example2_test.cc.o"
+  "CMakeFiles/example2_test.dir/tests/unit_tests/example2_test.cc.o.d"
+  "example2_test"
+  "example2_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example2_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_test.dir/tests/unit_tests/example_test.cc.o"
+  "CMakeFiles/example_test.dir/tests/unit_tests/example_test.cc.o.d"
+  "example_test"
+  "example_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/example_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
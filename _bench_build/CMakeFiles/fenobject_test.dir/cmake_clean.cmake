@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fenobject_test.dir/tests/unit_tests/fenobject_test.cc.o"
+  "CMakeFiles/fenobject_test.dir/tests/unit_tests/fenobject_test.cc.o.d"
+  "fenobject_test"
+  "fenobject_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fenobject_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
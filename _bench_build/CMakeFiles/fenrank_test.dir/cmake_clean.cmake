@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fenrank_test.dir/tests/unit_tests/fenrank_test.cc.o"
+  "CMakeFiles/fenrank_test.dir/tests/unit_tests/fenrank_test.cc.o.d"
+  "fenrank_test"
+  "fenrank_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fenrank_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
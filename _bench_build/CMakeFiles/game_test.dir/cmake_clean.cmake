@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/game_test.dir/tests/unit_tests/game_test.cc.o"
+  "CMakeFiles/game_test.dir/tests/unit_tests/game_test.cc.o.d"
+  "game_test"
+  "game_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/game_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gensfen_test.dir/tests/unit_tests/gensfen_test.cc.o"
+  "CMakeFiles/gensfen_test.dir/tests/unit_tests/gensfen_test.cc.o.d"
+  "gensfen_test"
+  "gensfen_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gensfen_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
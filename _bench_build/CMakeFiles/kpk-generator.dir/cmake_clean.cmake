@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/kpk-generator.dir/src/chess_engine/ai/kpk-generator.cc.o"
+  "CMakeFiles/kpk-generator.dir/src/chess_engine/ai/kpk-generator.cc.o.d"
+  "kpk-generator"
+  "kpk-generator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/kpk-generator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
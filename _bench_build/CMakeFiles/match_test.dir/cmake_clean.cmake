@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/match_test.dir/tests/unit_tests/match_test.cc.o"
+  "CMakeFiles/match_test.dir/tests/unit_tests/match_test.cc.o.d"
+  "match_test"
+  "match_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/match_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/move_generation_test.dir/tests/unit_tests/move_generation_test.cc.o"
+  "CMakeFiles/move_generation_test.dir/tests/unit_tests/move_generation_test.cc.o.d"
+  "move_generation_test"
+  "move_generation_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/move_generation_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nnue_test.dir/tests/unit_tests/nnue_test.cc.o"
+  "CMakeFiles/nnue_test.dir/tests/unit_tests/nnue_test.cc.o.d"
+  "nnue_test"
+  "nnue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nnue_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/perft_parser_test.dir/tests/unit_tests/perft_parser_test.cc.o"
+  "CMakeFiles/perft_parser_test.dir/tests/unit_tests/perft_parser_test.cc.o.d"
+  "perft_parser_test"
+  "perft_parser_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/perft_parser_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pgn_lexer_test.dir/tests/unit_tests/pgn_lexer_test.cc.o"
+  "CMakeFiles/pgn_lexer_test.dir/tests/unit_tests/pgn_lexer_test.cc.o.d"
+  "pgn_lexer_test"
+  "pgn_lexer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pgn_lexer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
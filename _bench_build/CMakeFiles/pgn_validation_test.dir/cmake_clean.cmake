@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pgn_validation_test.dir/tests/unit_tests/pgn_validation_test.cc.o"
+  "CMakeFiles/pgn_validation_test.dir/tests/unit_tests/pgn_validation_test.cc.o.d"
+  "pgn_validation_test"
+  "pgn_validation_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pgn_validation_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
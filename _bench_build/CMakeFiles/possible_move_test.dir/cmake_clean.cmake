@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/possible_move_test.dir/tests/unit_tests/possible_move_test.cc.o"
+  "CMakeFiles/possible_move_test.dir/tests/unit_tests/possible_move_test.cc.o.d"
+  "possible_move_test"
+  "possible_move_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/possible_move_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
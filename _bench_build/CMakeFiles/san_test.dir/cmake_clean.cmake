@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/san_test.dir/tests/unit_tests/san_test.cc.o"
+  "CMakeFiles/san_test.dir/tests/unit_tests/san_test.cc.o.d"
+  "san_test"
+  "san_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/san_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
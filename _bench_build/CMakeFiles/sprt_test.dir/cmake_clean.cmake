@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sprt_test.dir/tests/unit_tests/sprt_test.cc.o"
+  "CMakeFiles/sprt_test.dir/tests/unit_tests/sprt_test.cc.o.d"
+  "sprt_test"
+  "sprt_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sprt_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
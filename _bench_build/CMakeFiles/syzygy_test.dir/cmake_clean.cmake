@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/syzygy_test.dir/tests/unit_tests/syzygy_test.cc.o"
+  "CMakeFiles/syzygy_test.dir/tests/unit_tests/syzygy_test.cc.o.d"
+  "syzygy_test"
+  "syzygy_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/syzygy_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
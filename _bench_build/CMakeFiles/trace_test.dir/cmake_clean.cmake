@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trace_test.dir/tests/unit_tests/trace_test.cc.o"
+  "CMakeFiles/trace_test.dir/tests/unit_tests/trace_test.cc.o.d"
+  "trace_test"
+  "trace_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trace_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
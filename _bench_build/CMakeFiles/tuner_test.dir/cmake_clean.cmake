@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tuner_test.dir/tests/unit_tests/tuner_test.cc.o"
+  "CMakeFiles/tuner_test.dir/tests/unit_tests/tuner_test.cc.o.d"
+  "tuner_test"
+  "tuner_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tuner_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
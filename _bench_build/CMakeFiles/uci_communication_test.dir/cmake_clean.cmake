@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/uci_communication_test.dir/tests/unit_tests/uci_communication_test.cc.o"
+  "CMakeFiles/uci_communication_test.dir/tests/unit_tests/uci_communication_test.cc.o.d"
+  "uci_communication_test"
+  "uci_communication_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/uci_communication_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
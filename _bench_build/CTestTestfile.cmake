@@ -0,0 +1,66 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_bench_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(example_test "/root/repo/_bench_build/example_test")
+set_tests_properties(example_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(example2_test "/root/repo/_bench_build/example2_test")
+set_tests_properties(example2_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(perft_parser_test "/root/repo/_bench_build/perft_parser_test")
+set_tests_properties(perft_parser_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(chessboard_test "/root/repo/_bench_build/chessboard_test")
+set_tests_properties(chessboard_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(fenrank_test "/root/repo/_bench_build/fenrank_test")
+set_tests_properties(fenrank_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(fenobject_test "/root/repo/_bench_build/fenobject_test")
+set_tests_properties(fenobject_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(possible_move_test "/root/repo/_bench_build/possible_move_test")
+set_tests_properties(possible_move_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(check_test "/root/repo/_bench_build/check_test")
+set_tests_properties(check_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(game_test "/root/repo/_bench_build/game_test")
+set_tests_properties(game_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ai_search_test "/root/repo/_bench_build/ai_search_test")
+set_tests_properties(ai_search_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ai_search2_test "/root/repo/_bench_build/ai_search2_test")
+set_tests_properties(ai_search2_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(evaluate_test "/root/repo/_bench_build/evaluate_test")
+set_tests_properties(evaluate_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(uci_communication_test "/root/repo/_bench_build/uci_communication_test")
+set_tests_properties(uci_communication_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(board_test "/root/repo/_bench_build/board_test")
+set_tests_properties(board_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(move_generation_test "/root/repo/_bench_build/move_generation_test")
+set_tests_properties(move_generation_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(nnue_test "/root/repo/_bench_build/nnue_test")
+set_tests_properties(nnue_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(endgame_test "/root/repo/_bench_build/endgame_test")
+set_tests_properties(endgame_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(syzygy_test "/root/repo/_bench_build/syzygy_test")
+set_tests_properties(syzygy_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(polyglot_test "/root/repo/_bench_build/polyglot_test")
+set_tests_properties(polyglot_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(book_builder_test "/root/repo/_bench_build/book_builder_test")
+set_tests_properties(book_builder_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(pgn_reader_test "/root/repo/_bench_build/pgn_reader_test")
+set_tests_properties(pgn_reader_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(pgn_lexer_test "/root/repo/_bench_build/pgn_lexer_test")
+set_tests_properties(pgn_lexer_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(san_test "/root/repo/_bench_build/san_test")
+set_tests_properties(san_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(pgn_validation_test "/root/repo/_bench_build/pgn_validation_test")
+set_tests_properties(pgn_validation_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(epd_test "/root/repo/_bench_build/epd_test")
+set_tests_properties(epd_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(trace_test "/root/repo/_bench_build/trace_test")
+set_tests_properties(trace_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(sprt_test "/root/repo/_bench_build/sprt_test")
+set_tests_properties(sprt_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(gensfen_test "/root/repo/_bench_build/gensfen_test")
+set_tests_properties(gensfen_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(tuner_test "/root/repo/_bench_build/tuner_test")
+set_tests_properties(tuner_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(match_test "/root/repo/_bench_build/match_test")
+set_tests_properties(match_test PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;319;add_test;/root/repo/CMakeLists.txt;0;")
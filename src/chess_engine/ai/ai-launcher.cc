@@ -1,27 +1,311 @@
+#include <mutex>
+#include <thread>
+#include <iostream>
 #include <optional>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
 
 #include "ai-launcher.hh"
 #include "chess_engine/ai/ai-mini.hh"
 #include "chess_engine/ai/uci.hh"
+#include "chess_engine/book/polyglot.hh"
+#include "chess_engine/nnue/network.hh"
+#include "chess_engine/syzygy/tablebase.hh"
 #include "parsing/pgn_parser/ebnf-parser.hh"
 
 namespace ai
 {
+    namespace
+    {
+        constexpr int16_t default_depth = 5;
+
+        // Moves left when the GUI does not say (go movestogo)
+        constexpr int default_moves_to_go = 30;
+
+        // More than the legal moves of any position
+        constexpr int max_multipv = 256;
+
+        // Runs the searches in their own thread, so that the commands (stop,
+        // ponderhit) are read while searching
+        class SearchThread
+        {
+        public:
+            ~SearchThread()
+            {
+                stop();
+            }
+
+            const SearchControl& control(void) const
+            {
+                return control_;
+            }
+
+            // A held search (go ponder, go infinite) waits for release
+            // before sending its bestmove, as asked by UCI
+            void start(std::function<void(SearchThread&)> search,
+                       const bool held)
+            {
+                stop();
+                control_.reset();
+                {
+                    const std::lock_guard lock(mutex_);
+                    held_ = held;
+                }
+                thread_ = std::thread(std::move(search), std::ref(*this));
+            }
+
+            void set_deadline(const SearchControl::clock::time_point deadline)
+            {
+                control_.set_deadline(deadline);
+            }
+
+            void wait_release(void)
+            {
+                std::unique_lock lock(mutex_);
+                released_.wait(lock, [this]() { return !held_; });
+            }
+
+            void release(void)
+            {
+                {
+                    const std::lock_guard lock(mutex_);
+                    held_ = false;
+                }
+                released_.notify_all();
+            }
+
+            // End the running search, whose bestmove is still sent
+            void stop(void)
+            {
+                control_.stop();
+                release();
+                if (thread_.joinable())
+                    thread_.join();
+            }
+
+        private:
+            SearchControl control_;
+            std::thread thread_;
+            std::mutex mutex_;
+            std::condition_variable released_;
+            bool held_ = false;
+        };
+
+        using Type = uci::Option::Type;
+
+        std::vector<uci::Option> options(AiMini& ai, SearchThread& searcher)
+        {
+            return {
+                {"Hash", Type::SPIN, std::to_string(default_hash_mb), 1,
+                 static_cast<int>(max_hash_mb),
+                 [&ai, &searcher](const std::string& value)
+                 {
+                     searcher.stop();
+                     ai.set_hash_size(std::stoi(value));
+                 }},
+                {"Clear Hash", Type::BUTTON, "", 0, 0,
+                 [&ai, &searcher](const std::string&)
+                 {
+                     searcher.stop();
+                     ai.clear();
+                 }},
+                // Sent by the match managers: the search runs on a single
+                // thread, so 1 is the only value until it is parallel
+                {"Threads", Type::SPIN, "1", 1, 1, nullptr},
+                // Tells the GUI that go ponder is supported, the engine does
+                // not need its value
+                {"Ponder", Type::CHECK, "false", 0, 0, nullptr},
+                // Best lines sent while analysing
+                {"MultiPV", Type::SPIN, "1", 1, max_multipv, nullptr},
+                // Time lost in the communication with the GUI
+                {"Move Overhead", Type::SPIN, "10", 0, 5000, nullptr},
+                // The searches use the network, the tablebases and the book:
+                // they are stopped before these are changed
+                {"EvalFile", Type::STRING, "<empty>", 0, 0,
+                 [&searcher](const std::string& value)
+                 {
+                     searcher.stop();
+                     if (value.empty())
+                         nnue::Network::unload();
+                     else if (nnue::Network::load(value))
+                         uci::info_string("NNUE network " + value
+                                          + " loaded");
+                     else
+                         uci::info_string("cannot load NNUE network " + value
+                                          + ", using classic evaluation");
+                 }},
+                {"SyzygyPath", Type::STRING, "<empty>", 0, 0,
+                 [&searcher](const std::string& value)
+                 {
+                     searcher.stop();
+                     const auto found = syzygy::init(value);
+                     if (!value.empty())
+                         uci::info_string("found " + std::to_string(found)
+                                          + " tablebases");
+                 }},
+                {"BookFile", Type::STRING, "<empty>", 0, 0,
+                 [&searcher](const std::string& value)
+                 {
+                     searcher.stop();
+                     if (value.empty())
+                         book::Book::unload();
+                     else if (book::Book::load(value))
+                         uci::info_string("book " + value + " loaded ("
+                                 + std::to_string(book::Book::get()->size())
+                                 + " entries)");
+                     else
+                         uci::info_string("cannot load book " + value);
+                 }},
+                // Every search is appended as a JSON line, see dump_stats
+                {"StatsFile", Type::STRING, "<empty>", 0, 0, nullptr},
+            };
+        }
+
+        // Options used by a search, read on the main thread when it starts:
+        // set_option changes them without stopping the search
+        struct SearchOptions
+        {
+            std::chrono::milliseconds overhead;
+            size_t multipv;
+            std::string stats_file;
+        };
+
+        SearchOptions search_options(void)
+        {
+            return SearchOptions{
+                std::chrono::milliseconds(
+                        std::stoi(uci::option_value("Move Overhead"))),
+                static_cast<size_t>(std::stoi(uci::option_value("MultiPV"))),
+                uci::option_value("StatsFile")};
+        }
+
+        // Time of the search, nullopt when the GUI gave no time
+        std::optional<std::chrono::milliseconds> time_budget(
+                const uci::GoCommand& go, const bool white_turn,
+                const std::chrono::milliseconds overhead)
+        {
+            const auto minimum = std::chrono::milliseconds(1);
+
+            if (go.movetime.has_value())
+                return std::max(go.movetime.value() - overhead, minimum);
+
+            const auto& time = white_turn ? go.wtime : go.btime;
+            if (!time.has_value())
+                return std::nullopt;
+            const auto increment = white_turn ? go.winc : go.binc;
+            const auto budget = time.value()
+                                / go.movestogo.value_or(default_moves_to_go)
+                                + increment * 3 / 4;
+            // Never use the time needed by the next moves
+            return std::max(std::min(budget, time.value() / 2) - overhead,
+                            minimum);
+        }
+
+        // Principal variation found, empty when there is no move
+        std::vector<board::Move> search(AiMini& ai,
+                                        board::Chessboard& chessboard,
+                                        const uci::GoCommand& go,
+                                        const SearchOptions& options,
+                                        const SearchControl& control)
+        {
+            const bool white_turn = chessboard.get_white_turn();
+            const auto budget = time_budget(go, white_turn, options.overhead);
+            const bool open_ended = go.ponder || go.infinite;
+
+            // Even a fixed depth search is iterative, so that it can be
+            // stopped with the move of its last completed iteration
+            SearchLimits limits;
+            limits.depth = go.depth.value_or(
+                    budget.has_value() || go.infinite ? 64 : default_depth);
+            // The clock of go ponder only runs from ponderhit
+            if (!open_ended)
+                limits.movetime = budget;
+            limits.multipv = options.multipv;
+            limits.control = &control;
+            const auto info = ai.search(chessboard, limits,
+                                        [white_turn](const SearchInfo& i)
+                                        {
+                                            uci::info(i, white_turn);
+                                        });
+            uci::dump_stats(info, options.stats_file);
+            return info.move.has_value() ? info.pv
+                                         : std::vector<board::Move>();
+        }
+    } // namespace
+
     void play_ai(void)
     {
-        uci::init("bLiPbLoP");
         AiMini ai = AiMini();
-        board::Chessboard chessboard = board::Chessboard();
-        while (true)
-        {
-            std::string board_str = uci::get_board();
-            int16_t depth = pgn_parser::get_depth(uci::get_go()).value_or(5);
-            pgn_parser::add_move_to_board(chessboard, board_str);
-            std::optional<board::Move> move = ai.search(chessboard, depth);
-            if (!move.has_value())
-                break;
-            uci::play_move(pgn_parser::move_to_string(move.value()));
-            chessboard.do_move(move.value());
-        }
+        uci::Position position;
+        SearchThread searcher;
+
+        // Clock of the last go ponder, used from ponderhit
+        SearchControl::clock::time_point ponder_start;
+        std::optional<std::chrono::milliseconds> ponder_budget;
+
+        uci::Engine engine;
+        engine.options = options(ai, searcher);
+        engine.on_new_game = [&]()
+        {
+            searcher.stop();
+            position = uci::Position();
+            ai.clear();
+        };
+        engine.on_position = [&](const std::string& command)
+        {
+            searcher.stop();
+            board::Chessboard::fen_buffer_t fen;
+            if (!position.set(command))
+                uci::info_string("invalid position, searching "
+                                 + std::string(position.board()
+                                               .write_fen(fen)));
+        };
+        engine.on_go = [&](const uci::GoCommand& go)
+        {
+            ponder_start = SearchControl::clock::now();
+            const SearchOptions options = search_options();
+            ponder_budget = time_budget(go, position.board().get_white_turn(),
+                                        options.overhead);
+
+            // The transposition table is kept between the searches, so what
+            // is found while pondering is not searched again
+            searcher.start([&ai, go, options, chessboard = position.board()]
+                           (SearchThread& thread) mutable
+            {
+                // Book moves are played without searching
+                book::Book* book = book::Book::get();
+                const auto book_move = book != nullptr
+                        ? book->probe(chessboard)
+                        : std::nullopt;
+                const auto pv = book_move.has_value()
+                        ? std::vector{book_move.value()}
+                        : search(ai, chessboard, go, options,
+                                 thread.control());
+
+                thread.wait_release();
+                if (pv.empty())
+                    uci::play_move("0000");
+                // The GUI sends the move back in the next position command
+                else
+                    uci::play_move(pgn_parser::move_to_string(pv[0]),
+                                   pv.size() > 1
+                                   ? pgn_parser::move_to_string(pv[1])
+                                   : "");
+            }, go.ponder || go.infinite);
+        };
+        engine.on_stop = [&]()
+        {
+            searcher.stop();
+        };
+        engine.on_ponderhit = [&]()
+        {
+            // The time spent pondering is saved from the clock
+            if (ponder_budget.has_value())
+                searcher.set_deadline(ponder_start + ponder_budget.value());
+            searcher.release();
+        };
+
+        uci::loop("bLiPbLoP", engine, std::cin);
     }
-}
\ No newline at end of file
+}
@@ -1,17 +1,70 @@
 #include <algorithm>
 #include <vector>
 #include <cmath>
+#include <chrono>
 
 #include "ai-mini.hh"
 #include "evaluation.hh"
+#include "endgame.hh"
 #include "uci.hh"
+#include "chess_engine/book/polyglot.hh"
+#include "chess_engine/syzygy/tablebase.hh"
 #include "chess_engine/board/entity/color.hh"
 #include "chess_engine/board/board.hh"
+#include "chess_engine/nnue/network.hh"
 #include "utils/bits-utils.hh"
+#include "utils/trace.hh"
 
 namespace ai
 {
      using evalAndMove = std::pair<int16_t, std::optional<board::Move>>;
+     using search_clock = std::chrono::steady_clock;
+
+     // Nominal depth of the capture extension below the leaves
+     constexpr int16_t quiescence_depth = 6;
+
+     // Shared by every node of a search
+     struct SearchContext
+     {
+          SearchStats stats;
+          TranspositionTable* tt = nullptr;
+          std::optional<search_clock::time_point> deadline;
+          std::optional<uint64_t> max_nodes;
+          const SearchControl* control = nullptr;
+          // Only used when a NNUE network is loaded
+          nnue::AccumulatorStack* accumulators = nullptr;
+          bool stopped = false;
+
+          bool must_stop(void) const
+          {
+               const auto now = search_clock::now();
+               return (deadline.has_value() && now >= deadline.value())
+                      || (max_nodes.has_value()
+                          && stats.nodes >= max_nodes.value())
+                      || (control != nullptr && control->must_stop(now));
+          }
+
+          // Count the node, the limits are only checked every 1024 nodes
+          bool visit(const int ply, const bool quiescence)
+          {
+               stats.nodes++;
+               if (quiescence)
+                    stats.qnodes++;
+               stats.seldepth = std::max(stats.seldepth, ply);
+               if (!stopped && (deadline.has_value() || control != nullptr
+                                || max_nodes.has_value())
+                   && stats.nodes % 1024 == 0)
+                    stopped = must_stop();
+               return !stopped;
+          }
+
+          void cutoff(const size_t move_index)
+          {
+               stats.beta_cutoffs++;
+               if (move_index == 0)
+                    stats.first_move_cutoffs++;
+          }
+     };
 
      class BasicDepthAdapter
      {
@@ -51,18 +104,107 @@ namespace ai
           return BasicDepthAdapter::adapte_depth(board, depth);
      }
 
+     // Game theoretical value of the board when the ending is known,
+     // ending being the result of endgame::evaluate on the board. The
+     // tablebases are only probed when probe_tables is set.
+     static std::optional<int16_t> known_score(
+               const board::Chessboard& chessboard,
+               const std::optional<endgame::Score>& ending,
+               const bool probe_tables)
+     {
+          if (ending.has_value() && ending.value().exact)
+               return ending.value().value;
+          if (!probe_tables)
+               return std::nullopt;
+
+          // Cursed wins and blessed losses are draws (fifty moves rule)
+          const auto wdl = syzygy::probe_wdl(chessboard);
+          if (!wdl.has_value())
+               return std::nullopt;
+          const int16_t value = wdl == syzygy::Wdl::WIN ? endgame::known_win
+                              : wdl == syzygy::Wdl::LOSS ? -endgame::known_win
+                              : 0;
+          return chessboard.get_white_turn() ? value : -value;
+     }
+
+     // The principal variation of the node is written to pv
      static evalAndMove minimax(board::Chessboard& chessboard,
                                    int16_t depth,
                                    const int16_t depth_q,
                                    int16_t alpha,
                                    int16_t beta,
-                                   const bool isMaxPlayer)
+                                   const bool isMaxPlayer,
+                                   SearchContext& context,
+                                   const int ply,
+                                   std::vector<board::Move>& pv,
+                                   const std::vector<board::Move>* root_moves
+                                        = nullptr)
      {
+          TRACE_SCOPE("minimax");
+          pv.clear();
+          // The result of an interrupted search is thrown away
+          if (!context.visit(ply, depth_q < quiescence_depth))
+               return evalAndMove(0, std::nullopt);
+
+          // The ending is looked up once per node: the known values end the
+          // search (except at the root, which needs a move), the other ones
+          // are used by the evaluation
+          const auto ending = endgame::evaluate(chessboard);
+          if (ply > 0)
+          {
+               // As in Stockfish, the tables are probed at full width
+               // nodes right after a capture or a pawn move only: the
+               // quiescence search does not pay for their capture search
+               const bool probe_tables = depth_q == quiescence_depth
+                                         && chessboard.get_halfmove_clock()
+                                            == 0;
+               const auto known = known_score(chessboard, ending,
+                                              probe_tables);
+               if (known.has_value())
+                    return evalAndMove(known.value(), std::nullopt);
+          }
+
+          if (context.accumulators != nullptr)
+               context.accumulators->push(ply, chessboard.get_board());
           if (depth <= 0 || depth_q == 0)
-               return evalAndMove(evaluate(chessboard), std::nullopt);
+               return evalAndMove(evaluate(chessboard, ending, alpha, beta,
+                                           context.accumulators, ply),
+                                  std::nullopt);
 
-          const std::vector<board::Move> legal_moves =
-                    chessboard.generate_legal_moves();
+          // Only the full width nodes are stored, their depth is comparable.
+          // The root needs a move and its principal variation, and may
+          // search some of its moves only (MultiPV), it is not stored.
+          const bool tt_node = context.tt != nullptr && ply > 0
+                               && depth_q == quiescence_depth;
+          const uint64_t key = tt_node ? book::polyglot_key(chessboard) : 0;
+          const TTEntry* entry = tt_node ? context.tt->probe(key) : nullptr;
+          if (entry != nullptr)
+          {
+               context.stats.tt_hits++;
+               if (entry->depth >= depth
+                   && (entry->bound == Bound::EXACT
+                       || (entry->bound == Bound::LOWER
+                           && entry->value >= beta)
+                       || (entry->bound == Bound::UPPER
+                           && entry->value <= alpha)))
+               {
+                    context.stats.tt_cutoffs++;
+                    return evalAndMove(entry->value, entry->move);
+               }
+          }
+
+          std::vector<board::Move> legal_moves = root_moves
+                    ? *root_moves
+                    : chessboard.generate_legal_moves();
+          // The best move of a previous search is searched first
+          if (entry != nullptr && entry->move.has_value())
+          {
+               const auto tt_move = std::find(legal_moves.begin(),
+                                              legal_moves.end(),
+                                              entry->move.value());
+               if (tt_move != legal_moves.end())
+                    std::rotate(legal_moves.begin(), tt_move, tt_move + 1);
+          }
 
           bool is_check = chessboard.is_check();
           if (chessboard.is_draw(legal_moves, is_check))
@@ -70,6 +212,28 @@ namespace ai
           if (chessboard.is_checkmate(legal_moves, is_check))
                return evalAndMove(isMaxPlayer ? INT16_MIN : INT16_MAX,
                                   std::nullopt);
+
+          std::vector<board::Move> child_pv;
+          const auto update_pv = [&](const board::Move& move)
+          {
+               pv.clear();
+               pv.push_back(move);
+               pv.insert(pv.end(), child_pv.begin(), child_pv.end());
+          };
+          const int16_t alpha_orig = alpha;
+          const int16_t beta_orig = beta;
+          const auto result = [&](const int16_t value, const size_t index)
+          {
+               if (pv.empty())
+                    pv.push_back(legal_moves[index]);
+               if (tt_node)
+                    context.tt->store(key, depth, value,
+                                      value <= alpha_orig ? Bound::UPPER
+                                      : value >= beta_orig ? Bound::LOWER
+                                      : Bound::EXACT,
+                                      legal_moves[index]);
+               return evalAndMove(value, legal_moves[index]);
+          };
           if (isMaxPlayer)
           {
                int16_t bestValue = INT16_MIN;
@@ -78,30 +242,39 @@ namespace ai
                {
                     board::Chessboard chessboard_ = chessboard;
                     chessboard_.do_move(legal_moves[i]);
+                    child_pv.clear();
                     int16_t eval;
                     if (depth <= 1 && (legal_moves[i].get_capture()
                                        || legal_moves[i].get_promotion()))
                     {
                          eval = minimax(chessboard_, depth, depth_q - 1,
                                         alpha, beta,
-                                        !isMaxPlayer).first;
+                                        !isMaxPlayer, context,
+                                        ply + 1, child_pv).first;
                     }
                     else
                     {
                          eval = minimax(chessboard_, depth - 1, depth_q,
                                         alpha, beta,
-                                        !isMaxPlayer).first;
+                                        !isMaxPlayer, context,
+                                        ply + 1, child_pv).first;
                     }
+                    if (context.stopped)
+                         return evalAndMove(0, std::nullopt);
                     if (eval > bestValue)
                     {
                          bestValue = eval;
                          bestIndex = i;
+                         update_pv(legal_moves[i]);
                          alpha = std::max(alpha, eval);
                          if (beta <= alpha)
+                         {
+                              context.cutoff(i);
                               break;
+                         }
                     }
                }
-               return evalAndMove(bestValue, legal_moves[bestIndex]);
+               return result(bestValue, bestIndex);
           }
           // else
           int16_t bestValue = INT16_MAX;
@@ -110,40 +283,211 @@ namespace ai
           {
                board::Chessboard chessboard_ = chessboard;
                chessboard_.do_move(legal_moves[i]);
+               child_pv.clear();
                int16_t eval;
                if (depth <= 1 && (legal_moves[i].get_capture()
                                   || legal_moves[i].get_promotion()))
                {
                     eval = minimax(chessboard_, depth - 1, depth_q - 1,
                                    alpha, beta,
-                                   !isMaxPlayer).first;
+                                   !isMaxPlayer, context,
+                                   ply + 1, child_pv).first;
                }
                else
                {
                     eval = minimax(chessboard_, depth - 1, depth_q,
                                    alpha, beta,
-                                   !isMaxPlayer).first;
+                                   !isMaxPlayer, context,
+                                   ply + 1, child_pv).first;
                }
+               if (context.stopped)
+                    return evalAndMove(0, std::nullopt);
                if (eval < bestValue)
                {
                     bestValue = eval;
                     bestIndex = i;
+                    update_pv(legal_moves[i]);
                     beta = std::min(beta, eval);
                     if (beta <= alpha)
+                    {
+                         context.cutoff(i);
                          break;
+                    }
                }
           }
-          return evalAndMove(bestValue, legal_moves[bestIndex]);
+          return result(bestValue, bestIndex);
      }
 
      std::optional<board::Move>  AiMini::search(board::Chessboard& chessboard,
-                                int16_t depth) const
+                                int16_t depth)
      {
           depth = adapte_depth(chessboard.get_board(), depth);
-          auto eval_move = minimax(chessboard, depth, 6,
-                                  INT16_MIN, INT16_MAX,
-                                  chessboard.get_white_turn());
-          uci::info(depth, eval_move.first);
+
+          // Only search the moves keeping the best tablebase result
+          std::vector<board::Move> root_moves =
+                    chessboard.generate_legal_moves();
+          const bool filtered = syzygy::filter_root_moves(chessboard,
+                                                          root_moves);
+
+          const auto start = search_clock::now();
+          SearchContext context;
+          context.tt = &tt_;
+          if (nnue::Network::get() != nullptr)
+               context.accumulators = &accumulators_;
+          tt_.new_search();
+          SearchInfo info;
+          const auto eval_move = minimax(chessboard, depth, quiescence_depth,
+                                         INT16_MIN, INT16_MAX,
+                                         chessboard.get_white_turn(), context,
+                                         0, info.pv,
+                                         filtered ? &root_moves : nullptr);
+          info.depth = depth;
+          info.score = eval_move.first;
+          info.move = eval_move.second;
+          info.time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    search_clock::now() - start);
+          info.stats = context.stats;
+          info.stats.iteration_times.push_back(info.time);
+          info.hashfull = tt_.hashfull();
+          if (info.move.has_value())
+               info.lines.push_back(SearchLine{info.score, info.pv});
+          uci::info(info, chessboard.get_white_turn());
+          uci::dump_stats(info, uci::option_value("StatsFile"));
           return eval_move.second;
      }
+
+     SearchInfo AiMini::search(board::Chessboard& chessboard,
+                               const SearchLimits& limits,
+                               const iteration_callback_t& on_iteration)
+     {
+          const auto start = search_clock::now();
+          std::vector<board::Move> root_moves =
+                    chessboard.generate_legal_moves();
+          syzygy::filter_root_moves(chessboard, root_moves);
+
+          SearchInfo info;
+          SearchContext context;
+          context.tt = &tt_;
+          if (nnue::Network::get() != nullptr)
+               context.accumulators = &accumulators_;
+          tt_.new_search();
+          for (int16_t depth = 1; depth <= limits.depth; depth++)
+          {
+               // The first iteration always completes, so there is a move
+               if (depth > 1 && limits.movetime.has_value())
+                    context.deadline = start + limits.movetime.value();
+               if (depth > 1)
+               {
+                    context.control = limits.control;
+                    context.max_nodes = limits.nodes;
+               }
+
+               // Each line is the best one without the moves of the
+               // previous lines, the positions below the root being shared
+               // through the transposition table
+               std::vector<SearchLine> lines;
+               std::optional<evalAndMove> best;
+               std::vector<board::Move> line_moves = root_moves;
+               do
+               {
+                    std::vector<board::Move> pv;
+                    const auto eval_move = minimax(chessboard, depth,
+                                                   quiescence_depth,
+                                                   INT16_MIN, INT16_MAX,
+                                                   chessboard.get_white_turn(),
+                                                   context, 0, pv,
+                                                   &line_moves);
+                    if (context.stopped)
+                         break;
+                    if (!best.has_value())
+                         best = eval_move;
+                    if (!eval_move.second.has_value())
+                         break;
+                    lines.push_back(SearchLine{eval_move.first,
+                                               std::move(pv)});
+                    line_moves.erase(std::find(line_moves.begin(),
+                                               line_moves.end(),
+                                               eval_move.second.value()));
+               } while (lines.size() < limits.multipv
+                        && !line_moves.empty());
+
+               info.time = std::chrono::duration_cast<
+                         std::chrono::milliseconds>(search_clock::now()
+                                                    - start);
+               // The counters include the interrupted iteration
+               if (!context.stopped)
+                    context.stats.iteration_times.push_back(info.time);
+               info.stats = context.stats;
+               info.hashfull = tt_.hashfull();
+               TRACE_COUNTER("nodes", info.stats.nodes);
+               if (context.stopped)
+                    break;
+
+               info.depth = depth;
+               info.score = best.value().first;
+               info.move = best.value().second;
+               info.pv = lines.empty() ? std::vector<board::Move>()
+                                       : lines.front().pv;
+               info.lines = std::move(lines);
+               if (on_iteration)
+                    on_iteration(info);
+
+               // The best moves of this iteration are searched first by the
+               // next one
+               for (auto line = info.lines.rbegin();
+                    line != info.lines.rend(); ++line)
+               {
+                    const auto move = std::find(root_moves.begin(),
+                                                root_moves.end(),
+                                                line->pv.front());
+                    std::rotate(root_moves.begin(), move, move + 1);
+               }
+
+               // Nothing more to find once the game is over or decided
+               if (!info.move.has_value() || info.score == INT16_MIN
+                   || info.score == INT16_MAX)
+                    break;
+               if (limits.movetime.has_value()
+                   && info.time >= limits.movetime.value())
+                    break;
+               if (limits.nodes.has_value()
+                   && info.stats.nodes >= limits.nodes.value())
+                    break;
+               if (limits.control != nullptr
+                   && limits.control->must_stop(search_clock::now()))
+                    break;
+          }
+          return info;
+     }
+
+     void SearchControl::stop(void)
+     {
+          stop_ = true;
+     }
+
+     void SearchControl::set_deadline(const clock::time_point deadline)
+     {
+          deadline_ = deadline.time_since_epoch().count();
+     }
+
+     void SearchControl::reset(void)
+     {
+          stop_ = false;
+          deadline_ = clock::duration::max().count();
+     }
+
+     bool SearchControl::must_stop(const clock::time_point now) const
+     {
+          return stop_ || now.time_since_epoch().count() >= deadline_;
+     }
+
+     void AiMini::clear(void)
+     {
+          tt_.clear();
+     }
+
+     void AiMini::set_hash_size(const size_t megabytes)
+     {
+          tt_.resize(megabytes);
+     }
 }
@@ -1,16 +1,106 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
 #include <optional>
+#include <functional>
 
+#include "search-stats.hh"
+#include "transposition-table.hh"
 #include "chess_engine/board/entity/move.hh"
 #include "chess_engine/board/chessboard.hh"
+#include "chess_engine/nnue/accumulator.hh"
 
 namespace ai
 {
+     // Ends from another thread a search running without time limit
+     // (pondering, infinite analysis), or sooner than its limit
+     class SearchControl
+     {
+     public:
+          using clock = std::chrono::steady_clock;
+
+          void stop(void);
+          void set_deadline(clock::time_point deadline);
+          // No stop and no deadline, for the next search
+          void reset(void);
+
+          bool must_stop(clock::time_point now) const;
+
+     private:
+          std::atomic<bool> stop_ = false;
+          std::atomic<clock::rep> deadline_ = clock::duration::max().count();
+     };
+
+     struct SearchLimits
+     {
+          // Deepest iteration
+          int16_t depth = 64;
+          // Searching stops once this time is elapsed, the move of the last
+          // completed iteration is kept
+          std::optional<std::chrono::milliseconds> movetime;
+          // Like movetime, for the nodes of the search, which are counted
+          // by 1024
+          std::optional<uint64_t> nodes = std::nullopt;
+          // Best lines searched (MultiPV)
+          size_t multipv = 1;
+          // Like movetime, applied from the second iteration
+          const SearchControl* control = nullptr;
+     };
+
+     struct SearchLine
+     {
+          // From the point of view of white
+          int16_t score = 0;
+          std::vector<board::Move> pv;
+     };
+
+     // State of an iterative search after a completed iteration
+     struct SearchInfo
+     {
+          int16_t depth = 0;
+          // From the point of view of white
+          int16_t score = 0;
+          // Counters since the beginning of the search
+          SearchStats stats;
+          std::chrono::milliseconds time{0};
+          std::optional<board::Move> move;
+          // Principal variation, starting with move
+          std::vector<board::Move> pv;
+          // Permille of the transposition table used by the search
+          int hashfull = 0;
+          // Best first, the first one being score and pv, empty when there
+          // is no move
+          std::vector<SearchLine> lines;
+     };
+
      class AiMini final
      {
      public:
+          using iteration_callback_t = std::function<void(const SearchInfo&)>;
+
           std::optional<board::Move>  search(board::Chessboard& chessboard,
-                             int16_t depth) const;
+                             int16_t depth);
+
+          /*
+          ** Iterative deepening from depth 1 up to the limits, each completed
+          ** iteration is reported to on_iteration. Nothing is sent to the
+          ** GUI, so several searches can run at the same time.
+          */
+          SearchInfo search(board::Chessboard& chessboard,
+                            const SearchLimits& limits,
+                            const iteration_callback_t& on_iteration
+                                 = nullptr);
+
+          // Forget the previous searches, for a new game
+          void clear(void);
+          // Drop the transposition table for one of another size
+          void set_hash_size(size_t megabytes);
+
+     private:
+          TranspositionTable tt_;
+          nnue::AccumulatorStack accumulators_;
      };
 }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+// Reproducible speed measurement on a fixed set of positions
+namespace ai
+{
+    constexpr int16_t bench_default_depth = 4;
+
+    struct BenchResult
+    {
+        // Also the signature of the search: it changes with any change of
+        // the move generation, ordering, pruning or evaluation
+        uint64_t nodes = 0;
+        double seconds = 0;
+    };
+
+    /*
+    ** Search every bench position to the depth, the positions being shared
+    ** by the threads. The node count of each position and the totals are
+    ** written to os, the node counts do not depend on the threads.
+    */
+    BenchResult bench(int16_t depth, unsigned threads, std::ostream& os);
+
+    // Number of embedded positions
+    size_t bench_size(void);
+} // namespace ai
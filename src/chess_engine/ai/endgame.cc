@@ -0,0 +1,257 @@
+#include "endgame.hh"
+
+#include <cstdlib>
+#include <algorithm>
+#include <unordered_map>
+
+#include "evaluation.hh"
+#include "kpk.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace ai::endgame
+{
+    namespace
+    {
+        constexpr uint64_t dark_squares = 0xaa55aa55aa55aa55ULL;
+
+        using evaluator_t = Score (*)(const Chessboard& board,
+                                      const Color strong_side);
+
+        struct Entry
+        {
+            evaluator_t evaluator;
+            Color strong_side;
+        };
+
+        int piece_shift(const PieceType piece, const Color color)
+        {
+            return 4 * (utils::utype(piece) * 2 + utils::utype(color));
+        }
+
+        int king_square(const Board& board, const Color color)
+        {
+            return utils::bit_scan_lowest(board(PieceType::KING, color));
+        }
+
+        int file_of(const int square)
+        {
+            return square % 8;
+        }
+
+        int rank_of(const int square)
+        {
+            return square / 8;
+        }
+
+        int distance(const int a, const int b)
+        {
+            return std::max(std::abs(file_of(a) - file_of(b)),
+                            std::abs(rank_of(a) - rank_of(b)));
+        }
+
+        // Bonus growing as the square gets away from the center
+        int push_to_edge(const int square)
+        {
+            const int file = file_of(square);
+            const int rank = rank_of(square);
+            return 10 * (std::max(3 - file, file - 4)
+                         + std::max(3 - rank, rank - 4));
+        }
+
+        // Bonus growing as both squares get closer
+        int push_close(const int a, const int b)
+        {
+            return 10 * (7 - distance(a, b));
+        }
+
+        int signed_score(const int value, const Color strong_side)
+        {
+            return strong_side == Color::WHITE ? value : -value;
+        }
+
+        int strong_material(const Board& board, const Color strong_side)
+        {
+            int material = 0;
+            for (auto piece : piecetype_array_without_king)
+                material += utils::bits_count(board(piece, strong_side))
+                            * piecetype_values[utils::utype(piece)];
+            return material;
+        }
+
+        Score evaluate_draw(const Chessboard&, const Color)
+        {
+            return Score{0, false};
+        }
+
+        // KQK, KRK: drive the lonely king to the edge with our king
+        Score evaluate_kxk(const Chessboard& board, const Color strong_side)
+        {
+            const Board& b = board.get_board();
+            const int strong_king = king_square(b, strong_side);
+            const int weak_king = king_square(b, get_opposite_color(strong_side));
+
+            const int value = known_win + strong_material(b, strong_side)
+                              + push_to_edge(weak_king)
+                              + push_close(strong_king, weak_king);
+            return Score{signed_score(value, strong_side), false};
+        }
+
+        // KBNK: the mate is only possible in a corner of the bishop color
+        Score evaluate_kbnk(const Chessboard& board, const Color strong_side)
+        {
+            const Board& b = board.get_board();
+            const int strong_king = king_square(b, strong_side);
+            const int weak_king = king_square(b, get_opposite_color(strong_side));
+            const bool dark_bishop =
+                    b(PieceType::BISHOP, strong_side) & dark_squares;
+
+            // a1 and h8 are dark squares
+            const int corner_distance = dark_bishop
+                    ? std::min(distance(weak_king, 0), distance(weak_king, 63))
+                    : std::min(distance(weak_king, 7), distance(weak_king, 56));
+
+            const int value = known_win + strong_material(b, strong_side)
+                              + 20 * (7 - corner_distance)
+                              + push_close(strong_king, weak_king);
+            return Score{signed_score(value, strong_side), false};
+        }
+
+        // KPK: exact result from the bitbase, the wins are ordered by the
+        // advance of the pawn so that the search pushes it
+        Score evaluate_kpk(const Chessboard& board, const Color strong_side)
+        {
+            const Board& b = board.get_board();
+            const Color weak_side = get_opposite_color(strong_side);
+            const int pawn = utils::bit_scan_lowest(
+                    b(PieceType::PAWN, strong_side));
+
+            if (!kpk::probe(strong_side, king_square(b, strong_side), pawn,
+                            king_square(b, weak_side),
+                            board.get_playing_color()))
+                return Score{0, true};
+
+            const int rank = strong_side == Color::WHITE ? rank_of(pawn)
+                                                         : 7 - rank_of(pawn);
+            const int value = known_win
+                    + piecetype_values[utils::utype(PieceType::PAWN)]
+                    + 20 * rank;
+            return Score{signed_score(value, strong_side), true};
+        }
+
+        void add_piece(uint64_t& key, const PieceType piece, const Color color)
+        {
+            key += 1ULL << piece_shift(piece, color);
+        }
+
+        class Registry
+        {
+        public:
+            static const Registry& get_instance()
+            {
+                static const Registry instance;
+                return instance;
+            }
+
+            const Entry* find(const uint64_t key) const
+            {
+                const auto it = entries_.find(key);
+                return it == entries_.end() ? nullptr : &it->second;
+            }
+
+        private:
+            std::unordered_map<uint64_t, Entry> entries_;
+
+            Registry()
+            {
+                add("KQvK", evaluate_kxk);
+                add("KRvK", evaluate_kxk);
+                add("KBNvK", evaluate_kbnk);
+                add("KPvK", evaluate_kpk);
+                add("KNNvK", evaluate_draw);
+            }
+
+            void add(const std::string& signature, const evaluator_t evaluator)
+            {
+                for (const auto color : {Color::WHITE, Color::BLACK})
+                    entries_[signature_key(signature, color)] =
+                            Entry{evaluator, color};
+            }
+        };
+    } // namespace
+
+    uint64_t material_key(const Board& board)
+    {
+        uint64_t key = 0;
+        for (const auto piece : piecetype_array)
+            for (const auto color : {Color::WHITE, Color::BLACK})
+                key |= static_cast<uint64_t>(
+                           utils::bits_count(board(piece, color)))
+                       << piece_shift(piece, color);
+        return key;
+    }
+
+    uint64_t signature_key(const std::string& signature,
+                           const Color strong_side)
+    {
+        uint64_t key = 0;
+        Color color = strong_side;
+        for (const char c : signature)
+        {
+            if (c == 'v')
+                color = get_opposite_color(strong_side);
+            else
+                add_piece(key, char_to_piece(c), color);
+        }
+        return key;
+    }
+
+    bool is_insufficient_material(const Board& board)
+    {
+        if (board(PieceType::PAWN) | board(PieceType::ROOK)
+            | board(PieceType::QUEEN))
+            return false;
+
+        const uint64_t bishops = board(PieceType::BISHOP);
+        const int minors = utils::bits_count(board(PieceType::KNIGHT))
+                           + utils::bits_count(bishops);
+        if (minors <= 1)
+            return true;
+
+        // Only bishops, all on the same square color
+        return !board(PieceType::KNIGHT)
+               && (!(bishops & dark_squares) || !(bishops & ~dark_squares));
+    }
+
+    std::optional<Score> evaluate(const Chessboard& board)
+    {
+        const Board& b = board.get_board();
+        if (is_insufficient_material(b))
+            return Score{0, true};
+
+        const Entry* entry = Registry::get_instance().find(material_key(b));
+        if (entry == nullptr)
+            return std::nullopt;
+
+        return entry->evaluator(board, entry->strong_side);
+    }
+
+    int scale_factor(const Board& board)
+    {
+        // Opposite coloured bishops, with pawns only
+        if (board(PieceType::QUEEN) | board(PieceType::ROOK)
+            | board(PieceType::KNIGHT))
+            return scale_normal;
+
+        const uint64_t white_bishops = board(PieceType::BISHOP, Color::WHITE);
+        const uint64_t black_bishops = board(PieceType::BISHOP, Color::BLACK);
+        if (utils::bits_count(white_bishops) != 1
+            || utils::bits_count(black_bishops) != 1)
+            return scale_normal;
+
+        const bool white_dark = white_bishops & dark_squares;
+        const bool black_dark = black_bishops & dark_squares;
+        return white_dark != black_dark ? scale_normal / 2 : scale_normal;
+    }
+} // namespace ai::endgame
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <optional>
+
+#include "chess_engine/board/chessboard.hh"
+
+// Endgame knowledge
+//
+// Positions are recognised by their material signature (eg: "KBNvK"),
+// looked up through a material key, and dispatched to a specialised
+// evaluator. Scores are from the white point of view like evaluate().
+namespace ai::endgame
+{
+    // Base score of a won ending, above any material balance
+    // but below the checkmate scores of the search
+    constexpr int known_win = 10000;
+
+    // Scale factor applied on the evaluation of drawish endings
+    constexpr int scale_normal = 64;
+
+    struct Score
+    {
+        int value;
+        // An exact score is the game theoretical value of the position,
+        // the search does not need to go further
+        bool exact;
+    };
+
+    // Hash of the material on the board: 4 bits per piece type and color
+    // Two boards have the same key iff they have the same material
+    uint64_t material_key(const board::Board& board);
+
+    // Key of a signature such as "KRvK", strong side first
+    uint64_t signature_key(const std::string& signature,
+                           const board::Color strong_side);
+
+    // Neither side has enough material to deliver a mate
+    bool is_insufficient_material(const board::Board& board);
+
+    // Evaluation of a recognised ending, nullopt otherwise
+    std::optional<Score> evaluate(const board::Chessboard& board);
+
+    // Fraction (over scale_normal) of the evaluation to keep,
+    // eg: opposite coloured bishops
+    int scale_factor(const board::Board& board);
+} // namespace ai::endgame
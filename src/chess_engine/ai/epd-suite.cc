@@ -0,0 +1,194 @@
+#include "epd-suite.hh"
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <sstream>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "parsing/epd_parser/epd-parser.hh"
+#include "parsing/pgn_parser/pgn-exception.hh"
+#include "parsing/pgn_parser/san.hh"
+
+using namespace board;
+
+namespace ai
+{
+    namespace
+    {
+        struct EpdResult
+        {
+            bool solved = false;
+            bool error = false;
+            // Time of the iteration from which the move is right
+            std::chrono::milliseconds solve_time{0};
+            SearchInfo info;
+            std::string detail;
+        };
+
+        std::vector<Move> to_moves(const std::vector<Move>& legal_moves,
+                                   const std::vector<std::string>* sans)
+        {
+            std::vector<Move> moves;
+            if (sans != nullptr)
+                for (const auto& san : *sans)
+                    moves.push_back(pgn_parser::san_to_move(legal_moves,
+                                                            san));
+            return moves;
+        }
+
+        bool contains(const std::vector<Move>& moves, const Move& move)
+        {
+            return std::find(moves.begin(), moves.end(), move) != moves.end();
+        }
+
+        // The position is searched from scratch by ai
+        EpdResult solve(AiMini& ai, const epd_parser::EpdRecord& record,
+                        const SearchLimits& limits)
+        {
+            EpdResult result;
+            std::optional<Chessboard> board;
+            std::vector<Move> best_moves, avoid_moves;
+            try
+            {
+                board = Chessboard::from_fen(record.fen);
+                const auto legal_moves = board->generate_legal_moves();
+                best_moves = to_moves(legal_moves, record.operation("bm"));
+                avoid_moves = to_moves(legal_moves, record.operation("am"));
+            }
+            catch (const std::invalid_argument& error)
+            {
+                result.error = true;
+                result.detail = error.what();
+                return result;
+            }
+            catch (const pgn_parser::PgnParsingException& error)
+            {
+                result.error = true;
+                result.detail = error.what();
+                return result;
+            }
+
+            const auto is_right = [&](const Move& move)
+            {
+                return (best_moves.empty() || contains(best_moves, move))
+                       && !contains(avoid_moves, move);
+            };
+
+            std::optional<std::chrono::milliseconds> right_since;
+            Chessboard search_board = board.value();
+            ai.clear();
+            result.info = ai.search(search_board, limits,
+                [&](const SearchInfo& info)
+                {
+                    if (info.move.has_value() && is_right(info.move.value()))
+                    {
+                        if (!right_since.has_value())
+                            right_since = info.time;
+                    }
+                    else
+                        right_since.reset();
+                });
+
+            if (!result.info.move.has_value())
+            {
+                result.detail = "no legal move";
+                return result;
+            }
+
+            result.solved = is_right(result.info.move.value());
+            result.solve_time = right_since.value_or(result.info.time);
+            result.detail = pgn_parser::move_to_san(board.value(),
+                                                    result.info.move.value());
+            return result;
+        }
+
+        void write_result(std::ostream& os, const std::string& name,
+                          const EpdResult& result)
+        {
+            os << name << ": ";
+            if (result.error)
+            {
+                os << "error: " << result.detail << '\n';
+                return;
+            }
+
+            os << (result.solved ? "solved" : "failed") << ", played "
+               << result.detail << ", depth " << result.info.depth << ", "
+               << result.info.stats.nodes << " nodes";
+            if (result.solved)
+                os << ", found in " << result.solve_time.count() << " ms";
+            os << '\n';
+        }
+    } // namespace
+
+    EpdSummary run_epd(const std::string& path, const EpdOptions& options,
+                       std::ostream& report)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto records = epd_parser::parse_epd(path);
+
+        EpdSummary summary;
+        summary.positions = records.size();
+        std::atomic<size_t> next = 0;
+        std::mutex summary_mutex;
+        const auto worker = [&]()
+        {
+            // One engine per thread, its hash table is allocated once
+            AiMini ai;
+            for (size_t i = next++; i < records.size(); i = next++)
+            {
+                const EpdResult result = solve(ai, records[i],
+                                               options.limits);
+                const std::string id = records[i].id();
+
+                std::lock_guard<std::mutex> lock(summary_mutex);
+                write_result(report, id.empty() ? "#" + std::to_string(i + 1)
+                                                : id, result);
+                summary.errors += result.error;
+                summary.nodes += result.info.stats.nodes;
+                summary.search_time += result.info.time;
+                if (result.solved)
+                {
+                    summary.solved++;
+                    summary.solve_time += result.solve_time;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::max(1u, options.threads); ++t)
+            workers.emplace_back(worker);
+        for (auto& thread : workers)
+            thread.join();
+
+        summary.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        return summary;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const EpdSummary& summary)
+    {
+        const double search_seconds = summary.search_time.count() / 1000.0;
+        const double nps = search_seconds > 0
+                           ? summary.nodes / search_seconds : 0;
+
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2);
+        text << summary.solved << " / " << summary.positions << " solved";
+        if (summary.errors > 0)
+            text << ", " << summary.errors << " errors";
+        text << '\n';
+        if (summary.solved > 0)
+            text << "average time to solution: "
+                 << summary.solve_time.count() / summary.solved << " ms\n";
+        text << summary.nodes << " nodes, " << std::setprecision(0) << nps
+             << " nodes/s per thread, " << std::setprecision(2)
+             << summary.seconds << " s\n";
+        return os << text.str();
+    }
+} // namespace ai
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <ostream>
+
+#include "ai-mini.hh"
+
+// Test suites of EPD positions with best (bm) or avoided (am) moves
+namespace ai
+{
+    struct EpdOptions
+    {
+        SearchLimits limits;
+        unsigned threads = 1;
+    };
+
+    struct EpdSummary
+    {
+        size_t positions = 0;
+        size_t solved = 0;
+        // Positions with an invalid FEN or move
+        size_t errors = 0;
+        // Sum over the solved positions of the time of the iteration from
+        // which the search kept playing a right move
+        std::chrono::milliseconds solve_time{0};
+        uint64_t nodes = 0;
+        // Sum of the search times of every position
+        std::chrono::milliseconds search_time{0};
+        double seconds = 0;
+    };
+
+    /*
+    ** Search every position of the EPD file on a pool of threads. A position
+    ** is solved when the move played is one of its bm moves (if any) and
+    ** none of its am moves. Each result is written to report as soon as it
+    ** is known. Throws a std::invalid_argument if the file is malformed.
+    */
+    EpdSummary run_epd(const std::string& path, const EpdOptions& options,
+                       std::ostream& report);
+
+    // Solved count, time to solution and nodes per second
+    std::ostream& operator<<(std::ostream& os, const EpdSummary& summary);
+} // namespace ai
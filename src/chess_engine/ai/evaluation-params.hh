@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+
+#include "chess_engine/board/chessboard.hh"
+
+// Tunable parameters of the classic evaluation
+// This file can be regenerated by the chess-tune binary
+namespace ai
+{
+    constexpr size_t width = board::Chessboard::width;
+    constexpr size_t nb_pieces = board::nb_pieces;
+
+    using piece_square_table_t = std::array<int, width * width>;
+    using piece_square_tables_t =
+            std::array<piece_square_table_t, nb_pieces - 1>;
+
+    constexpr int queen_on_open_file_bonus = 10;
+    constexpr int rook_on_open_file_bonus = 5;
+
+    // QUEEN, ROOK, BISHOP, KNIGHT, PAWN, KING
+    constexpr std::array<int, nb_pieces> piecetype_values
+    {
+        900, 500, 330, 320, 100, 20000
+    };
+
+    // NOTE The tables are well ordered for black pieces
+    // They should be symetrically accessed
+    // (as if the ranks where reversed) for white pieces
+    //
+    //        File H -- File A
+    // Rank 1
+    //   |
+    // Rank 8
+    // This one is asymetric along the file axis
+    constexpr piece_square_table_t black_piece_square_table_queen = {
+        -20,-10,-10, -5, -5,-10,-10, -20,
+        -10,  0,  0,  0,  0,  0,  0, -10,
+        -10,  0,  5,  5,  5,  5,  0, -10,
+         -5,  0,  5,  5,  5,  5,  0,  -5,
+          0,  0,  5,  5,  5,  5,  0,  -5,
+        -10,  0,  5,  5,  5,  5,  5, -10,
+        -10,  0,  5,  0,  0,  0,  0, -10,
+        -20,-10,-10, -5, -5,-10,-10, -20
+    };
+
+    constexpr piece_square_table_t black_piece_square_table_rook = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+         0,  0,  0,  5,  5,  0,  0,  0
+    };
+
+    constexpr piece_square_table_t black_piece_square_table_bishop = {
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    };
+
+    constexpr piece_square_table_t black_piece_square_table_knight = {
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    };
+
+    constexpr piece_square_table_t black_piece_square_table_pawn = {
+        0,   0,  0,  0,  0,  0,  0,  0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+        5,   5, 10, 25, 25, 10,  5,  5,
+        0,   0,  0, 20, 20,  0,  0,  0,
+        5,  -5,-10,  0,  0,-10, -5,  5,
+        5,  10, 10,-20,-20, 10, 10,  5,
+        0,   0,  0,  0,  0,  0,  0,  0
+    };
+
+    constexpr piece_square_table_t black_middle_game_piece_square_table_king = {
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    };
+
+    constexpr piece_square_table_t black_end_game_piece_square_table_king = {
+        -50,-40,-30,-20,-20,-30,-40,-50,
+        -30,-20,-10,  0,  0,-10,-20,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-30,  0,  0,  0,  0,-30,-30,
+        -50,-30,-30,-30,-30,-30,-30,-50
+    };
+}
@@ -1,5 +1,12 @@
 #include "evaluation.hh"
+
+#include <climits>
+
+#include "endgame.hh"
+#include "chess_engine/nnue/network.hh"
+#include "chess_engine/nnue/accumulator.hh"
 #include "utils/bits-utils.hh"
+#include "utils/trace.hh"
 
 using namespace board;
 
@@ -162,7 +169,61 @@ namespace ai
     // negative -> black advantage
     int evaluate(const Chessboard& board)
     {
-        return evaluate_material(board) + evaluate_squares(board) +
-            evaluate_king_safety(board);
+        return evaluate(board, INT_MIN, INT_MAX);
+    }
+
+    int evaluate(const Chessboard& board, const int alpha, const int beta,
+                 nnue::AccumulatorStack* accumulators, const int ply)
+    {
+        return evaluate(board, endgame::evaluate(board), alpha, beta,
+                        accumulators, ply);
+    }
+
+    int evaluate(const Chessboard& board,
+                 const std::optional<endgame::Score>& ending,
+                 const int alpha, const int beta,
+                 nnue::AccumulatorStack* accumulators, const int ply)
+    {
+        TRACE_SCOPE("evaluate");
+        // Specialised evaluators of the recognised endings come first
+        if (ending.has_value())
+            return ending.value().value;
+
+        const int scale = endgame::scale_factor(board.get_board());
+
+        // The network needs both kings, the classic evaluation is the fallback
+        const nnue::Network* network = nnue::Network::get();
+        if (network != nullptr
+            && utils::bits_count(board.get_board()(PieceType::KING)) == 2)
+        {
+            // Computed from scratch out of a search
+            nnue::Accumulator fresh;
+            nnue::Accumulator& accumulator = accumulators != nullptr
+                                             ? accumulators->get(ply)
+                                             : fresh;
+            const Color color = board.get_playing_color();
+            const int evaluation = network->evaluate(board.get_board(), color,
+                                                     accumulator)
+                                   * scale / endgame::scale_normal;
+            return color == Color::WHITE ? evaluation : -evaluation;
+        }
+
+        // Cheap terms first
+        const int cheap_evaluation = evaluate_material(board)
+                                     + evaluate_squares(board);
+        const int evaluation = cheap_evaluation * scale
+                               / endgame::scale_normal;
+
+        // Even the best remaining terms cannot bring the score in the window:
+        // return the bound, that is all alpha-beta needs
+        // (+1 for the rounding of the scaling)
+        constexpr int margin = lazy_evaluation_margin + 1;
+        if (evaluation + margin <= alpha)
+            return evaluation + margin;
+        if (evaluation - margin >= beta)
+            return evaluation - margin;
+
+        return (cheap_evaluation + evaluate_king_safety(board))
+               * scale / endgame::scale_normal;
     }
 }
@@ -0,0 +1,320 @@
+#include "gensfen.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <mutex>
+#include <atomic>
+#include <cerrno>
+#include <random>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace board;
+
+namespace ai
+{
+    namespace
+    {
+        constexpr std::string_view piece_codes = "PNBRQKpnbrqk";
+        constexpr std::string_view castling_codes = "KQkq";
+
+        // Records written at once by a thread (128 KiB)
+        constexpr uint64_t block_size = 4096;
+
+        // Each block is written at its offset, so no thread waits for
+        // another one
+        class SfenFile
+        {
+        public:
+            explicit SfenFile(const std::string& path)
+                : path_(path)
+                , fd_(open(path.c_str(),
+                           O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644))
+            {
+                if (fd_ < 0)
+                    throw std::runtime_error("cannot write " + path);
+            }
+
+            ~SfenFile()
+            {
+                close(fd_);
+            }
+
+            SfenFile(const SfenFile&) = delete;
+            SfenFile& operator=(const SfenFile&) = delete;
+
+            void write(const uint64_t first, const PackedSfen* records,
+                       const size_t count)
+            {
+                const char* data = reinterpret_cast<const char*>(records);
+                size_t size = count * sizeof(PackedSfen);
+                off_t offset = first * sizeof(PackedSfen);
+                while (size > 0)
+                {
+                    const auto written = pwrite(fd_, data, size, offset);
+                    if (written < 0 && errno == EINTR)
+                        continue;
+                    if (written <= 0)
+                        throw std::runtime_error("cannot write " + path_);
+                    data += written;
+                    size -= written;
+                    offset += written;
+                }
+            }
+
+        private:
+            const std::string path_;
+            const int fd_;
+        };
+
+        // Append the recorded positions of a new game to records
+        void play_game(AiMini& ai, std::mt19937_64& random,
+                       const GensfenOptions& options,
+                       std::vector<PackedSfen>& records)
+        {
+            Chessboard board;
+            unsigned ply = 0;
+            for (; ply < options.random_plies; ++ply)
+            {
+                const auto moves = board.generate_legal_moves();
+                if (moves.empty())
+                    return;
+                board.do_move(moves[random() % moves.size()]);
+            }
+
+            ai.clear();
+            const size_t first = records.size();
+            int white_result = 0;
+            for (; ply < options.max_plies; ++ply)
+            {
+                const auto legal_moves = board.generate_legal_moves();
+                const bool is_check = board.is_check();
+                const bool white_turn = board.get_white_turn();
+                if (board.is_checkmate(legal_moves, is_check))
+                {
+                    white_result = white_turn ? -1 : 1;
+                    break;
+                }
+                if (board.is_draw(legal_moves, is_check))
+                    break;
+
+                const auto info = ai.search(board, options.limits);
+                if (!info.move.has_value())
+                    break;
+                // The mate scores are INT16_MIN and INT16_MAX
+                const int16_t score = std::clamp<int>(
+                        white_turn ? info.score : -info.score,
+                        -INT16_MAX, INT16_MAX);
+                if (std::abs(score) >= options.score_limit)
+                {
+                    white_result = (score > 0) == white_turn ? 1 : -1;
+                    break;
+                }
+
+                const Move& move = info.move.value();
+                if (!is_check && !move.get_capture()
+                    && !move.get_promotion().has_value())
+                    records.push_back(pack(board, score, 0, ply));
+                board.do_move(move);
+            }
+
+            for (size_t i = first; i < records.size(); ++i)
+                records[i].result = records[i].state & 1 ? -white_result
+                                                         : white_result;
+        }
+
+        double per_hour(const uint64_t positions, const double seconds)
+        {
+            return seconds > 0 ? positions * 3600 / seconds : 0;
+        }
+    } // namespace
+
+    PackedSfen pack(const Chessboard& board, const int16_t score,
+                    const int8_t result, const uint16_t ply)
+    {
+        PackedSfen sfen;
+        sfen.score = score;
+        sfen.result = result;
+        sfen.ply = ply;
+
+        Chessboard::fen_buffer_t buffer;
+        const std::string_view fen = board.write_fen(buffer);
+        size_t square = 0;
+        size_t pieces = 0;
+        for (size_t i = 0; fen[i] != ' '; ++i)
+        {
+            if (fen[i] == '/')
+                continue;
+            if (fen[i] >= '1' && fen[i] <= '8')
+            {
+                square += fen[i] - '0';
+                continue;
+            }
+            if (pieces == 2 * sfen.pieces.size())
+                throw std::invalid_argument("more than 32 pieces");
+            const auto code = piece_codes.find(fen[i]);
+            sfen.occupancy |= uint64_t{1} << square;
+            sfen.pieces[pieces / 2] |= code << (pieces % 2 * 4);
+            pieces++;
+            square++;
+        }
+
+        sfen.state = !board.get_white_turn();
+        sfen.state |= board.get_king_castling(Color::WHITE) << 1;
+        sfen.state |= board.get_queen_castling(Color::WHITE) << 2;
+        sfen.state |= board.get_king_castling(Color::BLACK) << 3;
+        sfen.state |= board.get_queen_castling(Color::BLACK) << 4;
+        const auto en_passant = board.get_en_passant();
+        if (en_passant.has_value())
+            sfen.en_passant = static_cast<uint8_t>(en_passant->get_file());
+        sfen.halfmove_clock = std::min(board.get_halfmove_clock(), 255u);
+        return sfen;
+    }
+
+    Chessboard unpack(const PackedSfen& sfen)
+    {
+        std::string fen;
+        size_t piece = 0;
+        for (size_t rank = 0; rank < 8; ++rank)
+        {
+            char empty = '0';
+            for (size_t file = 0; file < 8; ++file)
+            {
+                if (!(sfen.occupancy >> (rank * 8 + file) & 1))
+                {
+                    empty++;
+                    continue;
+                }
+                if (empty != '0')
+                    fen += empty;
+                empty = '0';
+                if (piece == 2 * sfen.pieces.size())
+                    throw std::invalid_argument("more than 32 pieces");
+                const size_t code = sfen.pieces[piece / 2]
+                                    >> (piece % 2 * 4) & 0xf;
+                if (code >= piece_codes.size())
+                    throw std::invalid_argument("invalid piece code");
+                fen += piece_codes[code];
+                piece++;
+            }
+            if (empty != '0')
+                fen += empty;
+            if (rank < 7)
+                fen += '/';
+        }
+
+        const bool black_turn = sfen.state & 1;
+        fen += black_turn ? " b " : " w ";
+        const size_t castling_start = fen.size();
+        for (size_t i = 0; i < castling_codes.size(); ++i)
+            if (sfen.state >> (i + 1) & 1)
+                fen += castling_codes[i];
+        if (fen.size() == castling_start)
+            fen += '-';
+        fen += ' ';
+        if (sfen.en_passant < 8)
+        {
+            fen += static_cast<char>('a' + sfen.en_passant);
+            fen += black_turn ? '3' : '6';
+        }
+        else
+            fen += '-';
+        fen += ' ' + std::to_string(sfen.halfmove_clock) + ' '
+               + std::to_string(sfen.ply / 2 + 1);
+        return Chessboard::from_fen(fen);
+    }
+
+    GensfenSummary gensfen(const std::string& path,
+                           const GensfenOptions& options,
+                           std::ostream& report)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto elapsed = [&start]()
+        {
+            return std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+        };
+
+        SfenFile file(path);
+        const uint64_t blocks = (options.positions + block_size - 1)
+                                / block_size;
+        std::atomic<uint64_t> next = 0;
+        std::atomic<uint64_t> written = 0;
+        std::atomic<uint64_t> games = 0;
+        std::atomic<bool> failed = false;
+        std::mutex report_mutex;
+        std::exception_ptr error;
+        const auto worker = [&]()
+        {
+            try
+            {
+                AiMini ai;
+                std::mt19937_64 random(std::random_device{}());
+                // Positions of the played games not written yet
+                std::vector<PackedSfen> records;
+                for (uint64_t block = next++; block < blocks && !failed;
+                     block = next++)
+                {
+                    const uint64_t first = block * block_size;
+                    const size_t size = std::min(block_size,
+                                                 options.positions - first);
+                    while (records.size() < size && !failed)
+                    {
+                        play_game(ai, random, options, records);
+                        games++;
+                    }
+                    if (failed)
+                        break;
+                    file.write(first, records.data(), size);
+                    records.erase(records.begin(), records.begin() + size);
+
+                    const uint64_t done = written += size;
+                    const double seconds = elapsed();
+                    std::ostringstream text;
+                    text << done << " / " << options.positions
+                         << " positions, " << games << " games, "
+                         << std::fixed << std::setprecision(0)
+                         << per_hour(done, seconds) << " positions/hour\n";
+                    const std::lock_guard lock(report_mutex);
+                    report << text.str() << std::flush;
+                }
+            }
+            catch (...)
+            {
+                const std::lock_guard lock(report_mutex);
+                if (!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::max(1u, options.threads); ++t)
+            workers.emplace_back(worker);
+        for (auto& thread : workers)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+        return GensfenSummary{written, games, elapsed()};
+    }
+
+    std::ostream& operator<<(std::ostream& os,
+                             const GensfenSummary& summary)
+    {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2);
+        text << summary.positions << " positions from " << summary.games
+             << " games in " << summary.seconds << " s, "
+             << std::setprecision(0)
+             << per_hour(summary.positions, summary.seconds)
+             << " positions/hour\n";
+        return os << text.str();
+    }
+} // namespace ai
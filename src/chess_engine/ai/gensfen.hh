@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+#include "ai-mini.hh"
+
+// Training data for the tuner and the NNUE: positions of self-play games,
+// with their search score and the result of their game
+namespace ai
+{
+    /*
+    ** Record of the training files, 32 bytes in the byte order of the host.
+    ** Scores and results are from the point of view of the side to move.
+    */
+    struct PackedSfen
+    {
+        // Bit i is set when the square i is occupied, in the order of the
+        // FEN: a8 is 0, h8 7 and h1 63
+        uint64_t occupancy = 0;
+        // 4 bits per occupied square in the order of occupancy, the low
+        // ones first: the index of the piece in "PNBRQKpnbrqk"
+        std::array<uint8_t, 16> pieces{};
+        // Bit 0: black to move, bits 1 to 4: castling rights KQkq
+        uint8_t state = 0;
+        // File of the en passant square, 8 if there is none
+        uint8_t en_passant = 8;
+        // Capped to 255
+        uint8_t halfmove_clock = 0;
+        // 1 win, 0 draw, -1 loss
+        int8_t result = 0;
+        int16_t score = 0;
+        // Plies since the start of the game
+        uint16_t ply = 0;
+    };
+    static_assert(sizeof(PackedSfen) == 32);
+
+    PackedSfen pack(const board::Chessboard& board, int16_t score,
+                    int8_t result, uint16_t ply);
+    // The fullmove number is deduced from the ply
+    board::Chessboard unpack(const PackedSfen& sfen);
+
+    struct GensfenOptions
+    {
+        // Of every move, shallow searches give more positions per hour
+        SearchLimits limits{4, {}};
+        uint64_t positions = 1000000;
+        unsigned threads = 1;
+        // Random moves starting each game, for variety
+        unsigned random_plies = 8;
+        // Longer games are draws
+        unsigned max_plies = 400;
+        // Positions beyond it are not recorded, and their game is won by
+        // the side ahead
+        int16_t score_limit = 3000;
+    };
+
+    struct GensfenSummary
+    {
+        uint64_t positions = 0;
+        uint64_t games = 0;
+        double seconds = 0;
+    };
+
+    /*
+    ** Play games of the engine against itself on a pool of threads, and
+    ** write the quiet positions of the games (no check, the best move being
+    ** neither a capture nor a promotion) to path. Each thread fills blocks
+    ** of consecutive records, written at their own offset without any lock,
+    ** until the file holds the number of positions asked for. The progress
+    ** is written to report. Throws a std::runtime_error if the file cannot
+    ** be written.
+    */
+    GensfenSummary gensfen(const std::string& path,
+                           const GensfenOptions& options,
+                           std::ostream& report);
+
+    // Positions, games and positions per hour
+    std::ostream& operator<<(std::ostream& os,
+                             const GensfenSummary& summary);
+} // namespace ai
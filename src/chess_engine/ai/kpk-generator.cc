@@ -0,0 +1,39 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+#include "kpk.hh"
+
+// Write the KPK bitbase as the initializer list included by kpk.cc
+int main(int argc, const char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: kpk-generator OUTPUT\n";
+        return 1;
+    }
+
+    std::ofstream output(argv[1]);
+    if (!output)
+    {
+        std::cerr << "kpk-generator: cannot open " << argv[1] << '\n';
+        return 1;
+    }
+
+    // Too large for the stack of some sanitized builds
+    const auto bitbase = std::make_unique<ai::endgame::kpk::bitbase_t>(
+            ai::endgame::kpk::generate());
+
+    output << "// Generated by kpk-generator, do not edit\n{\n";
+    output << std::hex << std::setfill('0');
+    for (size_t i = 0; i < bitbase->size(); ++i)
+    {
+        output << (i % 4 == 0 ? "    " : " ")
+               << "0x" << std::setw(16) << (*bitbase)[i] << "ULL,"
+               << (i % 4 == 3 ? "\n" : "");
+    }
+    output << "}\n";
+
+    return output ? 0 : 1;
+}
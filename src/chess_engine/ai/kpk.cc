@@ -0,0 +1,38 @@
+#include "kpk.hh"
+
+using namespace board;
+
+namespace ai::endgame::kpk
+{
+    namespace
+    {
+        // Built by kpk-generator (see CMakeLists.txt)
+        constexpr bitbase_t bitbase =
+        #include "kpk-bitbase.inc"
+        ;
+    } // namespace
+
+    bool probe(const Color strong_side, int strong_king, int pawn,
+               int weak_king, Color side_to_move)
+    {
+        // Black pawn: mirror along the rank axis to get a white one
+        if (strong_side == Color::BLACK)
+        {
+            strong_king ^= 56;
+            pawn ^= 56;
+            weak_king ^= 56;
+            side_to_move = get_opposite_color(side_to_move);
+        }
+
+        // Pawn on the files e to h: mirror along the file axis
+        if (pawn % 8 > 3)
+        {
+            strong_king ^= 7;
+            pawn ^= 7;
+            weak_king ^= 7;
+        }
+
+        const size_t i = index(side_to_move, strong_king, pawn, weak_king);
+        return bitbase[i / 64] >> (i % 64) & 1;
+    }
+} // namespace ai::endgame::kpk
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "chess_engine/board/entity/color.hh"
+
+// King and pawn versus king bitbase
+//
+// One bit per position (white pawn on the files a to d, white or black to
+// move) telling whether white wins. Positions with the pawn on the files
+// e to h, or with a black pawn, are mirrored before the lookup.
+//
+// The table is the fixed point of a retrograde analysis, computed by the
+// constexpr generate() below. Evaluating it in a constant expression takes
+// minutes of compilation, so kpk-generator runs it once at build time and
+// the result is compiled in kpk.cc as a plain array.
+namespace ai::endgame::kpk
+{
+    // side to move * pawn squares (files a to d, ranks 2 to 7) * kings
+    constexpr size_t size = 2 * 24 * 64 * 64;
+    constexpr size_t words = size / 64;
+
+    using bitbase_t = std::array<uint64_t, words>;
+
+    constexpr size_t index(const board::Color side_to_move,
+                           const int white_king,
+                           const int pawn,
+                           const int black_king)
+    {
+        const size_t pawn_index = (pawn / 8 - 1) * 4 + pawn % 8;
+        return (((side_to_move == board::Color::WHITE ? 0 : 24) + pawn_index)
+                * 64 + white_king) * 64 + black_king;
+    }
+
+    namespace generation
+    {
+        // Results are combined with a bitwise or over the children
+        enum Result : uint8_t
+        {
+            INVALID = 0,
+            UNKNOWN = 1,
+            DRAW = 2,
+            WIN = 4
+        };
+
+        using results_t = std::array<uint8_t, size>;
+
+        constexpr int distance(const int a, const int b)
+        {
+            const int files = a % 8 > b % 8 ? a % 8 - b % 8 : b % 8 - a % 8;
+            const int ranks = a / 8 > b / 8 ? a / 8 - b / 8 : b / 8 - a / 8;
+            return files > ranks ? files : ranks;
+        }
+
+        constexpr bool pawn_attacks(const int pawn, const int square)
+        {
+            return square / 8 == pawn / 8 + 1
+                   && (square % 8 == pawn % 8 - 1
+                       || square % 8 == pawn % 8 + 1);
+        }
+
+        // Square reached by the king from square with (file, rank) offsets,
+        // -1 when outside of the board
+        constexpr int king_step(const int square, const int file,
+                                const int rank)
+        {
+            const int to_file = square % 8 + file;
+            const int to_rank = square / 8 + rank;
+            if (to_file < 0 || to_file > 7 || to_rank < 0 || to_rank > 7)
+                return -1;
+            return to_rank * 8 + to_file;
+        }
+
+        // Results known without looking at the children
+        constexpr Result initial(const board::Color side_to_move,
+                                 const int white_king, const int pawn,
+                                 const int black_king)
+        {
+            const bool white = side_to_move == board::Color::WHITE;
+
+            if (white_king == black_king || white_king == pawn
+                || black_king == pawn || distance(white_king, black_king) <= 1)
+                return INVALID;
+            if (white && pawn_attacks(pawn, black_king))
+                return INVALID;
+
+            // The pawn promotes safely
+            const int promotion = pawn + 8;
+            if (white && pawn / 8 == 6 && white_king != promotion
+                && black_king != promotion
+                && (distance(black_king, promotion) > 1
+                    || distance(white_king, promotion) == 1))
+                return WIN;
+
+            if (white)
+                return UNKNOWN;
+
+            // Stalemate or capture of the undefended pawn
+            bool has_move = false;
+            for (int file = -1; file <= 1; ++file)
+                for (int rank = -1; rank <= 1; ++rank)
+                {
+                    const int to = king_step(black_king, file, rank);
+                    if (to < 0 || (!file && !rank)
+                        || distance(to, white_king) <= 1
+                        || pawn_attacks(pawn, to))
+                        continue;
+                    if (to == pawn)
+                        return DRAW;
+                    has_move = true;
+                }
+
+            return has_move ? UNKNOWN : DRAW;
+        }
+
+        // White wins if one move wins, black draws if one move draws
+        constexpr Result classify(const results_t& results,
+                                  const board::Color side_to_move,
+                                  const int white_king, const int pawn,
+                                  const int black_king)
+        {
+            const bool white = side_to_move == board::Color::WHITE;
+            const board::Color other = white ? board::Color::BLACK
+                                             : board::Color::WHITE;
+            const int king = white ? white_king : black_king;
+
+            // Illegal children are INVALID, so they do not count
+            uint8_t children = 0;
+            for (int file = -1; file <= 1; ++file)
+                for (int rank = -1; rank <= 1; ++rank)
+                {
+                    const int to = king_step(king, file, rank);
+                    if (to < 0 || (!file && !rank))
+                        continue;
+                    children |= white
+                        ? results[index(other, to, pawn, black_king)]
+                        : results[index(other, white_king, pawn, to)];
+                }
+
+            // Pushes (the promotions are already handled by initial)
+            const int push = pawn + 8;
+            if (white && pawn / 8 < 6 && push != white_king
+                && push != black_king)
+            {
+                children |= results[index(other, white_king, push,
+                                           black_king)];
+                const int double_push = push + 8;
+                if (pawn / 8 == 1 && double_push != white_king
+                    && double_push != black_king)
+                    children |= results[index(other, white_king,
+                                               double_push, black_king)];
+            }
+
+            const Result good = white ? WIN : DRAW;
+            const Result bad = white ? DRAW : WIN;
+            if (children & good)
+                return good;
+            return children & UNKNOWN ? UNKNOWN : bad;
+        }
+
+        template <typename F>
+        constexpr void for_each_position(F&& f)
+        {
+            for (const auto color : {board::Color::WHITE, board::Color::BLACK})
+                for (int pawn_index = 0; pawn_index < 24; ++pawn_index)
+                    for (int white_king = 0; white_king < 64; ++white_king)
+                        for (int black_king = 0; black_king < 64; ++black_king)
+                            f(color, white_king,
+                              (pawn_index / 4 + 1) * 8 + pawn_index % 4,
+                              black_king);
+        }
+    } // namespace generation
+
+    // Iterate until no more position gets resolved, the remaining
+    // unknown positions are draws
+    constexpr bitbase_t generate()
+    {
+        using namespace generation;
+
+        results_t results{};
+        for_each_position([&results](auto color, int wk, int pawn, int bk)
+        {
+            results[index(color, wk, pawn, bk)] = initial(color, wk, pawn, bk);
+        });
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for_each_position([&](auto color, int wk, int pawn, int bk)
+            {
+                uint8_t& result = results[index(color, wk, pawn, bk)];
+                if (result != UNKNOWN)
+                    return;
+                result = classify(results, color, wk, pawn, bk);
+                changed |= result != UNKNOWN;
+            });
+        }
+
+        bitbase_t bitbase{};
+        for (size_t i = 0; i < size; ++i)
+            if (results[i] == WIN)
+                bitbase[i / 64] |= uint64_t{1} << (i % 64);
+        return bitbase;
+    }
+
+    // Whether the side owning the pawn wins, squares are a1 = 0 ... h8 = 63
+    bool probe(board::Color strong_side, int strong_king, int pawn,
+               int weak_king, board::Color side_to_move);
+} // namespace ai::endgame::kpk
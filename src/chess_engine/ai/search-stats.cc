@@ -0,0 +1,33 @@
+#include "search-stats.hh"
+
+namespace ai
+{
+    std::chrono::milliseconds SearchStats::time(void) const
+    {
+        return iteration_times.empty() ? std::chrono::milliseconds(0)
+                                       : iteration_times.back();
+    }
+
+    uint64_t SearchStats::nps(void) const
+    {
+        const auto ms = time().count();
+        return ms > 0 ? nodes * 1000 / ms : 0;
+    }
+
+    std::ostream& write_json(std::ostream& os, const SearchStats& stats)
+    {
+        os << "{\"nodes\":" << stats.nodes
+           << ",\"qnodes\":" << stats.qnodes
+           << ",\"beta_cutoffs\":" << stats.beta_cutoffs
+           << ",\"first_move_cutoffs\":" << stats.first_move_cutoffs
+           << ",\"tt_hits\":" << stats.tt_hits
+           << ",\"tt_cutoffs\":" << stats.tt_cutoffs
+           << ",\"seldepth\":" << stats.seldepth
+           << ",\"time_ms\":" << stats.time().count()
+           << ",\"nps\":" << stats.nps()
+           << ",\"iteration_times_ms\":[";
+        for (size_t i = 0; i < stats.iteration_times.size(); ++i)
+            os << (i > 0 ? "," : "") << stats.iteration_times[i].count();
+        return os << "]}";
+    }
+} // namespace ai
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+namespace ai
+{
+    // Counters of a search, to measure how efficient it is
+    struct SearchStats
+    {
+        // Every node, including the nodes of the capture extension
+        uint64_t nodes = 0;
+        // Nodes of the capture extension, below the nominal depth
+        uint64_t qnodes = 0;
+        uint64_t beta_cutoffs = 0;
+        // Beta cutoffs produced by the first move searched, the closer to
+        // beta_cutoffs the better the move ordering
+        uint64_t first_move_cutoffs = 0;
+        // Positions found in the transposition table, and how many of them
+        // were not searched again
+        uint64_t tt_hits = 0;
+        uint64_t tt_cutoffs = 0;
+        // Deepest ply reached
+        int seldepth = 0;
+        // Time elapsed at the end of each completed iteration
+        std::vector<std::chrono::milliseconds> iteration_times;
+
+        std::chrono::milliseconds time(void) const;
+        uint64_t nps(void) const;
+    };
+
+    // Single line JSON object, eg: {"nodes":1234,"qnodes":56,...}
+    std::ostream& write_json(std::ostream& os, const SearchStats& stats);
+} // namespace ai
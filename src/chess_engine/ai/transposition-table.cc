@@ -0,0 +1,74 @@
+#include "transposition-table.hh"
+
+#include <algorithm>
+
+#include "utils/trace.hh"
+
+namespace ai
+{
+    TranspositionTable::TranspositionTable(const size_t megabytes)
+    {
+        resize(megabytes);
+    }
+
+    void TranspositionTable::resize(const size_t megabytes)
+    {
+        const size_t bytes = std::clamp<size_t>(megabytes, 1, max_hash_mb)
+                             << 20;
+        size_t entries = 1;
+        while (entries * 2 * sizeof(TTEntry) <= bytes)
+            entries *= 2;
+
+        // Release the memory before allocating the new table
+        entries_ = std::vector<TTEntry>();
+        entries_.resize(entries);
+    }
+
+    void TranspositionTable::clear(void)
+    {
+        std::fill(entries_.begin(), entries_.end(), TTEntry{});
+        generation_ = 1;
+    }
+
+    void TranspositionTable::new_search(void)
+    {
+        // 0 is the generation of the empty entries
+        generation_ = generation_ == UINT8_MAX ? 1 : generation_ + 1;
+    }
+
+    const TTEntry* TranspositionTable::probe(const uint64_t key) const
+    {
+        TRACE_SCOPE("tt_probe");
+        const TTEntry& entry = entries_[key & (entries_.size() - 1)];
+        return entry.generation != 0 && entry.key == key ? &entry : nullptr;
+    }
+
+    void TranspositionTable::store(const uint64_t key, const int16_t depth,
+                                   const int16_t value, const Bound bound,
+                                   const std::optional<board::Move>& move)
+    {
+        TTEntry& entry = entries_[key & (entries_.size() - 1)];
+        if (entry.generation == generation_ && entry.key != key
+            && entry.depth > depth)
+            return;
+        entry = TTEntry{key, value, depth, bound, generation_, move};
+    }
+
+    int TranspositionTable::hashfull(void) const
+    {
+        const size_t sample = std::min<size_t>(1000, entries_.size());
+        const auto used = std::count_if(entries_.begin(),
+                                        entries_.begin() + sample,
+                                        [this](const TTEntry& entry)
+                                        {
+                                            return entry.generation
+                                                   == generation_;
+                                        });
+        return used * 1000 / sample;
+    }
+
+    size_t TranspositionTable::size(void) const
+    {
+        return entries_.size();
+    }
+} // namespace ai
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "chess_engine/board/entity/move.hh"
+
+// Results of the searched positions, indexed by their Polyglot key. An entry
+// is replaced by any result of a newer search, or by a deeper result of the
+// same search.
+namespace ai
+{
+    constexpr size_t default_hash_mb = 16;
+    constexpr size_t max_hash_mb = 4096;
+
+    // How the value relates to the real value of the position
+    enum class Bound : uint8_t
+    {
+        EXACT,
+        LOWER, // The real value is at least value (beta cutoff)
+        UPPER  // The real value is at most value (no move reached alpha)
+    };
+
+    struct TTEntry
+    {
+        uint64_t key = 0;
+        // From the point of view of white
+        int16_t value = 0;
+        int16_t depth = 0;
+        Bound bound = Bound::EXACT;
+        uint8_t generation = 0;
+        std::optional<board::Move> move;
+    };
+
+    class TranspositionTable
+    {
+    public:
+        explicit TranspositionTable(size_t megabytes = default_hash_mb);
+
+        // Drops every entry, the size is rounded down to a power of two
+        void resize(size_t megabytes);
+        void clear(void);
+        // Entries of the previous searches become replaceable
+        void new_search(void);
+
+        // nullptr if the position was not searched
+        const TTEntry* probe(uint64_t key) const;
+        void store(uint64_t key, int16_t depth, int16_t value, Bound bound,
+                   const std::optional<board::Move>& move);
+
+        // Permille of the table used by the current search, as sent to UCI
+        int hashfull(void) const;
+        size_t size(void) const;
+
+    private:
+        std::vector<TTEntry> entries_;
+        uint8_t generation_ = 1;
+    };
+} // namespace ai
@@ -1,67 +1,388 @@
 #include "uci.hh"
 
-#include <fnmatch.h>
+#include <mutex>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "parsing/pgn_parser/ebnf-parser.hh"
 
 namespace uci
 {
     namespace
     {
-        std::string get_input(const std::string& expected = "*")
+        struct RegisteredOption
+        {
+            Option option;
+            std::string value;
+        };
+
+        std::vector<RegisteredOption> options;
+        bool debug_mode = false;
+
+        // The searches run in their own thread, lines are sent whole
+        std::mutex output_mutex;
+
+        void send(const std::string& line)
+        {
+            const std::lock_guard lock(output_mutex);
+            std::cout << line << std::endl;
+        }
+
+        std::string lower(std::string str)
+        {
+            std::transform(str.begin(), str.end(), str.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            return str;
+        }
+
+        // Option names are case insensitive
+        RegisteredOption* find_option(const std::string& name)
+        {
+            const std::string lower_name = lower(name);
+            for (auto& registered : options)
+                if (lower(registered.option.name) == lower_name)
+                    return &registered;
+            return nullptr;
+        }
+
+        // The value given to the option, nullopt if it is not valid
+        std::optional<std::string> normalize(const Option& option,
+                                             const std::string& value)
+        {
+            switch (option.type)
+            {
+                case Option::Type::CHECK:
+                    if (value == "true" || value == "false")
+                        return value;
+                    return std::nullopt;
+                case Option::Type::SPIN:
+                {
+                    int number;
+                    const char* end = value.data() + value.size();
+                    const auto [ptr, ec] = std::from_chars(value.data(), end,
+                                                           number);
+                    if (ec != std::errc() || ptr != end)
+                        return std::nullopt;
+                    return std::to_string(std::clamp(number, option.min,
+                                                     option.max));
+                }
+                case Option::Type::STRING:
+                    return value == "<empty>" ? "" : value;
+                case Option::Type::BUTTON:
+                    return "";
+            }
+            return std::nullopt;
+        }
+
+        std::ostream& operator<<(std::ostream& os, const Option& option)
+        {
+            os << "option name " << option.name << " type ";
+            switch (option.type)
+            {
+                case Option::Type::CHECK:
+                    return os << "check default " << option.default_value;
+                case Option::Type::SPIN:
+                    return os << "spin default " << option.default_value
+                              << " min " << option.min << " max "
+                              << option.max;
+                case Option::Type::STRING:
+                    return os << "string default " << option.default_value;
+                case Option::Type::BUTTON:
+                    return os << "button";
+            }
+            return os;
+        }
+
+        // Format: setoption name NAME [value VALUE]
+        void set_option(const std::string& command)
         {
-            // Get a command following the expected globbing
-            // Ignoring all unrecognized commands
-            std::string buffer;
-            do
+            static const std::string name_str = "name ";
+            static const std::string value_str = " value ";
+
+            const auto name_pos = command.find(name_str);
+            if (name_pos == std::string::npos)
+                return;
+            const auto value_pos = command.find(value_str, name_pos);
+
+            const auto name_begin = name_pos + name_str.size();
+            const std::string name = command.substr(name_begin,
+                                                    value_pos - name_begin);
+            const std::string value = value_pos == std::string::npos
+                    ? ""
+                    : command.substr(value_pos + value_str.size());
+
+            RegisteredOption* registered = find_option(name);
+            if (registered == nullptr)
             {
-                std::getline(std::cin, buffer);
-                if ("quit" == buffer || "stopuci" == buffer)
-                    exit(0);
-                #ifdef LICHESS
-                if ("isready" == buffer && "isready" != expected)
-                    std::cout << "readyok" << std::endl;
-                #endif /* LICHESS */
-            } while (fnmatch(expected.c_str(), buffer.c_str(), 0));
-            return buffer;
+                send("info string unknown option " + name);
+                return;
+            }
+            const auto normalized = normalize(registered->option, value);
+            if (!normalized.has_value())
+            {
+                send("info string invalid value " + value + " for option "
+                     + registered->option.name);
+                return;
+            }
+            registered->value = normalized.value();
+            if (registered->option.on_change)
+                registered->option.on_change(registered->value);
+        }
+
+        void send_line(const ai::SearchInfo& info, const ai::SearchLine& line,
+                       const size_t multipv, const bool white_turn)
+        {
+            const auto time = info.time.count();
+            std::ostringstream text;
+            text << "info "
+                 << "depth " << info.depth << " "
+                 << "seldepth " << info.stats.seldepth << " "
+                 << "multipv " << multipv << " "
+                 << "score cp " << (white_turn ? line.score : -line.score)
+                 << " "
+                 << "nodes " << info.stats.nodes << " "
+                 << "hashfull " << info.hashfull << " "
+                 << "nps " << (time > 0 ? info.stats.nodes * 1000 / time
+                                        : 0) << " "
+                 << "time " << time;
+            if (!line.pv.empty())
+                text << " pv";
+            for (const auto& move : line.pv)
+                text << ' ' << pgn_parser::move_to_string(move);
+            send(text.str());
+        }
+
+        void send_id(const std::string& name)
+        {
+            std::ostringstream text;
+            text << "id name " << name << '\n';
+            text << "id author " << name << '\n';
+            for (const auto& registered : options)
+                text << registered.option << '\n';
+            text << "uciok";
+            send(text.str());
         }
     } // namespace
 
-    void init(const std::string& name)
+    GoCommand parse_go(const std::string& command)
     {
-        get_input("uci");
-        std::cout << "id name " << name << '\n';
-        std::cout << "id author " << name << '\n';
-        std::cout << "uciok" << std::endl;
-        get_input("isready");
-        std::cout << "readyok" << std::endl;
-        #ifdef LICHESS
-        get_input("position *");
-        #endif /* LICHESS */
+        GoCommand go;
+        std::istringstream tokens(command);
+        std::string token;
+        const auto read_ms = [&tokens]()
+        {
+            long long ms;
+            tokens >> ms;
+            return std::chrono::milliseconds(std::max(0LL, ms));
+        };
+
+        while (tokens >> token)
+        {
+            if (token == "depth")
+            {
+                int depth;
+                if (tokens >> depth)
+                    go.depth = depth;
+            }
+            else if (token == "movetime")
+                go.movetime = read_ms();
+            else if (token == "wtime")
+                go.wtime = read_ms();
+            else if (token == "btime")
+                go.btime = read_ms();
+            else if (token == "winc")
+                go.winc = read_ms();
+            else if (token == "binc")
+                go.binc = read_ms();
+            else if (token == "movestogo")
+            {
+                int moves;
+                if (tokens >> moves && moves > 0)
+                    go.movestogo = moves;
+            }
+            else if (token == "infinite")
+                go.infinite = true;
+            else if (token == "ponder")
+                go.ponder = true;
+        }
+        return go;
     }
 
-    void play_move(const std::string& move)
+    bool Position::set(const std::string& command)
     {
-        // Send the computed move
-        std::cout << "bestmove " << move << std::endl;
+        std::istringstream tokens(command);
+        std::string token;
+        tokens >> token >> token;
+
+        std::string fen;
+        if (token == "fen")
+        {
+            while (tokens >> token && token != "moves")
+                fen += (fen.empty() ? "" : " ") + token;
+        }
+        else if (token == "startpos")
+            tokens >> token;
+        else
+            return false;
+
+        std::vector<std::string> moves;
+        if (token == "moves")
+            while (tokens >> token)
+                moves.push_back(token);
+
+        // Only the new moves are played when the game goes on
+        const bool goes_on = fen == fen_ && moves_.size() <= moves.size()
+                             && std::equal(moves_.begin(), moves_.end(),
+                                           moves.begin());
+        if (!goes_on)
+        {
+            try
+            {
+                board_ = fen.empty() ? board::Chessboard()
+                                     : board::Chessboard::from_fen(fen);
+            }
+            catch (const std::invalid_argument&)
+            {
+                return false;
+            }
+            fen_ = fen;
+            moves_.clear();
+        }
+
+        moves_played_ = 0;
+        for (size_t i = moves_.size(); i < moves.size(); ++i)
+        {
+            const auto legal_moves = board_.generate_legal_moves();
+            const auto move = std::find_if(legal_moves.begin(),
+                                           legal_moves.end(),
+                                           [&](const board::Move& legal)
+                                           {
+                                               return pgn_parser::
+                                                   move_to_string(legal)
+                                                   == moves[i];
+                                           });
+            if (move == legal_moves.end())
+                return false;
+            board_.do_move(*move);
+            moves_.push_back(moves[i]);
+            moves_played_++;
+        }
+        return true;
+    }
+
+    const board::Chessboard& Position::board(void) const
+    {
+        return board_;
+    }
+
+    size_t Position::moves_played(void) const
+    {
+        return moves_played_;
     }
 
-    void info(const int depth, const int evaluation_score)
+    void loop(const std::string& name, const Engine& engine,
+              std::istream& input)
+    {
+        options.clear();
+        for (const auto& option : engine.options)
+        {
+            const auto value = normalize(option, option.default_value);
+            options.push_back(RegisteredOption{option, value.value_or("")});
+            if (option.on_change && option.type != Option::Type::BUTTON)
+                option.on_change(options.back().value);
+        }
+
+        std::string line;
+        while (std::getline(input, line))
+        {
+            std::istringstream tokens(line);
+            std::string command;
+            tokens >> command;
+
+            if (command == "quit")
+                break;
+            else if (command == "uci")
+                send_id(name);
+            else if (command == "isready")
+                send("readyok");
+            else if (command == "setoption")
+                set_option(line);
+            else if (command == "debug")
+            {
+                std::string mode;
+                tokens >> mode;
+                debug_mode = mode == "on";
+            }
+            else if (command == "ucinewgame")
+            {
+                if (engine.on_new_game)
+                    engine.on_new_game();
+            }
+            else if (command == "position")
+                engine.on_position(line);
+            else if (command == "go")
+                engine.on_go(parse_go(line));
+            else if (command == "stop")
+            {
+                if (engine.on_stop)
+                    engine.on_stop();
+            }
+            else if (command == "ponderhit")
+            {
+                if (engine.on_ponderhit)
+                    engine.on_ponderhit();
+            }
+            else if (!command.empty() && debug_mode)
+                send("info string unknown command " + command);
+        }
+    }
+
+    std::string option_value(const std::string& name)
+    {
+        const RegisteredOption* registered = find_option(name);
+        return registered != nullptr ? registered->value : "";
+    }
+
+    bool debug(void)
+    {
+        return debug_mode;
+    }
+
+    void play_move(const std::string& move, const std::string& ponder)
     {
         // Send the computed move
-        std::cout << "info "
-                  << "depth " << depth << " "
-                  << "score cp " << evaluation_score << std::endl;
+        send("bestmove " + move + (ponder.empty() ? "" : " ponder " + ponder));
+    }
+
+    void info_string(const std::string& text)
+    {
+        send("info string " + text);
     }
 
-    std::string get_board()
+    void info(const ai::SearchInfo& info, const bool white_turn)
     {
-        auto board = get_input("position *"); // Get the board
-        return board;
+        if (info.lines.empty())
+            send_line(info, ai::SearchLine{info.score, {}}, 1, white_turn);
+        for (size_t i = 0; i < info.lines.size(); ++i)
+            send_line(info, info.lines[i], i + 1, white_turn);
     }
 
-    std::string get_go()
+    void dump_stats(const ai::SearchInfo& info, const std::string& path)
     {
-        auto go_str = get_input("go *"); // Wait for a go from GUI
-        return go_str;
+        if (path.empty())
+            return;
+        std::ofstream file(path, std::ios::app);
+        file << "{\"depth\":" << info.depth
+             << ",\"score\":" << info.score
+             << ",\"bestmove\":\""
+             << (info.move.has_value()
+                 ? pgn_parser::move_to_string(info.move.value()) : "")
+             << "\",\"stats\":";
+        ai::write_json(file, info.stats) << "}\n";
     }
-} // namespace ai
+} // namespace uci
@@ -1,45 +1,151 @@
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <vector>
+#include <istream>
+#include <optional>
+#include <functional>
+
+#include "chess_engine/ai/ai-mini.hh"
 
 // Interface to play with the chess engine with ai
 namespace uci
 {
-    /** Initialize the communication with the GUI. This function should be
-     * called only once at the begining of a game.
+    /** Setting of the engine, sent in answer to uci and changed by
+     * setoption name NAME [value VALUE]
+     */
+    struct Option
+    {
+        enum class Type
+        {
+            CHECK,
+            SPIN,
+            STRING,
+            BUTTON
+        };
+
+        std::string name;
+        Type type;
+        std::string default_value;
+        // Bounds of a spin, out of bounds values are clamped
+        int min = 0;
+        int max = 0;
+        // Called with the new value, and with the default one by loop
+        std::function<void(const std::string& value)> on_change;
+    };
+
+    /** Parameters of a go command, the missing ones being unset
+     * Eg:
+     * - go depth 6
+     * - go wtime 60000 btime 58000 winc 1000 binc 1000 movestogo 20
+     */
+    struct GoCommand
+    {
+        std::optional<int16_t> depth;
+        std::optional<std::chrono::milliseconds> movetime;
+        std::optional<std::chrono::milliseconds> wtime;
+        std::optional<std::chrono::milliseconds> btime;
+        std::chrono::milliseconds winc{0};
+        std::chrono::milliseconds binc{0};
+        std::optional<int> movestogo;
+        bool infinite = false;
+        // The position is the one after the expected move of the opponent,
+        // the search goes on until ponderhit (then with the clock) or stop
+        bool ponder = false;
+    };
+
+    GoCommand parse_go(const std::string& command);
+
+    /** Board described by the position commands. Each command is read
+     * entirely and does not depend on the previous ones, but when its
+     * moves extend the moves of the previous command, only the new moves
+     * are played.
+     */
+    class Position
+    {
+    public:
+        /** Format: position [startpos | fen FEN] (moves ...)
+         * False if the command is invalid, the board being then the
+         * position before the first invalid move (or unchanged for an
+         * invalid FEN)
+         */
+        bool set(const std::string& command);
+
+        // With the history of the played moves, for the repetitions
+        const board::Chessboard& board(void) const;
+        // Moves played by the last set
+        size_t moves_played(void) const;
+
+    private:
+        // Empty for the starting position
+        std::string fen_;
+        std::vector<std::string> moves_;
+        board::Chessboard board_;
+        size_t moves_played_ = 0;
+    };
+
+    /** What the engine does on the commands changing its state, the
+     * protocol itself (uci, isready, setoption, debug, quit) being answered
+     * by loop
+     */
+    struct Engine
+    {
+        std::vector<Option> options;
+        // Format: position [startpos | fen FEN] (moves ...)
+        std::function<void(const std::string& command)> on_position;
+        // Has to send the bestmove, the commands are still read while
+        // searching: the search should run in another thread
+        std::function<void(const GoCommand& go)> on_go;
+        std::function<void(void)> on_new_game;
+        // The bestmove has to be sent as soon as possible
+        std::function<void(void)> on_stop;
+        // The opponent played the expected move of go ponder
+        std::function<void(void)> on_ponderhit;
+    };
+
+    /** Answer the commands of the GUI until quit or the end of the input,
+     * the output being safe to send from several threads.
      * name: your ai name
      * Eg:
      * - "One AI To Rule Them All"
      */
-    void init(const std::string& name);
+    void loop(const std::string& name, const Engine& engine,
+              std::istream& input);
+
+    /** Current value of a registered option, empty if there is none
+     */
+    std::string option_value(const std::string& name);
+
+    /** Whether the GUI asked for debug information (debug on)
+     */
+    bool debug(void);
 
-    /** Send a move to GUI
+    /** Send a move to GUI, with the expected reply to ponder on if any
      * move: String following EBNF
      * Eg:
      * - e2e4
      * - e1g1
      */
-    void play_move(const std::string& move);
+    void play_move(const std::string& move, const std::string& ponder = "");
 
-    /** Send score and depth info to GUI
+    /** Send a message to GUI, shown to the user
+     * Eg:
+     * - info string book book.bin loaded (1024 entries)
      */
-    void info(const int depth, const int evaluation_score);
+    void info_string(const std::string& text);
 
-    /** Receive and return the command describing a board state
-     * Format: position [startpos | fen FEN] (moves ...)
+    /** Send the result of a search to GUI, one line per principal
+     * variation, the score being from the point of view of the side to move
      * Eg:
-     * -position startpos
-     * -position startpos moves e2e4
-     * -position fen rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1
-     * -position fen rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1
-     * moves f7f5
+     * - info depth 5 seldepth 11 multipv 1 score cp 32 nodes 81920
+     * hashfull 12 nps 409600 time 200 pv e2e4 e7e5 g1f3
      */
-    std::string get_board();
+    void info(const ai::SearchInfo& info, bool white_turn);
 
-    /** Receive and return the command describing go state
-     * Format: go [depth DEPTH]
-     * Eg:
-     * -go depth 4
+    /** Append the search to the file of the StatsFile option as a JSON line,
+     * nothing is done when the option is not set. The value is read by the
+     * caller, the searches run while set_option changes it.
      */
-    std::string get_go();
-} // namespace ai
+    void dump_stats(const ai::SearchInfo& info, const std::string& path);
+} // namespace uci
@@ -6,13 +6,47 @@
 #include "entity/move.hh"
 #include "move-initialization.hh"
 #include "move-generation.hh"
+#include "utils/trace.hh"
 
 #include <cassert>
+#include <charconv>
 #include <optional>
-#include <sstream>
+#include <stdexcept>
 
 namespace board
 {
+    namespace
+    {
+        [[noreturn]] void bad_fen(const std::string_view fen,
+                                  const std::string& why)
+        {
+            throw std::invalid_argument("bad FEN, " + why + ": "
+                                        + std::string(fen));
+        }
+
+        // Remove and return the next field of the FEN, empty at the end
+        std::string_view next_field(std::string_view& fen)
+        {
+            const size_t begin = std::min(fen.find_first_not_of(' '),
+                                          fen.size());
+            const size_t end = std::min(fen.find(' ', begin), fen.size());
+            const std::string_view field = fen.substr(begin, end - begin);
+            fen.remove_prefix(end);
+            return field;
+        }
+
+        std::optional<unsigned> parse_counter(const std::string_view field)
+        {
+            unsigned value = 0;
+            const char* end = field.data() + field.size();
+            const auto [ptr, error] = std::from_chars(field.data(), end,
+                                                      value);
+            if (error != std::errc() || ptr != end)
+                return std::nullopt;
+            return value;
+        }
+    } // namespace
+
     Chessboard::Chessboard()
     {
         board_ = Board();
@@ -28,7 +62,7 @@ namespace board
         en_passant_ = std::nullopt;
 
         turn_ = 0;
-        last_fifty_turn_ = 0;
+        halfmove_clock_ = 0;
 
         register_state();
     }
@@ -54,9 +88,9 @@ namespace board
 
         en_passant_ = fen.en_passant_target_get();
 
-        // FIXME it should be an available data in the fen string
+        // The clocks are not kept by FenObject
         turn_ = 0;
-        last_fifty_turn_ = 0;
+        halfmove_clock_ = 0;
 
         for (size_t rank_i = 0; rank_i < width; rank_i++)
         {
@@ -79,10 +113,121 @@ namespace board
         register_state();
     }
 
+    Chessboard::Chessboard(EmptyTag)
+        : white_turn_(true)
+        , white_king_castling_(false)
+        , white_queen_castling_(false)
+        , black_king_castling_(false)
+        , black_queen_castling_(false)
+        , en_passant_(std::nullopt)
+        , turn_(0)
+        , halfmove_clock_(0)
+    {}
+
+    Chessboard Chessboard::from_fen(const std::string_view fen)
+    {
+        Chessboard board{EmptyTag()};
+        std::string_view rest = fen;
+
+        // Ranks are given from 8 to 1, files from a to h
+        constexpr int size = width;
+        int rank = size - 1;
+        int file = 0;
+        for (const char c : next_field(rest))
+        {
+            if (c == '/')
+            {
+                if (file != size || rank == 0)
+                    bad_fen(fen, "wrong rank size");
+                rank--;
+                file = 0;
+            }
+            else if (c >= '1' && c <= '8')
+                file += c - '0';
+            else
+            {
+                if (file >= size)
+                    bad_fen(fen, "wrong rank size");
+                const Color color = isupper(c) ? Color::WHITE : Color::BLACK;
+                try
+                {
+                    board.board_.set_piece(Position(file, rank),
+                                           char_to_piece(toupper(c)), color);
+                }
+                catch (const std::invalid_argument&)
+                {
+                    bad_fen(fen, std::string("unknown piece ") + c);
+                }
+                file++;
+            }
+
+            if (file > size)
+                bad_fen(fen, "wrong rank size");
+        }
+        if (file != size || rank != 0)
+            bad_fen(fen, "wrong number of squares");
+
+        const std::string_view side = next_field(rest);
+        if (side != "w" && side != "b")
+            bad_fen(fen, "wrong side to move");
+        board.white_turn_ = side == "w";
+
+        const std::string_view castling = next_field(rest);
+        if (castling != "-")
+            for (const char c : castling)
+                switch (c)
+                {
+                case 'K':
+                    board.white_king_castling_ = true;
+                    break;
+                case 'Q':
+                    board.white_queen_castling_ = true;
+                    break;
+                case 'k':
+                    board.black_king_castling_ = true;
+                    break;
+                case 'q':
+                    board.black_queen_castling_ = true;
+                    break;
+                default:
+                    bad_fen(fen, "wrong castling rights");
+                }
+
+        const std::string_view en_passant = next_field(rest);
+        if (en_passant != "-")
+        {
+            if (en_passant.size() != 2 || en_passant[0] < 'a'
+                || en_passant[0] > 'h'
+                || (en_passant[1] != '3' && en_passant[1] != '6'))
+                bad_fen(fen, "wrong en passant square");
+            board.en_passant_ = Position(en_passant[0], en_passant[1]);
+        }
+
+        // Optional clocks
+        const std::string_view halfmove = next_field(rest);
+        const std::string_view fullmove = next_field(rest);
+        if (!halfmove.empty())
+        {
+            const auto halfmove_clock = parse_counter(halfmove);
+            const auto fullmove_number = fullmove.empty()
+                                         ? std::optional<unsigned>(1)
+                                         : parse_counter(fullmove);
+            if (!halfmove_clock.has_value() || !fullmove_number.has_value())
+                bad_fen(fen, "wrong clocks");
+            board.halfmove_clock_ = halfmove_clock.value();
+            board.turn_ = std::max(1u, fullmove_number.value()) - 1;
+        }
+        if (!next_field(rest).empty())
+            bad_fen(fen, "trailing fields");
+
+        board.register_state();
+        return board;
+    }
+
     Chessboard::Chessboard(const std::string& str, const Color& color)
-            : Chessboard(parse_perft(str + ((color == Color::WHITE)
-                                           ? std::string(" w - - 0 0 0")
-                                           : std::string(" b - - 0 0 0"))))
+            : Chessboard(from_fen(str + ((color == Color::WHITE)
+                                         ? std::string(" w - -")
+                                         : std::string(" b - -"))))
     {}
 
     Chessboard::Chessboard(const PerftObject& perft)
@@ -90,7 +235,7 @@ namespace board
     {}
 
     Chessboard::Chessboard(const std::string& fen_string)
-            : Chessboard(parse_perft(fen_string + std::string(" w - - 0 0 0")))
+            : Chessboard(from_fen(fen_string + std::string(" w - -")))
     {}
 
     char Chessboard::sidepiece_to_char(const PieceType& piece,
@@ -110,10 +255,9 @@ namespace board
                                     : tolower(piece_char);
     }
 
-    std::ostream& Chessboard::write_fen_rank(std::ostream& os,
-                                             const Rank rank) const
+    char* Chessboard::write_fen_rank(char* out, const Rank rank) const
     {
-        unsigned short empty_cells_count = 0;
+        char empty_cells_count = 0;
 
         for (size_t file_i = 0; file_i < width; file_i++)
         {
@@ -125,11 +269,11 @@ namespace board
             {
                 if (empty_cells_count != 0)
                 {
-                    os << empty_cells_count;
+                    *out++ = '0' + empty_cells_count;
                     empty_cells_count = 0;
                 }
 
-                os << sidepiece_to_char(opt_piece.value());
+                *out++ = sidepiece_to_char(opt_piece.value());
             }
             else
             {
@@ -138,31 +282,73 @@ namespace board
         }
 
         if (empty_cells_count != 0)
-            os << empty_cells_count;
+            *out++ = '0' + empty_cells_count;
 
-        return os;
+        return out;
     }
 
-    std::ostream& Chessboard::write_fen_board(std::ostream& os) const
+    char* Chessboard::write_fen_board(char* out) const
     {
         constexpr auto last_rank = Rank::EIGHT;
         constexpr auto last_rank_i = utils::utype(last_rank);
 
-        write_fen_rank(os, last_rank);
+        out = write_fen_rank(out, last_rank);
 
         for (int rank_i = last_rank_i - 1; rank_i >= 0; rank_i--)
-            write_fen_rank(os << '/', static_cast<Rank>(rank_i));
+        {
+            *out++ = '/';
+            out = write_fen_rank(out, static_cast<Rank>(rank_i));
+        }
 
-        return os;
+        return out;
     }
 
     std::string Chessboard::to_fen_string(void) const
     {
-        std::stringstream ss;
+        fen_buffer_t buffer;
 
-        write_fen_board(ss);
+        return std::string(buffer.data(), write_fen_board(buffer.data()));
+    }
+
+    std::string_view Chessboard::write_fen(fen_buffer_t& buffer) const
+    {
+        char* out = write_fen_board(buffer.data());
 
-        return ss.str();
+        *out++ = ' ';
+        *out++ = white_turn_ ? 'w' : 'b';
+
+        *out++ = ' ';
+        const char* const castling = out;
+        if (white_king_castling_)
+            *out++ = 'K';
+        if (white_queen_castling_)
+            *out++ = 'Q';
+        if (black_king_castling_)
+            *out++ = 'k';
+        if (black_queen_castling_)
+            *out++ = 'q';
+        if (out == castling)
+            *out++ = '-';
+
+        *out++ = ' ';
+        if (en_passant_.has_value())
+        {
+            *out++ = 'a' + utils::utype(en_passant_->get_file());
+            *out++ = '1' + utils::utype(en_passant_->get_rank());
+        }
+        else
+            *out++ = '-';
+
+        // Bounded by the digits of a clock rather than by the end of the
+        // buffer, so that the compiler sees the writes stay in it
+        *out++ = ' ';
+        out = std::to_chars(out, out + max_clock_size,
+                            halfmove_clock_).ptr;
+        *out++ = ' ';
+        out = std::to_chars(out, out + max_clock_size,
+                            get_fullmove_number()).ptr;
+
+        return std::string_view(buffer.data(), out - buffer.data());
     }
 
     void Chessboard::register_state()
@@ -172,6 +358,7 @@ namespace board
 
     std::vector<Move> Chessboard::generate_legal_moves(void)
     {
+        TRACE_SCOPE("generate_legal_moves");
         std::vector<Move> legal_moves;
 
         const std::vector<Move> possible_moves =
@@ -217,15 +404,14 @@ namespace board
     {
         if (move.get_capture() || move.get_piece() == PieceType::PAWN)
         {
-            last_fifty_turn_ = 0;
+            halfmove_clock_ = 0;
             // If a piece is captured (ie if there will never be again as much
             // pieces as before on the board) or if a pawn is moved,
             // we know that no precedent board state will ever appear again
             states_history_.clear();
         }
         else
-            if (!white_turn_)
-                last_fifty_turn_++;
+            halfmove_clock_++;
     }
 
     void Chessboard::eat_en_passant(const Move& move, const Color color)
@@ -341,6 +527,7 @@ namespace board
 
     void Chessboard::do_move(const Move& move)
     {
+        TRACE_SCOPE("do_move");
         const Position& start = move.get_start();
         const Position& end = move.get_end();
         const Color color = get_playing_color();
@@ -545,13 +732,13 @@ namespace board
 
     bool Chessboard::is_draw(void)
     {
-        return last_fifty_turn_ >= 50 || is_pat() || threefold_repetition();
+        return halfmove_clock_ >= 100 || is_pat() || threefold_repetition();
     }
 
     bool Chessboard::is_draw(const std::vector<board::Move>& legal_moves,
                              const bool is_check)
     {
-        return last_fifty_turn_ >= 50 || is_pat(legal_moves, is_check)
+        return halfmove_clock_ >= 100 || is_pat(legal_moves, is_check)
                 || threefold_repetition();
     }
 
@@ -580,6 +767,16 @@ namespace board
         white_turn_ = state;
     }
 
+    unsigned Chessboard::get_halfmove_clock(void) const
+    {
+        return halfmove_clock_;
+    }
+
+    unsigned Chessboard::get_fullmove_number(void) const
+    {
+        return turn_ + 1;
+    }
+
     Chessboard::opt_pos_t Chessboard::get_en_passant(void) const
     {
         return en_passant_;
@@ -630,7 +827,7 @@ namespace board
             && white_turn_ == rhs.white_turn_
             && en_passant_ == rhs.en_passant_
             && turn_ == rhs.turn_
-            && last_fifty_turn_ == rhs.last_fifty_turn_;
+            && halfmove_clock_ == rhs.halfmove_clock_;
     }
 
     std::ostream& operator<<(std::ostream& os, const Chessboard& board)
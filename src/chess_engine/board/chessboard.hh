@@ -6,6 +6,7 @@
 #include <vector>
 #include <optional>
 #include <algorithm>
+#include <string_view>
 #include <unordered_map>
 
 #include "board.hh"
@@ -28,6 +29,13 @@ namespace board
     public:
         constexpr static size_t width = 8;
 
+        // Longest FEN: a full board, all the castling rights, an en passant
+        // square and two 10 digit clocks
+        constexpr static size_t max_clock_size = 10;
+        constexpr static size_t max_fen_size = 71 + 2 + 5 + 3
+                                               + 2 * (1 + max_clock_size);
+        using fen_buffer_t = std::array<char, max_fen_size>;
+
         using side_piece_t = std::pair<PieceType, Color>;
         using opt_piece_t = std::optional<side_piece_t>;
         using opt_pos_t = std::optional<Position>;
@@ -38,10 +46,21 @@ namespace board
         Chessboard(const PerftObject& perft);
         Chessboard(const std::string& fen_string);
 
+        /*
+        ** Parse a FEN in a single pass, straight into the bitboards. The
+        ** clocks are optional, eg: "8/8/8/8/8/8/8/K1k5 w - -" starts with
+        ** an halfmove clock of 0 and a fullmove number of 1. Throws a
+        ** std::invalid_argument if the FEN is malformed.
+        */
+        static Chessboard from_fen(std::string_view fen);
+
         static char sidepiece_to_char(const side_piece_t& sidepiece);
         static char sidepiece_to_char(const PieceType& piece,
                                       const Color& color);
+        // Piece placement only, eg: "8/8/8/8/8/8/8/K1k5"
         std::string to_fen_string(void) const;
+        // Complete FEN, written in the buffer without any allocation
+        std::string_view write_fen(fen_buffer_t& buffer) const;
 
         bool pos_threatened(const Position& pos) const;
         std::vector<Move> generate_legal_moves(void);
@@ -67,6 +86,8 @@ namespace board
         const Board& get_board(void) const;
         opt_pos_t get_en_passant() const;
         bool get_white_turn() const;
+        unsigned get_halfmove_clock() const;
+        unsigned get_fullmove_number() const;
         void set_white_turn(bool state);
         bool get_king_castling(const Color& color) const;
         bool get_queen_castling(const Color& color) const;
@@ -79,6 +100,9 @@ namespace board
                                         const Chessboard& board);
 
     private:
+        struct EmptyTag {};
+        explicit Chessboard(EmptyTag);
+
         Board board_;
 
         // used by threefold_repetition
@@ -90,11 +114,13 @@ namespace board
         bool black_king_castling_;
         bool black_queen_castling_;
         opt_pos_t en_passant_;
+        // Number of moves played by black
         unsigned turn_;
-        unsigned last_fifty_turn_;
+        // Halfmoves since the last capture or pawn move
+        unsigned halfmove_clock_;
 
-        std::ostream& write_fen_rank(std::ostream& os, const Rank rank) const;
-        std::ostream& write_fen_board(std::ostream& os) const;
+        char* write_fen_rank(char* out, const Rank rank) const;
+        char* write_fen_board(char* out) const;
         void register_state();
         void init_end_ranks(const PieceType piecetype, const File file);
         void symetric_init_end_ranks(const PieceType piecetype,
@@ -0,0 +1,190 @@
+#include "book-builder.hh"
+
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <optional>
+#include <iostream>
+#include <algorithm>
+
+#include "polyglot.hh"
+#include "parsing/pgn_parser/pgn-database.hh"
+#include "parsing/pgn_parser/pgn-exception.hh"
+
+using namespace board;
+
+namespace book
+{
+    namespace
+    {
+        constexpr uint64_t max_weight = 0xffff;
+
+        struct BookEntry
+        {
+            uint64_t key;
+            uint16_t move;
+            uint64_t weight;
+        };
+
+        void write_be(std::ostream& os, const uint64_t value,
+                      const size_t bytes)
+        {
+            for (size_t i = bytes; i-- > 0;)
+                os.put(static_cast<char>(value >> (8 * i)));
+        }
+    } // namespace
+
+    BookBuilder::BookBuilder(const BuilderOptions& options)
+        : options_(options)
+    {}
+
+    bool BookBuilder::add_game(const pgn_parser::PgnGame& game)
+    {
+        using pgn_parser::GameResult;
+        if (game.result == GameResult::UNKNOWN || game.moves.empty())
+            return true;
+
+        Chessboard board;
+        Move move = game.moves[0].to_Move();
+        const size_t plies = std::min<size_t>(options_.plies,
+                                              game.moves.size());
+        for (size_t i = 0; i < plies; ++i)
+        {
+            if (i > 0)
+                game.moves[i].to_Move(move);
+            if (!board.is_move_legal(move))
+                return false;
+
+            const EntryKey entry{polyglot_key(board), polyglot_move(move)};
+            const bool white = board.get_white_turn();
+            Shard& shard = shards_[entry.key % nb_shards];
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                Stats& stats = shard.entries[entry];
+                if (game.result == GameResult::DRAW)
+                    stats.draws++;
+                else if ((game.result == GameResult::WHITE_WIN) == white)
+                    stats.wins++;
+                else
+                    stats.losses++;
+            }
+
+            board.do_move(move);
+        }
+        return true;
+    }
+
+    size_t BookBuilder::size(void) const
+    {
+        size_t count = 0;
+        for (const auto& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.entries.size();
+        }
+        return count;
+    }
+
+    size_t BookBuilder::write(const std::string& path) const
+    {
+        std::vector<BookEntry> entries;
+        for (const auto& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [entry, stats] : shard.entries)
+            {
+                const uint64_t games = static_cast<uint64_t>(stats.wins)
+                                       + stats.draws + stats.losses;
+                const uint64_t weight = 2 * static_cast<uint64_t>(stats.wins)
+                                        + stats.draws;
+                if (games >= options_.min_games && weight > 0)
+                    entries.push_back(BookEntry{entry.key, entry.move,
+                                                weight});
+            }
+        }
+
+        // Sorted by key as required by the binary search, best moves first
+        std::sort(entries.begin(), entries.end(),
+                  [](const BookEntry& a, const BookEntry& b)
+                  {
+                      if (a.key != b.key)
+                          return a.key < b.key;
+                      if (a.weight != b.weight)
+                          return a.weight > b.weight;
+                      return a.move < b.move;
+                  });
+
+        std::ofstream file(path, std::ios::binary);
+        for (size_t begin = 0; begin < entries.size();)
+        {
+            // Weights are scaled down per position to fit on 16 bits, the
+            // first entry of a position holds the highest one
+            const uint64_t highest = entries[begin].weight;
+            size_t end = begin;
+            for (; end < entries.size()
+                   && entries[end].key == entries[begin].key; ++end)
+            {
+                uint64_t weight = entries[end].weight;
+                if (highest > max_weight)
+                    weight = std::max<uint64_t>(1, weight * max_weight
+                                                   / highest);
+
+                write_be(file, entries[end].key, 8);
+                write_be(file, entries[end].move, 2);
+                write_be(file, weight, 2);
+                write_be(file, 0, 4); // Learn
+            }
+            begin = end;
+        }
+
+        return file ? entries.size() : 0;
+    }
+
+    size_t build_book(const std::vector<std::string>& paths,
+                      const std::string& output,
+                      const BuilderOptions& options)
+    {
+        pgn_parser::PgnDatabase database(paths);
+        BookBuilder builder(options);
+
+        std::atomic<size_t> games = 0;
+        std::atomic<size_t> rejected = 0;
+        const auto worker = [&]()
+        {
+            pgn_parser::DatabaseGame game;
+            while (database.next(game))
+            {
+                std::optional<std::string> error = game.error;
+                try
+                {
+                    if (!error.has_value()
+                        && builder.add_game(pgn_parser::parse_game(game.view)))
+                        games++;
+                    else
+                        rejected++;
+                }
+                catch (const pgn_parser::PgnParsingException& parse_error)
+                {
+                    error = parse_error.what();
+                    rejected++;
+                }
+
+                if (error.has_value())
+                    std::cerr << database.get_file(game.file) << ": "
+                              << error.value() << '\n';
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::max(1u, options.threads); ++t)
+            workers.emplace_back(worker);
+        for (auto& thread : workers)
+            thread.join();
+
+        const size_t entries = builder.write(output);
+        std::cout << games << " games read, " << rejected << " rejected, "
+                  << entries << " entries written to " << output
+                  << std::endl;
+        return entries;
+    }
+} // namespace book
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "parsing/pgn_parser/pgn-parser.hh"
+
+// Polyglot book generation from PGN games
+//
+// Every game is replayed up to a number of plies. For each position reached,
+// the move played and the result of the game are counted. The counts live
+// in a hash map split in shards, each one with its own lock, so that the
+// games can be replayed by several threads at once. The book weight of a
+// move is 2 * wins + draws, from the point of view of the side playing it.
+namespace book
+{
+    struct BuilderOptions
+    {
+        // Moves after this ply are not added to the book
+        unsigned plies = 16;
+        unsigned threads = 1;
+        // Moves played in fewer games are dropped
+        uint32_t min_games = 1;
+    };
+
+    class BookBuilder
+    {
+    public:
+        explicit BookBuilder(const BuilderOptions& options);
+
+        // Replay the game and count its moves, thread safe
+        // Games without a result are ignored
+        // False if a move is illegal, the moves before it are counted
+        bool add_game(const pgn_parser::PgnGame& game);
+
+        // Number of distinct (position, move) pairs
+        size_t size(void) const;
+
+        // Sorted Polyglot entries, return the number of entries written
+        size_t write(const std::string& path) const;
+
+    private:
+        struct Stats
+        {
+            uint32_t wins = 0;
+            uint32_t draws = 0;
+            uint32_t losses = 0;
+        };
+
+        // Polyglot key of the position and encoded move
+        struct EntryKey
+        {
+            uint64_t key;
+            uint16_t move;
+
+            bool operator==(const EntryKey& other) const
+            {
+                return key == other.key && move == other.move;
+            }
+        };
+
+        struct EntryHash
+        {
+            size_t operator()(const EntryKey& entry) const
+            {
+                return entry.key ^ (static_cast<uint64_t>(entry.move) << 48);
+            }
+        };
+
+        static constexpr size_t nb_shards = 64;
+
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<EntryKey, Stats, EntryHash> entries;
+        };
+
+        BuilderOptions options_;
+        std::array<Shard, nb_shards> shards_;
+    };
+
+    // Stream every game of the PGN files of the paths through a builder
+    // on options.threads threads and write the book to output
+    // Return the number of entries written
+    size_t build_book(const std::vector<std::string>& paths,
+                      const std::string& output,
+                      const BuilderOptions& options);
+} // namespace book
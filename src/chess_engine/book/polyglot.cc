@@ -0,0 +1,210 @@
+#include "polyglot.hh"
+
+#include <algorithm>
+
+#include "polyglot-random.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace book
+{
+    std::unique_ptr<Book> Book::instance_ = nullptr;
+
+    namespace
+    {
+        constexpr size_t entry_size = 16;
+
+        uint64_t read_be(const uint8_t* data, const size_t bytes)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i)
+                value = value << 8 | data[i];
+            return value;
+        }
+
+        uint64_t entry_key(const uint8_t* entry)
+        {
+            return read_be(entry, 8);
+        }
+
+        // Pawn, knight, bishop, rook, queen, king
+        int polyglot_piece(const PieceType piece)
+        {
+            static constexpr std::array<int, nb_pieces> kinds = {
+                4, 3, 2, 1, 0, 5 // QUEEN, ROOK, BISHOP, KNIGHT, PAWN, KING
+            };
+            return kinds[utils::utype(piece)];
+        }
+
+        int promotion_code(const opt_piecetype_t& promotion)
+        {
+            if (!promotion.has_value())
+                return 0;
+            switch (promotion.value())
+            {
+            case PieceType::KNIGHT:
+                return 1;
+            case PieceType::BISHOP:
+                return 2;
+            case PieceType::ROOK:
+                return 3;
+            default:
+                return 4;
+            }
+        }
+
+        // The en passant file only counts when a pawn can take
+        bool en_passant_capture(const Chessboard& board)
+        {
+            const auto target = board.get_en_passant();
+            if (!target.has_value())
+                return false;
+
+            const Color color = board.get_playing_color();
+            const int square = target->get_index();
+            const int pawn_rank = color == Color::WHITE ? 4 : 3;
+            const uint64_t pawns = board.get_board()(PieceType::PAWN, color);
+            for (const int side : {-1, 1})
+            {
+                const int file = square % 8 + side;
+                if (file >= 0 && file < 8
+                    && utils::is_bit_set(pawns, pawn_rank * 8 + file))
+                    return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    uint64_t polyglot_key(const Chessboard& board)
+    {
+        const Board& b = board.get_board();
+        uint64_t key = 0;
+
+        for (const auto piece : piecetype_array)
+            for (const auto color : {Color::BLACK, Color::WHITE})
+            {
+                const size_t kind = polyglot_piece(piece) * 2
+                                    + (color == Color::WHITE ? 1 : 0);
+                uint64_t pieces = b(piece, color);
+                for (int square = utils::pop_lsb(pieces); square >= 0;
+                     square = utils::pop_lsb(pieces))
+                    key ^= random64[random_piece + 64 * kind + square];
+            }
+
+        if (board.get_king_castling(Color::WHITE))
+            key ^= random64[random_castle + 0];
+        if (board.get_queen_castling(Color::WHITE))
+            key ^= random64[random_castle + 1];
+        if (board.get_king_castling(Color::BLACK))
+            key ^= random64[random_castle + 2];
+        if (board.get_queen_castling(Color::BLACK))
+            key ^= random64[random_castle + 3];
+
+        if (en_passant_capture(board))
+            key ^= random64[random_en_passant
+                            + board.get_en_passant()->get_index() % 8];
+
+        if (board.get_white_turn())
+            key ^= random64[random_turn];
+
+        return key;
+    }
+
+    uint16_t polyglot_move(const Move& move)
+    {
+        const int from = move.get_start().get_index();
+        int to = move.get_end().get_index();
+        if (move.get_king_castling())
+            to = from + 3;
+        else if (move.get_queen_castling())
+            to = from - 4;
+
+        return static_cast<uint16_t>(promotion_code(move.get_promotion()) << 12
+                                     | from << 6 | to);
+    }
+
+    bool Book::load(const std::string& path)
+    {
+        auto book = std::make_unique<Book>();
+        if (!book->file_.open(path) || book->file_.size() % entry_size)
+            return false;
+
+        instance_ = std::move(book);
+        return true;
+    }
+
+    void Book::unload(void)
+    {
+        instance_.reset();
+    }
+
+    Book* Book::get(void)
+    {
+        return instance_.get();
+    }
+
+    size_t Book::size(void) const
+    {
+        return file_.size() / entry_size;
+    }
+
+    std::vector<BookMove> Book::lookup(const Chessboard& board) const
+    {
+        const uint64_t key = polyglot_key(board);
+
+        // Binary search of the first entry of the key
+        size_t low = 0;
+        size_t high = size();
+        while (low < high)
+        {
+            const size_t middle = low + (high - low) / 2;
+            if (entry_key(file_.data() + middle * entry_size) < key)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        std::vector<BookMove> moves;
+        Chessboard position = board;
+        const auto legal_moves = position.generate_legal_moves();
+        for (size_t i = low; i < size(); ++i)
+        {
+            const uint8_t* entry = file_.data() + i * entry_size;
+            if (entry_key(entry) != key)
+                break;
+
+            const auto move = read_be(entry + 8, 2);
+            const auto weight = read_be(entry + 10, 2);
+            const auto legal = std::find_if(legal_moves.begin(),
+                                            legal_moves.end(),
+                [move](const Move& m) { return polyglot_move(m) == move; });
+            if (legal != legal_moves.end())
+                moves.push_back(BookMove{*legal,
+                                         static_cast<uint16_t>(weight)});
+        }
+
+        return moves;
+    }
+
+    std::optional<Move> Book::probe(const Chessboard& board)
+    {
+        const auto moves = lookup(board);
+
+        uint32_t total = 0;
+        for (const auto& book_move : moves)
+            total += book_move.weight;
+        if (total == 0)
+            return std::nullopt;
+
+        uint32_t pick = std::uniform_int_distribution<uint32_t>(
+                0, total - 1)(random_);
+        for (const auto& book_move : moves)
+        {
+            if (pick < book_move.weight)
+                return book_move.move;
+            pick -= book_move.weight;
+        }
+        return std::nullopt;
+    }
+} // namespace book
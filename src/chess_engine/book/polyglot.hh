@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "chess_engine/board/chessboard.hh"
+#include "utils/mapped-file.hh"
+
+// Polyglot opening books (.bin)
+//
+// A book is a sorted array of 16 bytes big endian entries:
+// - uint64 key: Polyglot hash of the position
+// - uint16 move: to file (3 bits), to rank, from file, from rank, promotion
+// - uint16 weight: relative probability of the move
+// - uint32 learn: unused
+// The file is memory mapped and searched in place by key.
+namespace book
+{
+    // Polyglot hash of the board, as specified by the format
+    uint64_t polyglot_key(const board::Chessboard& board);
+
+    // Polyglot encoding of the move, castling as the king taking its rook
+    uint16_t polyglot_move(const board::Move& move);
+
+    struct BookMove
+    {
+        board::Move move;
+        uint16_t weight;
+    };
+
+    class Book
+    {
+    public:
+        // Map a book file, and make it the active one on success
+        static bool load(const std::string& path);
+        // No book anymore
+        static void unload(void);
+        // Returns the active book, nullptr when none is loaded
+        static Book* get(void);
+
+        // Legal moves of the book for the board
+        std::vector<BookMove> lookup(const board::Chessboard& board) const;
+
+        // A move of the book chosen with a probability proportional to its
+        // weight, nullopt when the board is not in the book
+        std::optional<board::Move> probe(const board::Chessboard& board);
+
+        size_t size(void) const;
+
+    private:
+        static std::unique_ptr<Book> instance_;
+
+        utils::MappedFile file_;
+        std::mt19937 random_{std::random_device{}()};
+    };
+} // namespace book
@@ -0,0 +1,132 @@
+#include "accumulator.hh"
+
+#include <cstring>
+
+#include "simd.hh"
+#include "chess_engine/board/board.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace nnue
+{
+    void Accumulator::refresh(const Board& board, const Color perspective)
+    {
+        const Network* network = Network::get();
+        const auto perspective_i = utils::utype(perspective);
+        int16_t* values = values_[perspective_i];
+
+        std::memcpy(values, network->feature_biases(),
+                    sizeof(int16_t) * half_dimensions);
+
+        const int king_square =
+                utils::bit_scan_lowest(board(PieceType::KING, perspective));
+        if (king_square < 0)
+        {
+            computed_[perspective_i] = false;
+            return;
+        }
+
+        for (const auto color : {Color::WHITE, Color::BLACK})
+        {
+            for (const auto piece : piecetype_array_without_king)
+            {
+                uint64_t pieces = board(piece, color);
+                int square = utils::pop_lsb(pieces);
+                while (square >= 0)
+                {
+                    const auto index = feature_index(perspective, king_square,
+                                                     piece, color, square);
+                    simd::add_column<half_dimensions>(
+                            values, network->feature_column(index));
+                    square = utils::pop_lsb(pieces);
+                }
+            }
+        }
+
+        computed_[perspective_i] = true;
+        generation_[perspective_i] = Network::generation();
+    }
+
+    void Accumulator::update(const Accumulator& parent,
+                             const Board& parent_board,
+                             const Board& board)
+    {
+        const Network* network = Network::get();
+
+        for (const auto perspective : {Color::WHITE, Color::BLACK})
+        {
+            const auto perspective_i = utils::utype(perspective);
+            const uint64_t king = board(PieceType::KING, perspective);
+
+            // Every feature of the perspective depends on the king square
+            if (!parent.is_computed(perspective) || king == 0
+                || king != parent_board(PieceType::KING, perspective))
+            {
+                refresh(board, perspective);
+                continue;
+            }
+
+            const int king_square = utils::bit_scan_lowest(king);
+            int16_t* values = values_[perspective_i];
+            std::memcpy(values, parent.values_[perspective_i],
+                        sizeof(int16_t) * half_dimensions);
+
+            for (const auto color : {Color::WHITE, Color::BLACK})
+            {
+                for (const auto piece : piecetype_array_without_king)
+                {
+                    const uint64_t before = parent_board(piece, color);
+                    const uint64_t after = board(piece, color);
+
+                    uint64_t removed = before & ~after;
+                    int square = utils::pop_lsb(removed);
+                    while (square >= 0)
+                    {
+                        const auto index = feature_index(perspective,
+                                king_square, piece, color, square);
+                        simd::sub_column<half_dimensions>(
+                                values, network->feature_column(index));
+                        square = utils::pop_lsb(removed);
+                    }
+
+                    uint64_t added = after & ~before;
+                    square = utils::pop_lsb(added);
+                    while (square >= 0)
+                    {
+                        const auto index = feature_index(perspective,
+                                king_square, piece, color, square);
+                        simd::add_column<half_dimensions>(
+                                values, network->feature_column(index));
+                        square = utils::pop_lsb(added);
+                    }
+                }
+            }
+
+            computed_[perspective_i] = true;
+            generation_[perspective_i] = Network::generation();
+        }
+    }
+
+    Accumulator& AccumulatorStack::get(const int ply)
+    {
+        const auto computed = [](const Accumulator& accumulator)
+        {
+            return accumulator.is_computed(Color::WHITE)
+                   && accumulator.is_computed(Color::BLACK);
+        };
+
+        int first = ply;
+        while (first > 0 && !computed(accumulators_[first]))
+            first--;
+
+        if (!computed(accumulators_[first]))
+            for (const auto perspective : {Color::WHITE, Color::BLACK})
+                accumulators_[first].refresh(*boards_[first], perspective);
+
+        for (int i = first + 1; i <= ply; ++i)
+            accumulators_[i].update(accumulators_[i - 1], *boards_[i - 1],
+                                    *boards_[i]);
+        return accumulators_[ply];
+    }
+} // namespace nnue
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "network.hh"
+#include "chess_engine/board/entity/color.hh"
+#include "chess_engine/board/entity/piece-type.hh"
+
+namespace board
+{
+    class Board;
+}
+
+namespace nnue
+{
+    /*
+    ** First layer output of the network, for both perspectives.
+    **
+    ** It is updated incrementally from the accumulator of the parent
+    ** position, by the pieces which differ between both boards. Moving a
+    ** king changes every feature of its perspective, which is then
+    ** refreshed from scratch. A perspective computed with another network
+    ** than the active one is not computed anymore.
+    */
+    class Accumulator
+    {
+    public:
+        Accumulator() = default;
+
+        // Recompute a perspective from scratch
+        void refresh(const board::Board& board,
+                     const board::Color perspective);
+        // Compute both perspectives of board from the ones of parent,
+        // the accumulator of parent_board
+        void update(const Accumulator& parent,
+                    const board::Board& parent_board,
+                    const board::Board& board);
+        void invalidate(void);
+
+        bool is_computed(const board::Color perspective) const;
+        const int16_t* get_values(const board::Color perspective) const;
+
+    private:
+        alignas(32) int16_t values_[2][half_dimensions];
+        bool computed_[2] = {false, false};
+        // Of the network the perspectives were computed with
+        uint64_t generation_[2] = {0, 0};
+    };
+
+    /*
+    ** Accumulators of the positions of the current line of a search, one
+    ** per ply. Pushing a position is cheap: its accumulator is only
+    ** computed when the position is evaluated, from the closest computed
+    ** ancestor. The boards are not copied and must outlive their ply.
+    */
+    class AccumulatorStack
+    {
+    public:
+        // The position of the ply, reached by a move from the one of
+        // ply - 1 (the root for ply 0)
+        void push(const int ply, const board::Board& board);
+        Accumulator& get(const int ply);
+
+    private:
+        std::vector<Accumulator> accumulators_;
+        std::vector<const board::Board*> boards_;
+    };
+
+    inline bool Accumulator::is_computed(const board::Color perspective) const
+    {
+        const auto perspective_i = utils::utype(perspective);
+        return computed_[perspective_i]
+               && generation_[perspective_i] == Network::generation();
+    }
+
+    inline const int16_t*
+    Accumulator::get_values(const board::Color perspective) const
+    {
+        return values_[utils::utype(perspective)];
+    }
+
+    inline void Accumulator::invalidate(void)
+    {
+        computed_[0] = false;
+        computed_[1] = false;
+    }
+
+    inline void AccumulatorStack::push(const int ply,
+                                       const board::Board& board)
+    {
+        if (static_cast<size_t>(ply) >= accumulators_.size())
+        {
+            accumulators_.resize(ply + 1);
+            boards_.resize(ply + 1);
+        }
+        accumulators_[ply].invalidate();
+        boards_[ply] = &board;
+    }
+} // namespace nnue
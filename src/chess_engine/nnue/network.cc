@@ -0,0 +1,133 @@
+#include "network.hh"
+
+#include <fstream>
+
+#include "simd.hh"
+#include "accumulator.hh"
+#include "chess_engine/board/board.hh"
+
+namespace nnue
+{
+    std::unique_ptr<Network> Network::instance_ = nullptr;
+    uint64_t Network::generation_ = 0;
+
+    namespace
+    {
+        template <typename T>
+        bool read_values(std::ifstream& file, std::vector<T>& values,
+                         const size_t size)
+        {
+            values.resize(size);
+            file.read(reinterpret_cast<char*>(values.data()),
+                      sizeof(T) * size);
+            return file.good();
+        }
+
+        template <typename T>
+        bool read_value(std::ifstream& file, T& value)
+        {
+            file.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return file.good();
+        }
+
+        // Dense layer followed by a clipped relu
+        template <size_t InputSize, size_t OutputSize>
+        void propagate(const int16_t* input,
+                       const std::vector<int32_t>& biases,
+                       const std::vector<int16_t>& weights,
+                       int16_t* output)
+        {
+            for (size_t i = 0; i < OutputSize; ++i)
+            {
+                const int32_t sum = biases[i]
+                        + simd::dot<InputSize>(input,
+                                               weights.data() + i * InputSize);
+                const int32_t shifted = sum >> weight_shift;
+                output[i] = shifted < 0
+                            ? 0
+                            : (shifted > activation_max
+                                ? activation_max
+                                : shifted);
+            }
+        }
+    } // namespace
+
+    bool Network::load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        uint32_t magic, version, half, l1, l2;
+        if (!read_value(file, magic) || !read_value(file, version)
+            || !read_value(file, half) || !read_value(file, l1)
+            || !read_value(file, l2))
+            return false;
+
+        if (magic != file_magic || version != file_version
+            || half != half_dimensions || l1 != l1_dimensions
+            || l2 != l2_dimensions)
+            return false;
+
+        auto network = std::make_unique<Network>();
+        if (!read_values(file, network->feature_biases_, half_dimensions)
+            || !read_values(file, network->feature_weights_,
+                            input_dimensions * half_dimensions)
+            || !read_values(file, network->l1_biases_, l1_dimensions)
+            || !read_values(file, network->l1_weights_,
+                            l1_dimensions * 2 * half_dimensions)
+            || !read_values(file, network->l2_biases_, l2_dimensions)
+            || !read_values(file, network->l2_weights_,
+                            l2_dimensions * l1_dimensions)
+            || !read_value(file, network->output_bias_)
+            || !read_values(file, network->output_weights_, l2_dimensions))
+            return false;
+
+        // The file should have been entirely consumed
+        if (file.peek() != std::ifstream::traits_type::eof())
+            return false;
+
+        instance_ = std::move(network);
+        generation_++;
+        return true;
+    }
+
+    void Network::unload(void)
+    {
+        instance_.reset();
+        generation_++;
+    }
+
+    int Network::evaluate(const board::Board& board,
+                          const board::Color side_to_move,
+                          Accumulator& accumulator) const
+    {
+        const auto opponent = board::get_opposite_color(side_to_move);
+
+        for (const auto perspective : {side_to_move, opponent})
+            if (!accumulator.is_computed(perspective))
+                accumulator.refresh(board, perspective);
+
+        // The side to move half always comes first
+        alignas(32) int16_t transformed[2 * half_dimensions];
+        simd::clipped_relu<half_dimensions>(
+                transformed, accumulator.get_values(side_to_move),
+                activation_max);
+        simd::clipped_relu<half_dimensions>(
+                transformed + half_dimensions,
+                accumulator.get_values(opponent), activation_max);
+
+        alignas(32) int16_t l1_output[l1_dimensions];
+        propagate<2 * half_dimensions, l1_dimensions>(
+                transformed, l1_biases_, l1_weights_, l1_output);
+
+        alignas(32) int16_t l2_output[l2_dimensions];
+        propagate<l1_dimensions, l2_dimensions>(
+                l1_output, l2_biases_, l2_weights_, l2_output);
+
+        const int32_t output = output_bias_
+                + simd::dot<l2_dimensions>(l2_output, output_weights_.data());
+
+        return output / output_scale;
+    }
+} // namespace nnue
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "chess_engine/board/entity/color.hh"
+#include "chess_engine/board/entity/piece-type.hh"
+
+namespace board
+{
+    class Board;
+}
+
+namespace nnue
+{
+    class Accumulator;
+
+    // HalfKP like input: for each perspective, the (oriented) king square
+    // times every non king piece (own/opponent) on every square
+    constexpr size_t nb_squares = 64;
+    constexpr size_t nb_piece_features = 10 * nb_squares;
+    constexpr size_t input_dimensions = nb_squares * nb_piece_features;
+
+    // Network shape: input -> 2 x half_dimensions -> l1 -> l2 -> 1
+    constexpr size_t half_dimensions = 256;
+    constexpr size_t l1_dimensions = 32;
+    constexpr size_t l2_dimensions = 32;
+
+    // Quantization: activations are clipped in [0, activation_max]
+    // dense weights are scaled by 2^weight_shift
+    // and the output by output_scale (centipawns)
+    constexpr int16_t activation_max = 127;
+    constexpr int weight_shift = 6;
+    constexpr int output_scale = 16;
+
+    constexpr uint32_t file_magic = 0x45554e4e; // "NNUE"
+    constexpr uint32_t file_version = 1;
+
+    // Returns the feature index of a piece seen from a perspective
+    // The board is flipped along the rank axis for the black perspective
+    inline size_t feature_index(const board::Color perspective,
+                                int king_square,
+                                const board::PieceType piece,
+                                const board::Color color,
+                                int square)
+    {
+        if (perspective == board::Color::BLACK)
+        {
+            king_square ^= 56;
+            square ^= 56;
+        }
+        const size_t piece_i = utils::utype(piece) * 2
+                               + (color == perspective ? 0 : 1);
+        return king_square * nb_piece_features + piece_i * nb_squares + square;
+    }
+
+    /*
+    ** Quantized weights of the network.
+    **
+    ** File format (little endian):
+    ** - uint32 magic, uint32 version
+    ** - uint32 half_dimensions, uint32 l1_dimensions, uint32 l2_dimensions
+    ** - int16 feature_biases[half], int16 feature_weights[input][half]
+    ** - int32 l1_biases[l1], int16 l1_weights[l1][2 * half]
+    ** - int32 l2_biases[l2], int16 l2_weights[l2][l1]
+    ** - int32 output_bias, int16 output_weights[l2]
+    */
+    class Network
+    {
+    public:
+        // Load a network file, and make it the active one on success
+        static bool load(const std::string& path);
+        // Back to the classic evaluation
+        static void unload(void);
+        // Returns the active network, nullptr when none is loaded
+        static const Network* get(void);
+        // Changes whenever the active network does, the accumulators
+        // computed with another network are stale
+        static uint64_t generation(void);
+
+        // Evaluate the board from the point of view of the side to move,
+        // accumulator being the one of the board
+        int evaluate(const board::Board& board,
+                     const board::Color side_to_move,
+                     Accumulator& accumulator) const;
+
+        const int16_t* feature_column(const size_t index) const;
+        const int16_t* feature_biases(void) const;
+
+    private:
+        static std::unique_ptr<Network> instance_;
+        static uint64_t generation_;
+
+        std::vector<int16_t> feature_biases_;
+        std::vector<int16_t> feature_weights_;
+        std::vector<int32_t> l1_biases_;
+        std::vector<int16_t> l1_weights_;
+        std::vector<int32_t> l2_biases_;
+        std::vector<int16_t> l2_weights_;
+        int32_t output_bias_;
+        std::vector<int16_t> output_weights_;
+    };
+
+    inline const int16_t* Network::feature_column(const size_t index) const
+    {
+        return feature_weights_.data() + index * half_dimensions;
+    }
+
+    inline const int16_t* Network::feature_biases(void) const
+    {
+        return feature_biases_.data();
+    }
+
+    inline const Network* Network::get(void)
+    {
+        return instance_.get();
+    }
+
+    inline uint64_t Network::generation(void)
+    {
+        return generation_;
+    }
+} // namespace nnue
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+// int16 kernels used by the NNUE evaluator
+// The widest instruction set enabled at compile time is picked
+// (-march=native in Release), scalar code is the fallback
+// Sizes are compile time constants, multiple of a whole AVX2 register
+namespace nnue::simd
+{
+    constexpr size_t register_width = 16;
+
+    // acc[i] += column[i]
+    template <size_t Size>
+    inline void add_column(int16_t* acc, const int16_t* column)
+    {
+        static_assert(Size % register_width == 0);
+
+#if defined(__AVX2__)
+        for (size_t i = 0; i < Size; i += 16)
+        {
+            auto a = _mm256_loadu_si256(reinterpret_cast<__m256i*>(acc + i));
+            const auto c = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(column + i));
+            a = _mm256_add_epi16(a, c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), a);
+        }
+#elif defined(__SSE4_1__)
+        for (size_t i = 0; i < Size; i += 8)
+        {
+            auto a = _mm_loadu_si128(reinterpret_cast<__m128i*>(acc + i));
+            const auto c = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(column + i));
+            a = _mm_add_epi16(a, c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+        }
+#else
+        for (size_t i = 0; i < Size; ++i)
+            acc[i] += column[i];
+#endif
+    }
+
+    // acc[i] -= column[i]
+    template <size_t Size>
+    inline void sub_column(int16_t* acc, const int16_t* column)
+    {
+        static_assert(Size % register_width == 0);
+
+#if defined(__AVX2__)
+        for (size_t i = 0; i < Size; i += 16)
+        {
+            auto a = _mm256_loadu_si256(reinterpret_cast<__m256i*>(acc + i));
+            const auto c = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(column + i));
+            a = _mm256_sub_epi16(a, c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), a);
+        }
+#elif defined(__SSE4_1__)
+        for (size_t i = 0; i < Size; i += 8)
+        {
+            auto a = _mm_loadu_si128(reinterpret_cast<__m128i*>(acc + i));
+            const auto c = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(column + i));
+            a = _mm_sub_epi16(a, c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+        }
+#else
+        for (size_t i = 0; i < Size; ++i)
+            acc[i] -= column[i];
+#endif
+    }
+
+    // out[i] = min(max(in[i], 0), max)
+    template <size_t Size>
+    inline void clipped_relu(int16_t* out, const int16_t* in,
+                             const int16_t max)
+    {
+        static_assert(Size % register_width == 0);
+
+#if defined(__AVX2__)
+        const auto zero = _mm256_setzero_si256();
+        const auto top = _mm256_set1_epi16(max);
+        for (size_t i = 0; i < Size; i += 16)
+        {
+            auto v = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(in + i));
+            v = _mm256_min_epi16(_mm256_max_epi16(v, zero), top);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        }
+#elif defined(__SSE4_1__)
+        const auto zero = _mm_setzero_si128();
+        const auto top = _mm_set1_epi16(max);
+        for (size_t i = 0; i < Size; i += 8)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            v = _mm_min_epi16(_mm_max_epi16(v, zero), top);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        }
+#else
+        for (size_t i = 0; i < Size; ++i)
+            out[i] = in[i] < 0 ? 0 : (in[i] > max ? max : in[i]);
+#endif
+    }
+
+    // Returns sum(a[i] * b[i]) accumulated on 32 bits
+    template <size_t Size>
+    inline int32_t dot(const int16_t* a, const int16_t* b)
+    {
+        static_assert(Size % register_width == 0);
+
+        int32_t result = 0;
+#if defined(__AVX2__)
+        auto sum = _mm256_setzero_si256();
+        for (size_t i = 0; i < Size; i += 16)
+        {
+            const auto va = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(a + i));
+            const auto vb = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(b + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(va, vb));
+        }
+        auto sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                    _mm256_extracti128_si256(sum, 1));
+        sum128 = _mm_hadd_epi32(sum128, sum128);
+        sum128 = _mm_hadd_epi32(sum128, sum128);
+        result = _mm_cvtsi128_si32(sum128);
+#elif defined(__SSE4_1__)
+        auto sum = _mm_setzero_si128();
+        for (size_t i = 0; i < Size; i += 8)
+        {
+            const auto va = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(a + i));
+            const auto vb = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(b + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(va, vb));
+        }
+        sum = _mm_hadd_epi32(sum, sum);
+        sum = _mm_hadd_epi32(sum, sum);
+        result = _mm_cvtsi128_si32(sum);
+#else
+        for (size_t i = 0; i < Size; ++i)
+            result += static_cast<int32_t>(a[i]) * b[i];
+#endif
+        return result;
+    }
+} // namespace nnue::simd
@@ -0,0 +1,768 @@
+#include "table.hh"
+
+#include <algorithm>
+#include <iostream>
+
+#include "chess_engine/ai/endgame.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace syzygy
+{
+    namespace
+    {
+        constexpr uint32_t wdl_magic = 0x5d23e871;
+        constexpr uint32_t dtz_magic = 0xa50c66d7;
+
+        // Flags of the PairsData
+        enum Flag : uint8_t
+        {
+            STM = 1,
+            MAPPED = 2,
+            WIN_PLIES = 4,
+            LOSS_PLIES = 8,
+            WIDE = 16,
+            SINGLE_VALUE = 128
+        };
+
+        // Color bit of the piece codes of the files
+        constexpr int black_code = 8;
+
+        uint16_t read_le16(const uint8_t* data)
+        {
+            return data[0] | data[1] << 8;
+        }
+
+        uint32_t read_le32(const uint8_t* data)
+        {
+            return read_le16(data) | uint32_t{read_le16(data + 2)} << 16;
+        }
+
+        uint32_t read_be32(const uint8_t* data)
+        {
+            return uint32_t{data[0]} << 24 | data[1] << 16 | data[2] << 8
+                   | data[3];
+        }
+
+        uint64_t read_be64(const uint8_t* data)
+        {
+            return uint64_t{read_be32(data)} << 32 | read_be32(data + 4);
+        }
+
+        // Children of a symbol of the recursive pairing, 12 bits each
+        int btree_left(const uint8_t* btree, const int sym)
+        {
+            const uint8_t* lr = btree + 3 * sym;
+            return (lr[1] & 0xf) << 8 | lr[0];
+        }
+
+        int btree_right(const uint8_t* btree, const int sym)
+        {
+            const uint8_t* lr = btree + 3 * sym;
+            return lr[2] << 4 | lr[1] >> 4;
+        }
+
+        const uint8_t* align(const uint8_t* data, const uintptr_t alignment)
+        {
+            const auto address = reinterpret_cast<uintptr_t>(data);
+            return data + ((alignment - address % alignment) % alignment);
+        }
+
+        constexpr int file_of(const int square)
+        {
+            return square % 8;
+        }
+
+        constexpr int rank_of(const int square)
+        {
+            return square / 8;
+        }
+
+        // Negative below the a1-h8 diagonal, positive above
+        constexpr int off_diagonal(const int square)
+        {
+            return rank_of(square) - file_of(square);
+        }
+
+        constexpr int edge_distance(const int file)
+        {
+            return std::min(file, 7 - file);
+        }
+
+        constexpr int flip_file(const int square)
+        {
+            return square ^ 7;
+        }
+
+        // Constant tables of the position indexing
+        struct Indexing
+        {
+            // Binomial coefficients: ways to choose k among n squares
+            std::array<std::array<uint64_t, 64>, max_pieces> binomial{};
+            // a1-d1-d4 triangle to 0..9, the diagonal last
+            std::array<int, 64> a1_d1_d4{};
+            // Squares below the a1-h8 diagonal to 0..27
+            std::array<int, 64> b1_h1_h7{};
+            // 462 legal king pairs, the first one in the a1-d1-d4 triangle
+            std::array<std::array<int, 64>, 10> king_pairs{};
+            // Pawn squares to 0..47, the leading pawn has the greatest value
+            std::array<int, 64> pawns{};
+            std::array<std::array<int, 64>, max_pieces> lead_pawns_index{};
+            std::array<std::array<int, 4>, max_pieces> lead_pawns_size{};
+        };
+
+        constexpr Indexing generate_indexing()
+        {
+            Indexing t{};
+
+            int code = 0;
+            for (int s = 0; s < 64; ++s)
+                if (off_diagonal(s) < 0)
+                    t.b1_h1_h7[s] = code++;
+
+            code = 0;
+            for (int s = 0; s < 64; ++s)
+                if (off_diagonal(s) < 0 && file_of(s) <= 3 && rank_of(s) <= 3)
+                    t.a1_d1_d4[s] = code++;
+            for (int s = 0; s < 64; ++s)
+                if (!off_diagonal(s) && file_of(s) <= 3)
+                    t.a1_d1_d4[s] = code++;
+
+            // Pairs with both kings on the diagonal come last
+            code = 0;
+            for (int last = 0; last < 2; ++last)
+                for (int i = 0; i < 10; ++i)
+                    for (int s1 = 0; s1 < 64; ++s1)
+                    {
+                        if (file_of(s1) > 3 || rank_of(s1) > 3
+                            || off_diagonal(s1) > 0 || t.a1_d1_d4[s1] != i)
+                            continue;
+                        // Every other square is mapped to 0 too
+                        if (i == 0 && s1 != 1)
+                            continue;
+
+                        for (int s2 = 0; s2 < 64; ++s2)
+                        {
+                            const int files = file_of(s1) - file_of(s2);
+                            const int ranks = rank_of(s1) - rank_of(s2);
+                            if (files >= -1 && files <= 1
+                                && ranks >= -1 && ranks <= 1)
+                                continue; // Illegal position
+                            if (!off_diagonal(s1) && off_diagonal(s2) > 0)
+                                continue; // First on diagonal, second above
+                            const bool both_on_diagonal =
+                                    !off_diagonal(s1) && !off_diagonal(s2);
+                            if (both_on_diagonal == (last == 1))
+                                t.king_pairs[i][s2] = code++;
+                        }
+                    }
+
+            t.binomial[0][0] = 1;
+            for (int n = 1; n < 64; ++n)
+                for (int k = 0; k < max_pieces && k <= n; ++k)
+                    t.binomial[k][n] = (k > 0 ? t.binomial[k - 1][n - 1] : 0)
+                                       + (k < n ? t.binomial[k][n - 1] : 0);
+
+            // Closer to the edge first, then lower ranks first
+            int available = 47;
+            for (int file = 0; file < 4; ++file)
+                for (int rank = 1; rank <= 6; ++rank)
+                {
+                    const int s = rank * 8 + file;
+                    t.pawns[s] = available--;
+                    t.pawns[flip_file(s)] = available--;
+                }
+
+            for (int count = 1; count < max_pieces; ++count)
+                for (int file = 0; file < 4; ++file)
+                {
+                    int index = 0;
+                    for (int rank = 1; rank <= 6; ++rank)
+                    {
+                        const int s = rank * 8 + file;
+                        t.lead_pawns_index[count][s] = index;
+                        index += t.binomial[count - 1][t.pawns[s]];
+                    }
+                    t.lead_pawns_size[count][file] = index;
+                }
+
+            return t;
+        }
+
+        constexpr Indexing indexing = generate_indexing();
+
+        bool pawns_compare(const int lhs, const int rhs)
+        {
+            return indexing.pawns[lhs] < indexing.pawns[rhs];
+        }
+
+        int piece_code(const Board& board, const int square)
+        {
+            static constexpr std::array<int, nb_pieces> codes = {
+                5, 4, 3, 2, 1, 6 // QUEEN, ROOK, BISHOP, KNIGHT, PAWN, KING
+            };
+
+            const uint64_t bit = 1ULL << square;
+            const int color = board(Color::BLACK) & bit ? black_code : 0;
+            for (const auto piece : piecetype_array)
+                if (board(piece) & bit)
+                    return codes[utils::utype(piece)] | color;
+            return 0;
+        }
+    } // namespace
+
+    Table::Table(const TableType type, const std::string& signature,
+                 const std::string& path)
+        : type_(type)
+        , signature_(signature)
+        , path_(path)
+        , key_(ai::endgame::signature_key(signature, Color::WHITE))
+        , key2_(ai::endgame::signature_key(signature, Color::BLACK))
+    {
+        const auto v = signature.find('v');
+        const std::string white = signature.substr(0, v);
+        const std::string black = signature.substr(v + 1);
+
+        piece_count_ = white.size() + black.size();
+        const int white_pawns = std::count(white.begin(), white.end(), 'P');
+        const int black_pawns = std::count(black.begin(), black.end(), 'P');
+        has_pawns_ = white_pawns + black_pawns > 0;
+
+        for (const auto& side : {white, black})
+            for (const char piece : std::string("PNBRQ"))
+                if (std::count(side.begin(), side.end(), piece) == 1)
+                    has_unique_pieces_ = true;
+
+        // The side with less pawns leads, for a better compression
+        const bool white_leads = black_pawns == 0
+                || (white_pawns && black_pawns >= white_pawns);
+        pawn_count_[0] = white_leads ? white_pawns : black_pawns;
+        pawn_count_[1] = white_leads ? black_pawns : white_pawns;
+
+        sides_ = type_ == TableType::WDL && key_ != key2_ ? 2 : 1;
+    }
+
+    TableType Table::get_type(void) const
+    {
+        return type_;
+    }
+
+    const std::string& Table::get_signature(void) const
+    {
+        return signature_;
+    }
+
+    uint64_t Table::get_key(void) const
+    {
+        return key_;
+    }
+
+    uint64_t Table::get_key2(void) const
+    {
+        return key2_;
+    }
+
+    int Table::get_piece_count(void) const
+    {
+        return piece_count_;
+    }
+
+    bool Table::map(void)
+    {
+        std::call_once(mapped_once_, [this]()
+        {
+            mapped_ = file_.open(path_) && parse();
+            if (!mapped_)
+                std::cerr << "cannot use tablebase " << path_ << '\n';
+        });
+        return mapped_;
+    }
+
+    bool Table::parse(void)
+    {
+        // The files are made of 64 bytes blocks after a 16 bytes header
+        if (file_.size() % 64 != 16)
+            return false;
+
+        const uint8_t* data = file_.data();
+        const uint32_t magic = type_ == TableType::WDL ? wdl_magic : dtz_magic;
+        if (read_le32(data) != magic)
+            return false;
+        data += 4;
+
+        enum { SPLIT = 1, HAS_PAWNS = 2 };
+        if (has_pawns_ != bool(*data & HAS_PAWNS)
+            || (key_ != key2_) != bool(*data & SPLIT))
+            return false;
+        data++;
+
+        const int max_file = has_pawns_ ? 3 : 0;
+        const bool pawns_on_both_sides = has_pawns_ && pawn_count_[1];
+
+        for (int file = 0; file <= max_file; ++file)
+        {
+            // Order of the leading group and of the other pawns
+            const std::array<std::array<int, 2>, 2> order = {{
+                {data[0] & 0xf, pawns_on_both_sides ? data[1] & 0xf : 0xf},
+                {data[0] >> 4, pawns_on_both_sides ? data[1] >> 4 : 0xf}
+            }};
+            data += 1 + pawns_on_both_sides;
+
+            for (int k = 0; k < piece_count_; ++k, ++data)
+                for (int i = 0; i < sides_; ++i)
+                    items_[i][file].pieces[k] = i ? *data >> 4 : *data & 0xf;
+
+            for (int i = 0; i < sides_; ++i)
+                set_groups(items_[i][file], order[i], file);
+        }
+
+        data = align(data, 2);
+
+        for (int file = 0; file <= max_file; ++file)
+            for (int i = 0; i < sides_; ++i)
+                data = set_sizes(items_[i][file], data);
+
+        if (type_ == TableType::DTZ)
+            data = set_dtz_map(data, max_file);
+
+        for (int file = 0; file <= max_file; ++file)
+            for (int i = 0; i < sides_; ++i)
+            {
+                PairsData& d = items_[i][file];
+                d.sparse_index = data;
+                data += d.sparse_index_size * 6; // uint32 block, uint16 offset
+            }
+
+        for (int file = 0; file <= max_file; ++file)
+            for (int i = 0; i < sides_; ++i)
+            {
+                PairsData& d = items_[i][file];
+                d.block_length = data;
+                data += d.block_length_size * sizeof(uint16_t);
+            }
+
+        for (int file = 0; file <= max_file; ++file)
+            for (int i = 0; i < sides_; ++i)
+            {
+                PairsData& d = items_[i][file];
+                data = align(data, 64);
+                d.data = data;
+                data += d.blocks * d.block_size;
+            }
+
+        return data <= file_.data() + file_.size();
+    }
+
+    // The pieces are split in groups, encoded in the order given by the file:
+    //     g1 * N(g2) * N(g3) + g2 * N(g3) + g3
+    // where N(g) is the number of placements of the group g
+    void Table::set_groups(PairsData& d, const std::array<int, 2>& order,
+                           const int file)
+    {
+        int n = 0;
+        int first_length = has_pawns_ ? 0 : has_unique_pieces_ ? 3 : 2;
+        d.group_length[n] = 1;
+
+        for (int i = 1; i < piece_count_; ++i)
+            if (--first_length > 0 || d.pieces[i] == d.pieces[i - 1])
+                d.group_length[n]++;
+            else
+                d.group_length[++n] = 1;
+        d.group_length[++n] = 0;
+
+        const bool pawns_on_both_sides = has_pawns_ && pawn_count_[1];
+        int next = pawns_on_both_sides ? 2 : 1;
+        int free_squares = 64 - d.group_length[0]
+                           - (pawns_on_both_sides ? d.group_length[1] : 0);
+        uint64_t index = 1;
+
+        for (int k = 0; next < n || k == order[0] || k == order[1]; ++k)
+            if (k == order[0]) // Leading group
+            {
+                d.group_index[0] = index;
+                index *= has_pawns_
+                        ? indexing.lead_pawns_size[d.group_length[0]][file]
+                        : has_unique_pieces_ ? 31332 : 462;
+            }
+            else if (k == order[1]) // Other pawns
+            {
+                d.group_index[1] = index;
+                index *= indexing.binomial[d.group_length[1]]
+                                          [48 - d.group_length[0]];
+            }
+            else // Other pieces
+            {
+                d.group_index[next] = index;
+                index *= indexing.binomial[d.group_length[next]][free_squares];
+                free_squares -= d.group_length[next++];
+            }
+
+        d.group_index[n] = index;
+    }
+
+    const uint8_t* Table::set_sizes(PairsData& d, const uint8_t* data)
+    {
+        d.flags = *data++;
+
+        if (d.flags & SINGLE_VALUE)
+        {
+            d.blocks = 0;
+            d.block_length_size = 0;
+            d.span = 0;
+            d.sparse_index_size = 0;
+            d.min_sym_length = *data++; // The single value
+            return data;
+        }
+
+        // The last group index is the size of the table
+        const auto groups = std::find(d.group_length.begin(),
+                                      d.group_length.end(), 0);
+        const uint64_t size =
+                d.group_index[groups - d.group_length.begin()];
+
+        d.block_size = size_t{1} << *data++;
+        d.span = size_t{1} << *data++;
+        d.sparse_index_size = (size + d.span - 1) / d.span;
+        const int padding = *data++;
+        d.blocks = read_le32(data);
+        data += sizeof(uint32_t);
+        // Padded so that the sparse index does not point out of range
+        d.block_length_size = d.blocks + padding;
+        d.max_sym_length = *data++;
+        d.min_sym_length = *data++;
+        d.lowest_sym = data;
+
+        // Canonical Huffman code: longer codes have lower values, the lowest
+        // code of each length is computed from the lowest symbols
+        const int lengths = d.max_sym_length - d.min_sym_length + 1;
+        d.base64.assign(lengths, 0);
+        for (int i = lengths - 2; i >= 0; --i)
+            d.base64[i] = (d.base64[i + 1]
+                           + read_le16(d.lowest_sym + 2 * i)
+                           - read_le16(d.lowest_sym + 2 * (i + 1))) / 2;
+        for (int i = 0; i < lengths; ++i)
+            d.base64[i] <<= 64 - i - d.min_sym_length;
+
+        data += lengths * sizeof(uint16_t);
+        d.sym_length.assign(read_le16(data), 0);
+        data += sizeof(uint16_t);
+        d.btree = data;
+
+        std::vector<bool> visited(d.sym_length.size());
+        for (size_t sym = 0; sym < d.sym_length.size(); ++sym)
+            if (!visited[sym])
+                d.sym_length[sym] = set_sym_length(d, sym, visited);
+
+        return data + d.sym_length.size() * 3 + (d.sym_length.size() & 1);
+    }
+
+    int Table::set_sym_length(PairsData& d, const int sym,
+                              std::vector<bool>& visited)
+    {
+        visited[sym] = true;
+
+        const int right = btree_right(d.btree, sym);
+        if (right == 0xfff) // Leaf
+            return 0;
+
+        const int left = btree_left(d.btree, sym);
+        if (!visited[left])
+            d.sym_length[left] = set_sym_length(d, left, visited);
+        if (!visited[right])
+            d.sym_length[right] = set_sym_length(d, right, visited);
+
+        return d.sym_length[left] + d.sym_length[right] + 1;
+    }
+
+    const uint8_t* Table::set_dtz_map(const uint8_t* data, const int max_file)
+    {
+        dtz_map_ = data;
+
+        for (int file = 0; file <= max_file; ++file)
+        {
+            PairsData& d = items_[0][file];
+            if (!(d.flags & MAPPED))
+                continue;
+
+            // One map per WDL result
+            if (d.flags & WIDE)
+            {
+                data = align(data, 2);
+                for (int i = 0; i < 4; ++i)
+                {
+                    d.map_index[i] = (data - dtz_map_) / 2 + 1;
+                    data += 2 * read_le16(data) + 2;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    d.map_index[i] = data - dtz_map_ + 1;
+                    data += *data + 1;
+                }
+            }
+        }
+
+        return align(data, 2);
+    }
+
+    const Table::PairsData& Table::get(const int side_to_move,
+                                       const int file) const
+    {
+        return items_[side_to_move % sides_][has_pawns_ ? file : 0];
+    }
+
+    int Table::decompress(const PairsData& d, const uint64_t index) const
+    {
+        if (d.flags & SINGLE_VALUE)
+            return d.min_sym_length;
+
+        // The sparse index gives the block and offset of the value at
+        // k * span + span / 2, walk the blocks from there
+        const uint32_t k = index / d.span;
+        const uint8_t* entry = d.sparse_index + 6 * k;
+        uint32_t block = read_le32(entry);
+        int offset = read_le16(entry + 4);
+        offset += static_cast<int>(index % d.span)
+                  - static_cast<int>(d.span / 2);
+
+        while (offset < 0)
+            offset += read_le16(d.block_length + 2 * --block) + 1;
+        while (offset > read_le16(d.block_length + 2 * block))
+            offset -= read_le16(d.block_length + 2 * block++) + 1;
+
+        // Huffman symbols of the block, read 32 bits at a time
+        const uint8_t* ptr = d.data + uint64_t{block} * d.block_size;
+        uint64_t buffer = read_be64(ptr);
+        ptr += 8;
+        int buffer_size = 64;
+        int sym;
+
+        while (true)
+        {
+            int length = 0;
+            while (buffer < d.base64[length])
+                ++length;
+
+            sym = (buffer - d.base64[length])
+                  >> (64 - length - d.min_sym_length);
+            sym += read_le16(d.lowest_sym + 2 * length);
+
+            if (offset < d.sym_length[sym] + 1)
+                break;
+
+            offset -= d.sym_length[sym] + 1;
+            length += d.min_sym_length;
+            buffer <<= length;
+            buffer_size -= length;
+
+            if (buffer_size <= 32)
+            {
+                buffer_size += 32;
+                buffer |= uint64_t{read_be32(ptr)} << (64 - buffer_size);
+                ptr += 4;
+            }
+        }
+
+        // Expand the pairs down to the value at offset
+        while (d.sym_length[sym])
+        {
+            const int left = btree_left(d.btree, sym);
+            if (offset < d.sym_length[left] + 1)
+                sym = left;
+            else
+            {
+                offset -= d.sym_length[left] + 1;
+                sym = btree_right(d.btree, sym);
+            }
+        }
+
+        return btree_left(d.btree, sym);
+    }
+
+    int Table::map_score(const int file, int value, const Wdl wdl) const
+    {
+        if (type_ == TableType::WDL)
+            return value - 2;
+
+        // Index of the map of each WDL result, from LOSS to WIN
+        constexpr std::array<int, 5> wdl_map = {1, 3, 0, 2, 0};
+
+        const PairsData& d = get(0, file);
+        const int i = d.map_index[wdl_map[static_cast<int>(wdl) + 2]];
+        if (d.flags & MAPPED)
+            value = d.flags & WIDE ? read_le16(dtz_map_ + 2 * (i + value))
+                                   : dtz_map_[i + value];
+
+        // Convert moves to plies
+        if ((wdl == Wdl::WIN && !(d.flags & WIN_PLIES))
+            || (wdl == Wdl::LOSS && !(d.flags & LOSS_PLIES))
+            || wdl == Wdl::CURSED_WIN || wdl == Wdl::BLESSED_LOSS)
+            value *= 2;
+
+        return value + 1;
+    }
+
+    std::optional<int> Table::probe(const Board& board,
+                                    const Color side_to_move,
+                                    const Wdl wdl) const
+    {
+        // Tables are computed with white as the first side of the signature,
+        // and only white to move when both sides have the same material:
+        // otherwise swap the colors and flip the board
+        const bool black_to_move = side_to_move == Color::BLACK;
+        const bool flip = (key_ == key2_ && black_to_move)
+                          || ai::endgame::material_key(board) != key_;
+        const int flip_color = flip ? black_code : 0;
+        const int flip_squares = flip ? 56 : 0;
+        const int stm = flip != black_to_move;
+
+        std::array<int, max_pieces> squares{};
+        std::array<int, max_pieces> pieces{};
+        int size = 0;
+        int lead_pawns_count = 0;
+        uint64_t lead_pawns = 0;
+        int file = 0;
+
+        // With pawns, the tables are split on the file of the leading pawn
+        if (has_pawns_)
+        {
+            const int code = items_[0][0].pieces[0] ^ flip_color;
+            const Color color = code & black_code ? Color::BLACK
+                                                  : Color::WHITE;
+            lead_pawns = board(PieceType::PAWN, color);
+            uint64_t pawns = lead_pawns;
+            for (int s = utils::pop_lsb(pawns); s >= 0;
+                 s = utils::pop_lsb(pawns))
+                squares[size++] = s ^ flip_squares;
+            lead_pawns_count = size;
+
+            std::swap(squares[0],
+                      *std::max_element(squares.begin(),
+                                        squares.begin() + size,
+                                        pawns_compare));
+            file = edge_distance(file_of(squares[0]));
+        }
+
+        // DTZ tables only store one side to move
+        const PairsData& d = get(stm, file);
+        if (type_ == TableType::DTZ && (d.flags & STM) != stm
+            && !(key_ == key2_ && !has_pawns_))
+            return std::nullopt;
+
+        uint64_t others = board() ^ lead_pawns;
+        for (int s = utils::pop_lsb(others); s >= 0;
+             s = utils::pop_lsb(others))
+        {
+            squares[size] = s ^ flip_squares;
+            pieces[size++] = piece_code(board, s) ^ flip_color;
+        }
+
+        // Same piece order than the file
+        for (int i = lead_pawns_count; i < size - 1; ++i)
+            for (int j = i + 1; j < size; ++j)
+                if (d.pieces[i] == pieces[j])
+                {
+                    std::swap(pieces[i], pieces[j]);
+                    std::swap(squares[i], squares[j]);
+                    break;
+                }
+
+        // Leading piece on the files a to d
+        if (file_of(squares[0]) > 3)
+            for (int i = 0; i < size; ++i)
+                squares[i] = flip_file(squares[i]);
+
+        uint64_t index;
+        if (has_pawns_)
+        {
+            index = indexing.lead_pawns_index[lead_pawns_count][squares[0]];
+            std::stable_sort(squares.begin() + 1,
+                             squares.begin() + lead_pawns_count,
+                             pawns_compare);
+            for (int i = 1; i < lead_pawns_count; ++i)
+                index += indexing.binomial[i][indexing.pawns[squares[i]]];
+        }
+        else
+        {
+            // Leading piece on the ranks 1 to 4
+            if (rank_of(squares[0]) > 3)
+                for (int i = 0; i < size; ++i)
+                    squares[i] ^= 56;
+
+            // First piece of the leading group out of the a1-h8 diagonal
+            // below it
+            for (int i = 0; i < d.group_length[0]; ++i)
+            {
+                if (!off_diagonal(squares[i]))
+                    continue;
+                if (off_diagonal(squares[i]) > 0)
+                    for (int j = i; j < size; ++j)
+                        squares[j] = ((squares[j] >> 3) | (squares[j] << 3))
+                                     & 63;
+                break;
+            }
+
+            if (has_unique_pieces_)
+            {
+                const int adjust1 = squares[1] > squares[0];
+                const int adjust2 = (squares[2] > squares[0])
+                                    + (squares[2] > squares[1]);
+
+                if (off_diagonal(squares[0]))
+                    index = (indexing.a1_d1_d4[squares[0]] * 63
+                             + (squares[1] - adjust1)) * 62
+                            + squares[2] - adjust2;
+                else if (off_diagonal(squares[1]))
+                    index = (6 * 63 + rank_of(squares[0]) * 28
+                             + indexing.b1_h1_h7[squares[1]]) * 62
+                            + squares[2] - adjust2;
+                else if (off_diagonal(squares[2]))
+                    index = 6 * 63 * 62 + 4 * 28 * 62
+                            + rank_of(squares[0]) * 7 * 28
+                            + (rank_of(squares[1]) - adjust1) * 28
+                            + indexing.b1_h1_h7[squares[2]];
+                else
+                    index = 6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28
+                            + rank_of(squares[0]) * 7 * 6
+                            + (rank_of(squares[1]) - adjust1) * 6
+                            + (rank_of(squares[2]) - adjust2);
+            }
+            else
+                index = indexing.king_pairs[indexing.a1_d1_d4[squares[0]]]
+                                           [squares[1]];
+        }
+
+        // Remaining groups, each one in ascending order of squares
+        index *= d.group_index[0];
+        int group = d.group_length[0];
+        bool remaining_pawns = has_pawns_ && pawn_count_[1];
+
+        for (int next = 1; d.group_length[next]; ++next)
+        {
+            const int length = d.group_length[next];
+            std::stable_sort(squares.begin() + group,
+                             squares.begin() + group + length);
+
+            uint64_t n = 0;
+            for (int i = 0; i < length; ++i)
+            {
+                // Skip the squares taken by the previous groups
+                const int square = squares[group + i];
+                const int adjust = std::count_if(
+                        squares.begin(), squares.begin() + group,
+                        [square](const int s) { return square > s; });
+                n += indexing.binomial[i + 1]
+                                      [square - adjust - 8 * remaining_pawns];
+            }
+
+            remaining_pawns = false;
+            index += n * d.group_index[next];
+            group += length;
+        }
+
+        return map_score(file, decompress(d, index), wdl);
+    }
+} // namespace syzygy
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "utils/mapped-file.hh"
+#include "chess_engine/board/board.hh"
+
+// Decoder of a single Syzygy file (.rtbw or .rtbz)
+//
+// A table stores one value per position of a material signature, for
+// instance KRvK. Positions are turned into an index by removing the
+// symmetries of the board, and the values are compressed with recursive
+// pairing followed by a canonical Huffman code. The table is only mapped
+// in memory on its first probe, and read directly from the mapping.
+namespace syzygy
+{
+    constexpr int max_pieces = 7;
+
+    // Win/Draw/Loss from the point of view of the side to move. The cursed
+    // wins and blessed losses are draws under the fifty moves rule.
+    enum class Wdl : int
+    {
+        LOSS = -2,
+        BLESSED_LOSS = -1,
+        DRAW = 0,
+        CURSED_WIN = 1,
+        WIN = 2
+    };
+
+    enum class TableType
+    {
+        WDL,
+        DTZ
+    };
+
+    class Table
+    {
+    public:
+        // signature: eg "KRvKP", the first side is the white one in the file
+        Table(TableType type, const std::string& signature,
+              const std::string& path);
+
+        Table(const Table&) = delete;
+        Table& operator=(const Table&) = delete;
+
+        TableType get_type(void) const;
+        const std::string& get_signature(void) const;
+        uint64_t get_key(void) const;
+        uint64_t get_key2(void) const;
+        int get_piece_count(void) const;
+
+        // Map and parse the file on first call, false if it is unusable
+        bool map(void);
+
+        // Value stored for the board, nullopt when a DTZ table only stores
+        // the other side to move. For DTZ tables, wdl is the WDL score of
+        // the position, used to decode the value.
+        // Pre: map() returned true, the material of the board is the one
+        // of the table, no castling right.
+        std::optional<int> probe(const board::Board& board,
+                                 board::Color side_to_move,
+                                 Wdl wdl = Wdl::DRAW) const;
+
+    private:
+        // Decoding data of one side to move and one leading pawn file
+        struct PairsData
+        {
+            uint8_t flags = 0;
+            size_t block_size = 0;
+            size_t span = 0;
+            size_t sparse_index_size = 0;
+            size_t block_length_size = 0;
+            uint32_t blocks = 0;
+            int max_sym_length = 0;
+            int min_sym_length = 0;
+
+            // Little endian arrays inside the mapping
+            const uint8_t* lowest_sym = nullptr;
+            const uint8_t* btree = nullptr;
+            const uint8_t* sparse_index = nullptr;
+            const uint8_t* block_length = nullptr;
+            const uint8_t* data = nullptr;
+
+            // Lowest Huffman code of each length, left aligned
+            std::vector<uint64_t> base64;
+            // Number of values minus one each symbol expands to
+            std::vector<uint8_t> sym_length;
+
+            std::array<int, max_pieces> pieces{};
+            std::array<uint64_t, max_pieces + 1> group_index{};
+            std::array<int, max_pieces + 1> group_length{};
+            std::array<uint16_t, 4> map_index{}; // DTZ only
+        };
+
+        TableType type_;
+        std::string signature_;
+        std::string path_;
+
+        uint64_t key_;  // White owns the first side of the signature
+        uint64_t key2_; // Black owns it
+        int piece_count_ = 0;
+        bool has_pawns_ = false;
+        bool has_unique_pieces_ = false;
+        // Pawns of the leading color, then of the other one
+        std::array<int, 2> pawn_count_{};
+
+        std::once_flag mapped_once_;
+        bool mapped_ = false;
+        utils::MappedFile file_;
+
+        int sides_ = 1;
+        std::array<std::array<PairsData, 4>, 2> items_;
+        const uint8_t* dtz_map_ = nullptr;
+
+        bool parse(void);
+        void set_groups(PairsData& d, const std::array<int, 2>& order,
+                        int file);
+        const uint8_t* set_sizes(PairsData& d, const uint8_t* data);
+        const uint8_t* set_dtz_map(const uint8_t* data, int max_file);
+        int set_sym_length(PairsData& d, int sym, std::vector<bool>& visited);
+
+        const PairsData& get(int side_to_move, int file) const;
+        int decompress(const PairsData& d, uint64_t index) const;
+        int map_score(int file, int value, Wdl wdl) const;
+    };
+} // namespace syzygy
@@ -0,0 +1,410 @@
+#include "tablebase.hh"
+
+#include <memory>
+#include <sstream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#include "chess_engine/ai/endgame.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace syzygy
+{
+    namespace
+    {
+        // Result of a probe, as in the reference implementation
+        enum class State
+        {
+            FAIL,
+            OK,
+            CHANGE_STM,       // DTZ table of the other side to move
+            ZEROING_BEST_MOVE // The best move is a capture or a pawn move
+        };
+
+        struct Entry
+        {
+            std::unique_ptr<Table> wdl;
+            std::unique_ptr<Table> dtz;
+        };
+
+        // eg: "KRPvKR", kings first and at most max_pieces pieces
+        bool is_signature(const std::string& name)
+        {
+            const auto v = name.find('v');
+            if (v == std::string::npos || name.find('v', v + 1)
+                != std::string::npos || name.size() > max_pieces + 1)
+                return false;
+
+            for (const auto& side : {name.substr(0, v), name.substr(v + 1)})
+                if (side.empty() || side[0] != 'K'
+                    || side.find_first_not_of("QRBNP", 1) != std::string::npos)
+                    return false;
+            return true;
+        }
+
+        class Registry
+        {
+        public:
+            static Registry& get_instance()
+            {
+                static Registry instance;
+                return instance;
+            }
+
+            size_t init(const std::string& paths)
+            {
+                entries_.clear();
+                keys_.clear();
+                max_pieces_ = 0;
+
+                // Signature to path, the first directory wins
+                std::unordered_map<std::string, std::string> wdl_files;
+                std::unordered_map<std::string, std::string> dtz_files;
+
+                std::istringstream ss(paths);
+                std::string directory;
+                while (std::getline(ss, directory, ':'))
+                {
+                    std::error_code error;
+                    namespace fs = std::filesystem;
+                    for (const auto& file : fs::directory_iterator(directory,
+                                                                   error))
+                    {
+                        const std::string name = file.path().stem().string();
+                        const std::string extension =
+                                file.path().extension().string();
+                        if (!is_signature(name))
+                            continue;
+                        if (extension == ".rtbw")
+                            wdl_files.emplace(name, file.path().string());
+                        else if (extension == ".rtbz")
+                            dtz_files.emplace(name, file.path().string());
+                    }
+                }
+
+                for (const auto& [signature, path] : wdl_files)
+                {
+                    auto entry = std::make_unique<Entry>();
+                    entry->wdl = std::make_unique<Table>(TableType::WDL,
+                                                         signature, path);
+                    const auto dtz = dtz_files.find(signature);
+                    if (dtz != dtz_files.end())
+                        entry->dtz = std::make_unique<Table>(
+                                TableType::DTZ, signature, dtz->second);
+
+                    keys_[entry->wdl->get_key()] = entry.get();
+                    keys_[entry->wdl->get_key2()] = entry.get();
+                    max_pieces_ = std::max(max_pieces_,
+                                           entry->wdl->get_piece_count());
+                    entries_.push_back(std::move(entry));
+                }
+
+                return entries_.size();
+            }
+
+            // Table of the material, mapped, nullptr if unavailable
+            Table* find(const TableType type, const uint64_t key) const
+            {
+                const auto it = keys_.find(key);
+                if (it == keys_.end())
+                    return nullptr;
+
+                Table* table = type == TableType::WDL ? it->second->wdl.get()
+                                                      : it->second->dtz.get();
+                return table != nullptr && table->map() ? table : nullptr;
+            }
+
+            int get_max_pieces(void) const
+            {
+                return max_pieces_;
+            }
+
+        private:
+            std::vector<std::unique_ptr<Entry>> entries_;
+            std::unordered_map<uint64_t, Entry*> keys_;
+            int max_pieces_ = 0;
+
+            Registry() = default;
+        };
+
+        int piece_count(const Chessboard& board)
+        {
+            return utils::bits_count(board.get_board()());
+        }
+
+        bool is_zeroing(const Move& move)
+        {
+            return move.get_capture() || move.get_piece() == PieceType::PAWN;
+        }
+
+        // Raw value of the table of the board
+        int probe_table(const TableType type, const Chessboard& board,
+                        State& state, const Wdl wdl = Wdl::DRAW)
+        {
+            if (piece_count(board) == 2) // KvK
+                return 0;
+
+            const Table* table = Registry::get_instance().find(
+                    type, ai::endgame::material_key(board.get_board()));
+            if (table == nullptr)
+            {
+                state = State::FAIL;
+                return 0;
+            }
+
+            const auto value = table->probe(board.get_board(),
+                                            board.get_playing_color(), wdl);
+            if (!value.has_value())
+            {
+                state = State::CHANGE_STM;
+                return 0;
+            }
+            return value.value();
+        }
+
+        // The tables store "don't care" values when a capture (or a pawn
+        // move for DTZ) is the best move, and ignore en passant: these moves
+        // are searched before trusting the table
+        int search(const Chessboard& board, State& state,
+                   const bool check_zeroing_moves)
+        {
+            Chessboard position = board;
+            const auto moves = position.generate_legal_moves();
+
+            int best = static_cast<int>(Wdl::LOSS);
+            size_t move_count = 0;
+            for (const auto& move : moves)
+            {
+                if (!move.get_capture() && (!check_zeroing_moves
+                    || move.get_piece() != PieceType::PAWN))
+                    continue;
+
+                move_count++;
+                Chessboard child = board;
+                child.do_move(move);
+                const int value = -search(child, state, false);
+                if (state == State::FAIL)
+                    return 0;
+
+                if (value > best)
+                {
+                    best = value;
+                    if (value >= static_cast<int>(Wdl::WIN))
+                    {
+                        state = State::ZEROING_BEST_MOVE;
+                        return value;
+                    }
+                }
+            }
+
+            // Every move has been searched, the table is not needed
+            const bool no_more_moves = move_count
+                                       && move_count == moves.size();
+
+            int value = best;
+            if (!no_more_moves)
+            {
+                value = probe_table(TableType::WDL, board, state);
+                if (state == State::FAIL)
+                    return 0;
+            }
+
+            if (best >= value)
+            {
+                state = best > 0 || no_more_moves ? State::ZEROING_BEST_MOVE
+                                                  : State::OK;
+                return best;
+            }
+
+            state = State::OK;
+            return value;
+        }
+
+        int dtz_before_zeroing(const int wdl)
+        {
+            switch (static_cast<Wdl>(wdl))
+            {
+            case Wdl::WIN:
+                return 1;
+            case Wdl::CURSED_WIN:
+                return 101;
+            case Wdl::BLESSED_LOSS:
+                return -101;
+            case Wdl::LOSS:
+                return -1;
+            default:
+                return 0;
+            }
+        }
+
+        int sign(const int value)
+        {
+            return (value > 0) - (value < 0);
+        }
+
+        int dtz(const Chessboard& board, State& state)
+        {
+            state = State::OK;
+            const int wdl = search(board, state, true);
+
+            // DTZ tables do not store the draws
+            if (state == State::FAIL || wdl == 0)
+                return 0;
+
+            // The table stores a "don't care" value
+            if (state == State::ZEROING_BEST_MOVE)
+                return dtz_before_zeroing(wdl);
+
+            const int value = probe_table(TableType::DTZ, board, state,
+                                          static_cast<Wdl>(wdl));
+            if (state == State::FAIL)
+                return 0;
+
+            if (state != State::CHANGE_STM)
+                return (value + 100 * (wdl == 1 || wdl == -1)) * sign(wdl);
+
+            // The table is for the other side to move: one ply search for
+            // the move with the lowest DTZ
+            Chessboard position = board;
+            int min_dtz = 0xffff;
+            for (const auto& move : position.generate_legal_moves())
+            {
+                const bool zeroing = is_zeroing(move);
+                Chessboard child = board;
+                child.do_move(move);
+
+                // For zeroing moves, the DTZ is the one before the move
+                int child_dtz = zeroing
+                        ? -dtz_before_zeroing(search(child, state, false))
+                        : -dtz(child, state);
+
+                // A mate is the fastest possible conversion
+                if (child_dtz == 1 && child.is_check()
+                    && !child.has_legal_moves())
+                    min_dtz = 1;
+
+                if (!zeroing)
+                    child_dtz += sign(child_dtz);
+
+                if (child_dtz < min_dtz && sign(child_dtz) == sign(wdl))
+                    min_dtz = child_dtz;
+
+                if (state == State::FAIL)
+                    return 0;
+            }
+
+            // No legal move: mated
+            return min_dtz == 0xffff ? -1 : min_dtz;
+        }
+    } // namespace
+
+    size_t init(const std::string& paths)
+    {
+        return Registry::get_instance().init(paths);
+    }
+
+    int get_max_pieces(void)
+    {
+        return Registry::get_instance().get_max_pieces();
+    }
+
+    bool can_probe(const Chessboard& board)
+    {
+        return piece_count(board) <= get_max_pieces()
+               && !board.get_king_castling(Color::WHITE)
+               && !board.get_queen_castling(Color::WHITE)
+               && !board.get_king_castling(Color::BLACK)
+               && !board.get_queen_castling(Color::BLACK);
+    }
+
+    std::optional<Wdl> probe_wdl(const Chessboard& board)
+    {
+        if (!can_probe(board))
+            return std::nullopt;
+
+        State state = State::OK;
+        const int wdl = search(board, state, false);
+        if (state == State::FAIL)
+            return std::nullopt;
+        return static_cast<Wdl>(wdl);
+    }
+
+    std::optional<int> probe_dtz(const Chessboard& board)
+    {
+        if (!can_probe(board))
+            return std::nullopt;
+
+        State state = State::OK;
+        const int value = dtz(board, state);
+        if (state == State::FAIL)
+            return std::nullopt;
+        return value;
+    }
+
+    bool filter_root_moves(const Chessboard& board, std::vector<Move>& moves)
+    {
+        if (moves.empty() || !can_probe(board))
+            return false;
+
+        // Plies from the root to the next zeroing move, after each move
+        std::vector<int> dtzs;
+        for (const auto& move : moves)
+        {
+            Chessboard child = board;
+            child.do_move(move);
+
+            State state = State::OK;
+            int move_dtz;
+            if (is_zeroing(move))
+                move_dtz = dtz_before_zeroing(-search(child, state, false));
+            else
+            {
+                move_dtz = -dtz(child, state);
+                move_dtz += sign(move_dtz);
+            }
+            if (state == State::FAIL)
+                return false;
+
+            if (move_dtz == 2 && child.is_check() && !child.has_legal_moves())
+                move_dtz = 1;
+            dtzs.push_back(move_dtz);
+        }
+
+        // A win is only real if its zeroing move comes before the fifty
+        // moves rule, counted from the clock of the root. Every real win is
+        // kept, the search chooses among them. Otherwise the win is cursed,
+        // only the fastest moves leave a chance to the opponent to err.
+        const int clock = board.get_halfmove_clock();
+        int fastest_win = 0;
+        int slowest_loss = 0;
+        bool draw = false;
+        for (const int move_dtz : dtzs)
+        {
+            if (move_dtz > 0 && (!fastest_win || move_dtz < fastest_win))
+                fastest_win = move_dtz;
+            slowest_loss = std::min(slowest_loss, move_dtz);
+            draw |= move_dtz == 0;
+        }
+        const int win_limit = fastest_win + clock <= 100 ? 100 - clock
+                                                         : fastest_win;
+
+        const auto keep = [&](const int move_dtz)
+        {
+            if (fastest_win)
+                return move_dtz > 0 && move_dtz <= win_limit;
+            if (draw)
+                return move_dtz == 0;
+            return move_dtz == slowest_loss;
+        };
+
+        std::vector<Move> best_moves;
+        for (size_t i = 0; i < moves.size(); ++i)
+            if (keep(dtzs[i]))
+                best_moves.push_back(moves[i]);
+        moves = best_moves;
+        return true;
+    }
+} // namespace syzygy
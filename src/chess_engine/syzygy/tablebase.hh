@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+
+#include "table.hh"
+#include "chess_engine/board/chessboard.hh"
+
+// Syzygy endgame tablebases
+//
+// The directories given by the SyzygyPath UCI option are scanned for
+// .rtbw (win/draw/loss) and .rtbz (distance to zeroing move) files. Only
+// the names are read at that time, each file is mapped on its first probe.
+namespace syzygy
+{
+    // Scan the directories (separated by ':'), replacing the previous ones
+    // Return the number of WDL tables found
+    size_t init(const std::string& paths);
+
+    // Largest number of pieces of the known tables, 0 without tables
+    int get_max_pieces(void);
+
+    // Whether the tables can be probed for this board: few enough pieces
+    // and no castling right
+    bool can_probe(const board::Chessboard& board);
+
+    // Result for the side to move, nullopt if a table is missing
+    std::optional<Wdl> probe_wdl(const board::Chessboard& board);
+
+    // Plies before the next zeroing move (capture or pawn move), positive
+    // when winning, negative when losing, 0 for draws. The cursed and
+    // blessed results are counted beyond 100.
+    // nullopt if a table is missing
+    std::optional<int> probe_dtz(const board::Chessboard& board);
+
+    // Keep only the best moves: when winning, the ones which still win
+    // under the fifty moves rule given the halfmove clock of the board, or
+    // the fastest ones when the win is cursed. The draws otherwise, and
+    // the longest resistance when losing.
+    // Return false (moves unchanged) when the tables cannot be probed
+    bool filter_root_moves(const board::Chessboard& board,
+                           std::vector<board::Move>& moves);
+} // namespace syzygy
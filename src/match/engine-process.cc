@@ -0,0 +1,208 @@
+#include "engine-process.hh"
+
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <thread>
+#include <vector>
+#include <climits>
+#include <iterator>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace match
+{
+    namespace
+    {
+        constexpr auto startup_timeout = std::chrono::seconds(10);
+        constexpr auto quit_timeout = std::chrono::seconds(1);
+
+        void close_pipe(int (&fds)[2])
+        {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+    } // namespace
+
+    EngineProcess::EngineProcess(const std::string& command)
+    {
+        std::istringstream words(command);
+        std::vector<std::string> args{
+                std::istream_iterator<std::string>(words),
+                std::istream_iterator<std::string>()};
+        if (args.empty())
+            throw std::runtime_error("empty engine command");
+        // Built before fork, the child may only exec
+        std::vector<char*> argv;
+        for (auto& arg : args)
+            argv.push_back(arg.data());
+        argv.push_back(nullptr);
+
+        // Close on exec, so that the other engines do not inherit them
+        int to_engine[2];
+        int from_engine[2];
+        if (pipe2(to_engine, O_CLOEXEC) != 0)
+            throw std::runtime_error("cannot create a pipe");
+        if (pipe2(from_engine, O_CLOEXEC) != 0)
+        {
+            close_pipe(to_engine);
+            throw std::runtime_error("cannot create a pipe");
+        }
+
+        pid_ = fork();
+        if (pid_ == 0)
+        {
+            dup2(to_engine[0], STDIN_FILENO);
+            dup2(from_engine[1], STDOUT_FILENO);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        ::close(to_engine[0]);
+        ::close(from_engine[1]);
+        input_ = to_engine[1];
+        output_ = from_engine[0];
+        if (pid_ < 0)
+        {
+            shutdown();
+            throw std::runtime_error("cannot start " + args[0]);
+        }
+
+        send("uci");
+        const auto deadline = clock::now() + startup_timeout;
+        for (auto line = read_line(deadline); line != "uciok";
+             line = read_line(deadline))
+        {
+            if (!line.has_value())
+            {
+                shutdown();
+                throw std::runtime_error(args[0] + " is not an UCI engine");
+            }
+            const std::string id = "id name ";
+            if (line->compare(0, id.size(), id) == 0)
+                name_ = line->substr(id.size());
+        }
+    }
+
+    EngineProcess::~EngineProcess()
+    {
+        shutdown();
+    }
+
+    bool EngineProcess::send(const std::string& line)
+    {
+        if (input_ < 0)
+            return false;
+
+        const std::string data = line + '\n';
+        size_t written = 0;
+        while (written < data.size())
+        {
+            const auto count = write(input_, data.data() + written,
+                                     data.size() - written);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+            {
+                ::close(input_);
+                input_ = -1;
+                return false;
+            }
+            written += count;
+        }
+        return true;
+    }
+
+    std::optional<std::string> EngineProcess::read_line(
+            const clock::time_point deadline)
+    {
+        while (true)
+        {
+            const auto end = buffer_.find('\n');
+            if (end != std::string::npos)
+            {
+                std::string line = buffer_.substr(0, end);
+                buffer_.erase(0, end + 1);
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                return line;
+            }
+            if (output_ < 0)
+                return std::nullopt;
+
+            const auto remaining =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                            deadline - clock::now()).count();
+            if (remaining <= 0)
+                return std::nullopt;
+            pollfd readable{output_, POLLIN, 0};
+            const int ready = poll(&readable, 1, static_cast<int>(
+                    std::min<decltype(remaining)>(remaining, INT_MAX)));
+            if (ready < 0 && errno != EINTR)
+                return std::nullopt;
+            if (ready <= 0)
+                continue;
+
+            char chunk[4096];
+            const auto count = read(output_, chunk, sizeof(chunk));
+            if (count < 0 && errno == EINTR)
+                continue;
+            // The engine exited, its last lines are still returned
+            if (count <= 0)
+            {
+                ::close(output_);
+                output_ = -1;
+                continue;
+            }
+            buffer_.append(chunk, count);
+        }
+    }
+
+    std::optional<std::string> EngineProcess::wait_for(
+            const std::string& word, const clock::time_point deadline)
+    {
+        for (auto line = read_line(deadline); line.has_value();
+             line = read_line(deadline))
+            if (line->compare(0, word.size(), word) == 0
+                && (line->size() == word.size()
+                    || (*line)[word.size()] == ' '))
+                return line;
+        return std::nullopt;
+    }
+
+    const std::string& EngineProcess::name(void) const
+    {
+        return name_;
+    }
+
+    void EngineProcess::shutdown(void)
+    {
+        // The end of the input also stops most engines
+        send("quit");
+        if (input_ >= 0)
+            ::close(input_);
+        if (output_ >= 0)
+            ::close(output_);
+        input_ = -1;
+        output_ = -1;
+        if (pid_ <= 0)
+            return;
+
+        const auto deadline = clock::now() + quit_timeout;
+        while (waitpid(pid_, nullptr, WNOHANG) == 0)
+        {
+            if (clock::now() >= deadline)
+            {
+                kill(pid_, SIGKILL);
+                waitpid(pid_, nullptr, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pid_ = -1;
+    }
+} // namespace match
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <optional>
+#include <sys/types.h>
+
+namespace match
+{
+    /*
+    ** UCI engine running in a child process, spoken to through its standard
+    ** input and output. The engine is started and initialised (uci, uciok)
+    ** by the constructor, which throws a std::runtime_error if it does not
+    ** answer. The destructor sends quit, and kills the engine if it does
+    ** not exit. SIGPIPE has to be ignored, in case the engine exits while
+    ** it is written to.
+    */
+    class EngineProcess
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        // command: program followed by its arguments, separated by spaces
+        explicit EngineProcess(const std::string& command);
+        ~EngineProcess();
+
+        EngineProcess(const EngineProcess&) = delete;
+        EngineProcess& operator=(const EngineProcess&) = delete;
+
+        // False when the engine exited
+        bool send(const std::string& line);
+
+        // Next line of the engine, nullopt at the deadline or when the
+        // engine exited
+        std::optional<std::string> read_line(clock::time_point deadline);
+
+        // Skip the lines until the one starting with the word
+        std::optional<std::string> wait_for(const std::string& word,
+                                            clock::time_point deadline);
+
+        // Name given by the engine (id name), empty if it gave none
+        const std::string& name(void) const;
+
+    private:
+        // Quit and wait for the engine
+        void shutdown(void);
+
+        pid_t pid_ = -1;
+        int input_ = -1;
+        int output_ = -1;
+        // Read but not yet returned
+        std::string buffer_;
+        std::string name_;
+    };
+} // namespace match
@@ -0,0 +1,112 @@
+#include <boost/program_options.hpp>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+#include "match.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace boost::program_options;
+
+namespace
+{
+    // NAME=VALUE, the value may contain =
+    std::vector<std::pair<std::string, std::string>> engine_options(
+            const std::vector<std::string>& settings)
+    {
+        std::vector<std::pair<std::string, std::string>> options;
+        for (const auto& setting : settings)
+        {
+            const auto equal = setting.find('=');
+            if (equal == std::string::npos)
+                throw std::invalid_argument("invalid engine option "
+                                            + setting + ", NAME=VALUE "
+                                            "expected");
+            options.emplace_back(setting.substr(0, equal),
+                                 setting.substr(equal + 1));
+        }
+        return options;
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    try
+    {
+        match::Options options;
+        std::array<std::vector<std::string>, 2> settings;
+        std::string time_control;
+        match::Sprt sprt;
+
+        options_description desc{"Allowed options"};
+        desc.add_options()
+        ("help,h", "show usage")
+        ("engine1", value<std::string>(&options.engines[0].command)
+            ->required(), "command of the first engine, the tested one")
+        ("engine2", value<std::string>(&options.engines[1].command)
+            ->required(), "command of the second engine")
+        ("name1", value<std::string>(&options.engines[0].name),
+            "name of the first engine in the results")
+        ("name2", value<std::string>(&options.engines[1].name),
+            "name of the second engine in the results")
+        ("option1", value<std::vector<std::string>>(&settings[0])
+            ->composing(), "UCI option NAME=VALUE of the first engine")
+        ("option2", value<std::vector<std::string>>(&settings[1])
+            ->composing(), "UCI option NAME=VALUE of the second engine")
+        ("games,n", value<size_t>(&options.games)->default_value(1000),
+            "maximum number of games")
+        ("tc", value<std::string>(&time_control)->default_value("10+0.1"),
+            "time control of each side, BASE+INCREMENT in seconds")
+        ("depth,d", value<int>(), "fixed depth searches instead of the clock")
+        ("openings", value<std::string>(&options.openings),
+            "EPD file of the starting positions, each one played with "
+            "both colours")
+        ("pgn", value<std::string>(&options.pgn)->default_value("match.pgn"),
+            "PGN file where the games are appended")
+        ("max-plies", value<unsigned>(&options.max_plies)
+            ->default_value(600), "longer games are draws")
+        ("sprt", "stop once the SPRT is decided")
+        ("elo0", value<double>(&sprt.elo0)->default_value(0),
+            "SPRT elo difference of H0")
+        ("elo1", value<double>(&sprt.elo1)->default_value(5),
+            "SPRT elo difference of H1")
+        ("alpha", value<double>(&sprt.alpha)->default_value(0.05),
+            "SPRT false positive rate")
+        ("beta", value<double>(&sprt.beta)->default_value(0.05),
+            "SPRT false negative rate")
+        ("concurrency,c", value<unsigned>(&options.concurrency)
+            ->default_value(std::max(1u, std::thread::hardware_concurrency())),
+            "number of games played at the same time");
+
+        variables_map vm;
+        store(parse_command_line(argc, argv, desc), vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << "Usage: chess-match --engine1 CMD --engine2 CMD "
+                      << "[options]\n" << desc << '\n';
+            return 0;
+        }
+        notify(vm);
+
+        for (size_t i = 0; i < 2; ++i)
+            options.engines[i].options = engine_options(settings[i]);
+        options.time_control = match::parse_time_control(time_control);
+        if (vm.count("depth"))
+            options.depth = vm["depth"].as<int>();
+        if (vm.count("sprt"))
+            options.sprt = sprt;
+
+        // An engine may exit while it is written to
+        std::signal(SIGPIPE, SIG_IGN);
+        board::MoveInitialization::get_instance();
+        match::run_match(options, std::cout);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,421 @@
+#include "match.hh"
+
+#include <ctime>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "engine-process.hh"
+#include "chess_engine/board/chessboard.hh"
+#include "parsing/epd_parser/epd-parser.hh"
+#include "parsing/pgn_parser/ebnf-parser.hh"
+#include "parsing/pgn_parser/san.hh"
+
+using namespace board;
+
+namespace match
+{
+    namespace
+    {
+        using clock = EngineProcess::clock;
+
+        // Answers later than the clock by more than it lose on time
+        constexpr auto time_margin = std::chrono::milliseconds(100);
+        // Longest wait for a fixed depth search, or for readyok
+        constexpr auto answer_timeout = std::chrono::seconds(60);
+
+        std::vector<Opening> load_openings(const std::string& path)
+        {
+            if (path.empty())
+                return {Opening{Chessboard(), "startpos", ""}};
+
+            std::vector<Opening> openings;
+            for (const auto& record : epd_parser::parse_epd(path))
+            {
+                Opening opening{Chessboard::from_fen(record.fen), "", ""};
+                Chessboard::fen_buffer_t buffer;
+                opening.fen = std::string(opening.board.write_fen(buffer));
+                opening.position = "fen " + opening.fen;
+                openings.push_back(std::move(opening));
+            }
+            if (openings.empty())
+                throw std::invalid_argument(path + ": no opening");
+            return openings;
+        }
+
+        const char* result_string(const Result result)
+        {
+            switch (result)
+            {
+            case Result::WHITE_WINS:
+                return "1-0";
+            case Result::BLACK_WINS:
+                return "0-1";
+            default:
+                return "1/2-1/2";
+            }
+        }
+
+        std::unique_ptr<EngineProcess> start_engine(const EngineConfig& config)
+        {
+            auto engine = std::make_unique<EngineProcess>(config.command);
+            for (const auto& [name, value] : config.options)
+                engine->send("setoption name " + name + " value " + value);
+            return engine;
+        }
+
+        std::string go_command(const Options& options,
+                               const std::array<std::chrono::milliseconds,
+                                                2>& clocks)
+        {
+            if (options.depth.has_value())
+                return "go depth " + std::to_string(options.depth.value());
+
+            const auto increment = std::to_string(
+                    options.time_control.increment.count());
+            return "go wtime " + std::to_string(clocks[0].count())
+                   + " btime " + std::to_string(clocks[1].count())
+                   + " winc " + increment + " binc " + increment;
+        }
+
+        // players: white then black. Nullopt if the match was stopped.
+        std::optional<Game> play_game(
+                const std::array<EngineProcess*, 2>& players,
+                const Opening& opening, const Options& options,
+                const std::atomic<bool>& stopped)
+        {
+            Game game;
+            const auto forfeit = [&game](const size_t side,
+                                         const std::string& termination,
+                                         const std::string& reason)
+            {
+                game.result = side == 0 ? Result::BLACK_WINS
+                                        : Result::WHITE_WINS;
+                game.termination = termination;
+                game.reason = reason;
+                return game;
+            };
+
+            for (size_t side = 0; side < 2; ++side)
+            {
+                players[side]->send("ucinewgame");
+                players[side]->send("isready");
+                if (!players[side]->wait_for("readyok",
+                                             clock::now() + answer_timeout))
+                {
+                    game.hung = side;
+                    return forfeit(side, "abandoned", "engine not ready");
+                }
+            }
+
+            Chessboard board = opening.board;
+            std::string moves;
+            std::array<std::chrono::milliseconds, 2> clocks{
+                    options.time_control.base, options.time_control.base};
+            while (!stopped)
+            {
+                auto legal_moves = board.generate_legal_moves();
+                const bool is_check = board.is_check();
+                const size_t side = board.get_white_turn() ? 0 : 1;
+                if (board.is_checkmate(legal_moves, is_check))
+                    return forfeit(side, "normal", side == 0 ? "black mates"
+                                                            : "white mates");
+                if (board.is_draw(legal_moves, is_check))
+                {
+                    game.reason = board.is_pat(legal_moves, is_check)
+                            ? "stalemate"
+                            : board.get_halfmove_clock() >= 100
+                            ? "fifty moves rule" : "threefold repetition";
+                    return game;
+                }
+                if (game.sans.size() >= options.max_plies)
+                {
+                    game.termination = "adjudication";
+                    game.reason = "game too long";
+                    return game;
+                }
+
+                EngineProcess& player = *players[side];
+                player.send("position " + opening.position
+                            + (moves.empty() ? "" : " moves" + moves));
+                player.send(go_command(options, clocks));
+                const auto start = clock::now();
+                const auto answer = player.wait_for(
+                        "bestmove", options.depth.has_value()
+                                    ? start + answer_timeout
+                                    : start + clocks[side] + time_margin);
+                if (!answer.has_value())
+                {
+                    game.hung = side;
+                    return options.depth.has_value()
+                           ? forfeit(side, "abandoned", "no move")
+                           : forfeit(side, "time forfeit", "loses on time");
+                }
+                if (!options.depth.has_value())
+                {
+                    const auto elapsed = std::chrono::duration_cast<
+                            std::chrono::milliseconds>(clock::now() - start);
+                    clocks[side] = std::max(clocks[side] - elapsed,
+                                            std::chrono::milliseconds(0))
+                                   + options.time_control.increment;
+                }
+
+                std::istringstream words(answer.value());
+                std::string move_text;
+                words >> move_text >> move_text;
+                const auto move = std::find_if(
+                        legal_moves.begin(), legal_moves.end(),
+                        [&move_text](const Move& legal_move)
+                        {
+                            return pgn_parser::move_to_string(legal_move)
+                                   == move_text;
+                        });
+                if (move == legal_moves.end())
+                    return forfeit(side, "rules infraction",
+                                   "illegal move " + move_text);
+
+                game.sans.push_back(pgn_parser::move_to_san(board, *move));
+                board.do_move(*move);
+                moves += ' ' + move_text;
+            }
+            return std::nullopt;
+        }
+
+        std::string today(void)
+        {
+            const std::time_t now = std::time(nullptr);
+            std::tm local{};
+            localtime_r(&now, &local);
+            char date[16];
+            std::strftime(date, sizeof(date), "%Y.%m.%d", &local);
+            return date;
+        }
+
+        std::string quoted(const std::string& value)
+        {
+            std::string text = "\"";
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    text += '\\';
+                text += c;
+            }
+            return text + '"';
+        }
+
+        void write_score(std::ostream& os, const std::array<std::string,
+                                                           2>& names,
+                         const Score& score, const std::optional<Sprt>& sprt)
+        {
+            const auto estimate = elo_estimate(score);
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(3);
+            text << "Score of " << names[0] << " vs " << names[1] << ": "
+                 << score.wins << " - " << score.losses << " - "
+                 << score.draws << " [" << score.ratio() << "] "
+                 << score.games() << '\n';
+            text << std::setprecision(1) << "Elo difference: "
+                 << estimate.elo << " +/- " << estimate.error;
+            if (sprt.has_value())
+                text << std::setprecision(2) << ", LLR: "
+                     << sprt->llr(score) << " (" << sprt->lower_bound()
+                     << ", " << sprt->upper_bound() << ")";
+            os << text.str() << std::endl;
+        }
+    } // namespace
+
+    TimeControl parse_time_control(const std::string& text)
+    {
+        const auto seconds = [&text](const std::string& value)
+        {
+            size_t end = 0;
+            double parsed = -1;
+            try
+            {
+                parsed = std::stod(value, &end);
+            }
+            catch (const std::logic_error&)
+            {}
+            if (value.empty() || end != value.size() || parsed < 0)
+                throw std::invalid_argument("invalid time control " + text);
+            return std::chrono::milliseconds(
+                    static_cast<int64_t>(parsed * 1000));
+        };
+
+        const auto plus = text.find('+');
+        TimeControl time_control;
+        time_control.base = seconds(text.substr(0, plus));
+        time_control.increment = plus == std::string::npos
+                ? std::chrono::milliseconds(0)
+                : seconds(text.substr(plus + 1));
+        if (time_control.base.count() == 0)
+            throw std::invalid_argument("invalid time control " + text);
+        return time_control;
+    }
+
+    void write_pgn(std::ostream& os, const Game& game,
+                   const Opening& opening, const size_t round,
+                   const std::string& white, const std::string& black)
+    {
+        os << "[Event \"chess-match\"]\n"
+           << "[Site \"?\"]\n"
+           << "[Date \"" << today() << "\"]\n"
+           << "[Round \"" << round << "\"]\n"
+           << "[White " << quoted(white) << "]\n"
+           << "[Black " << quoted(black) << "]\n"
+           << "[Result \"" << result_string(game.result) << "\"]\n";
+        if (!opening.fen.empty())
+            os << "[SetUp \"1\"]\n"
+               << "[FEN \"" << opening.fen << "\"]\n";
+        os << "[Termination \"" << game.termination << "\"]\n\n";
+
+        std::vector<std::string> tokens;
+        unsigned number = opening.board.get_fullmove_number();
+        bool white_turn = opening.board.get_white_turn();
+        for (size_t ply = 0; ply < game.sans.size(); ++ply)
+        {
+            // A move number stays on the line of its move
+            if (white_turn)
+                tokens.push_back(std::to_string(number) + ". "
+                                 + game.sans[ply]);
+            else if (ply == 0)
+                tokens.push_back(std::to_string(number) + "... "
+                                 + game.sans[ply]);
+            else
+                tokens.push_back(game.sans[ply]);
+            number += !white_turn;
+            white_turn = !white_turn;
+        }
+        tokens.push_back('{' + game.reason + '}');
+        tokens.push_back(result_string(game.result));
+
+        // Lines of at most 80 characters
+        size_t width = 0;
+        for (const auto& token : tokens)
+        {
+            if (width > 0 && width + 1 + token.size() > 80)
+            {
+                os << '\n';
+                width = 0;
+            }
+            else if (width > 0)
+            {
+                os << ' ';
+                width++;
+            }
+            os << token;
+            width += token.size();
+        }
+        os << "\n\n";
+    }
+
+    Score run_match(const Options& options, std::ostream& report)
+    {
+        const auto openings = load_openings(options.openings);
+        std::ofstream pgn;
+        if (!options.pgn.empty())
+        {
+            pgn.open(options.pgn, std::ios::app);
+            if (!pgn)
+                throw std::runtime_error("cannot write " + options.pgn);
+        }
+        std::array<std::string, 2> names;
+        for (size_t i = 0; i < 2; ++i)
+            names[i] = options.engines[i].name.empty()
+                       ? options.engines[i].command
+                       : options.engines[i].name;
+
+        Score score;
+        std::atomic<size_t> next = 0;
+        std::atomic<bool> stopped = false;
+        std::mutex mutex;
+        std::exception_ptr error;
+        const auto worker = [&]()
+        {
+            try
+            {
+                // Kept from one game to the next
+                std::array<std::unique_ptr<EngineProcess>, 2> engines;
+                for (size_t i = next++; i < options.games && !stopped;
+                     i = next++)
+                {
+                    for (size_t e = 0; e < 2; ++e)
+                        if (engines[e] == nullptr)
+                            engines[e] = start_engine(options.engines[e]);
+
+                    // Both colours of an opening are played in a row, the
+                    // first engine playing white in the even games
+                    const Opening& opening = openings[i / 2
+                                                      % openings.size()];
+                    const size_t white = i % 2;
+                    const auto game = play_game(
+                            {engines[white].get(), engines[1 - white].get()},
+                            opening, options, stopped);
+                    if (!game.has_value())
+                        break;
+                    if (game->hung.has_value())
+                        engines[game->hung.value() == 0 ? white
+                                                        : 1 - white].reset();
+
+                    const std::lock_guard lock(mutex);
+                    // The games ended after the decision are not counted
+                    if (stopped)
+                        break;
+                    if (game->result == Result::DRAW)
+                        score.draws++;
+                    else if ((game->result == Result::WHITE_WINS)
+                             == (white == 0))
+                        score.wins++;
+                    else
+                        score.losses++;
+
+                    report << "Game " << i + 1 << " (" << names[white]
+                           << " vs " << names[1 - white] << "): "
+                           << result_string(game->result) << " {"
+                           << game->reason << "}\n";
+                    write_score(report, names, score, options.sprt);
+                    if (pgn.is_open())
+                        write_pgn(pgn, game.value(), opening, i + 1,
+                                  names[white], names[1 - white]);
+
+                    if (options.sprt.has_value())
+                    {
+                        const auto decision = options.sprt->decide(score);
+                        if (decision != Sprt::Decision::NONE)
+                        {
+                            report << "SPRT: "
+                                   << (decision == Sprt::Decision::H1
+                                       ? "H1" : "H0")
+                                   << " accepted" << std::endl;
+                            stopped = true;
+                        }
+                    }
+                }
+            }
+            catch (...)
+            {
+                const std::lock_guard lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+                stopped = true;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::max(1u, options.concurrency); ++t)
+            workers.emplace_back(worker);
+        for (auto& thread : workers)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+        return score;
+    }
+} // namespace match
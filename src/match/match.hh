@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <optional>
+
+#include "sprt.hh"
+#include "chess_engine/board/chessboard.hh"
+
+// Games between two UCI engines, eg: two builds of the engine, or the same
+// build with different options. The games are played concurrently, each
+// worker owning its own pair of engine processes. The chessboard of the
+// runner adjudicates every game, the engines only give their moves.
+namespace match
+{
+    struct EngineConfig
+    {
+        // Program followed by its arguments, separated by spaces
+        std::string command;
+        // In the PGN, the command when empty
+        std::string name;
+        // Sent with setoption before the first game
+        std::vector<std::pair<std::string, std::string>> options;
+    };
+
+    struct TimeControl
+    {
+        std::chrono::milliseconds base{10000};
+        std::chrono::milliseconds increment{100};
+    };
+
+    /* Format: BASE[+INCREMENT], in seconds
+    ** Eg:
+    ** - 10+0.1
+    ** - 60
+    ** Throws a std::invalid_argument if it is malformed
+    */
+    TimeControl parse_time_control(const std::string& text);
+
+    struct Options
+    {
+        std::array<EngineConfig, 2> engines;
+        TimeControl time_control;
+        // Fixed depth searches (go depth) instead of the clock
+        std::optional<int> depth;
+        size_t games = 1000;
+        unsigned concurrency = 1;
+        // EPD file of the starting positions, each one being played twice
+        // with the colours swapped. The initial position when empty.
+        std::string openings;
+        // Every game is appended, nothing is written when empty
+        std::string pgn;
+        // The match stops once the test is decided
+        std::optional<Sprt> sprt;
+        // Longer games are adjudicated as draws
+        unsigned max_plies = 600;
+    };
+
+    enum class Result
+    {
+        WHITE_WINS,
+        BLACK_WINS,
+        DRAW
+    };
+
+    struct Game
+    {
+        Result result = Result::DRAW;
+        // Termination tag of the PGN
+        std::string termination = "normal";
+        std::string reason;
+        std::vector<std::string> sans;
+        // Side of the engine which stopped answering, it has to be
+        // restarted: 0 for white, 1 for black
+        std::optional<size_t> hung;
+    };
+
+    struct Opening
+    {
+        board::Chessboard board;
+        // Of the position commands: startpos or fen FEN
+        std::string position;
+        // FEN tag of the PGN, empty for the initial position
+        std::string fen;
+    };
+
+    /*
+    ** Append the game to a PGN database: the seven tags, SetUp and FEN for
+    ** an opening other than the initial position, then the movetext in
+    ** lines of at most 80 characters, closed by the reason of the result.
+    */
+    void write_pgn(std::ostream& os, const Game& game,
+                   const Opening& opening, const size_t round,
+                   const std::string& white, const std::string& black);
+
+    /*
+    ** Play the games of the match, writing each result and the score of the
+    ** first engine to report as soon as it is known. Throws a
+    ** std::runtime_error if an engine cannot be started, and a
+    ** std::invalid_argument if the openings are malformed.
+    */
+    Score run_match(const Options& options, std::ostream& report);
+} // namespace match
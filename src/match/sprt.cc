@@ -0,0 +1,95 @@
+#include "sprt.hh"
+
+#include <cmath>
+#include <algorithm>
+
+namespace match
+{
+    namespace
+    {
+        // A perfect score is worth an infinite difference, the estimates
+        // are bounded by the one of the best score under 1000 games
+        constexpr double min_ratio = 0.001;
+
+        // Expected score of the stronger side of an elo difference
+        double expected_score(const double elo)
+        {
+            return 1 / (1 + std::pow(10, -elo / 400));
+        }
+
+        double elo_difference(const double ratio)
+        {
+            return 400 * std::log10(ratio / (1 - ratio));
+        }
+
+        // Variance of the points of a game
+        double variance(const Score& score)
+        {
+            const double mean = score.ratio();
+            const double games = score.games();
+            return (score.wins * (1 - mean) * (1 - mean)
+                    + score.draws * (0.5 - mean) * (0.5 - mean)
+                    + score.losses * mean * mean) / games;
+        }
+    } // namespace
+
+    size_t Score::games(void) const
+    {
+        return wins + draws + losses;
+    }
+
+    double Score::ratio(void) const
+    {
+        return games() == 0 ? 0.5 : (wins + draws / 2.0) / games();
+    }
+
+    EloEstimate elo_estimate(const Score& score)
+    {
+        if (score.games() == 0)
+            return EloEstimate{};
+
+        const auto bounded = [](const double ratio)
+        {
+            return std::clamp(ratio, min_ratio, 1 - min_ratio);
+        };
+
+        const double ratio = score.ratio();
+        const double deviation = std::sqrt(variance(score) / score.games());
+        const double low = elo_difference(bounded(ratio - 1.96 * deviation));
+        const double high = elo_difference(bounded(ratio + 1.96 * deviation));
+        return EloEstimate{elo_difference(bounded(ratio)), (high - low) / 2};
+    }
+
+    double Sprt::lower_bound(void) const
+    {
+        return std::log(beta / (1 - alpha));
+    }
+
+    double Sprt::upper_bound(void) const
+    {
+        return std::log((1 - beta) / alpha);
+    }
+
+    double Sprt::llr(const Score& score) const
+    {
+        // Nothing is known while every game has the same result
+        if (score.games() == 0 || variance(score) <= 0)
+            return 0;
+
+        const double score0 = expected_score(elo0);
+        const double score1 = expected_score(elo1);
+        return score.games() * (score1 - score0)
+               * (2 * score.ratio() - score0 - score1)
+               / (2 * variance(score));
+    }
+
+    Sprt::Decision Sprt::decide(const Score& score) const
+    {
+        const double ratio = llr(score);
+        if (ratio >= upper_bound())
+            return Decision::H1;
+        if (ratio <= lower_bound())
+            return Decision::H0;
+        return Decision::NONE;
+    }
+} // namespace match
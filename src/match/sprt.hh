@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+// Statistics of a match between two engines, from the point of view of the
+// first one. The sequential probability ratio test (SPRT) plays games until
+// the log-likelihood ratio of "the first engine is elo1 stronger" against
+// "it is elo0 stronger" leaves [lower_bound, upper_bound], so that a clear
+// difference is known after few games.
+namespace match
+{
+    struct Score
+    {
+        size_t wins = 0;
+        size_t draws = 0;
+        size_t losses = 0;
+
+        size_t games(void) const;
+        // Points per game, a draw being half a point
+        double ratio(void) const;
+    };
+
+    struct EloEstimate
+    {
+        double elo = 0;
+        // Half width of the 95% confidence interval
+        double error = 0;
+    };
+
+    EloEstimate elo_estimate(const Score& score);
+
+    struct Sprt
+    {
+        enum class Decision
+        {
+            NONE,
+            H0, // Not elo1 stronger, with a false negative rate of beta
+            H1  // At least elo1 stronger, with a false positive rate of alpha
+        };
+
+        double elo0 = 0;
+        double elo1 = 5;
+        double alpha = 0.05;
+        double beta = 0.05;
+
+        double lower_bound(void) const;
+        double upper_bound(void) const;
+
+        // Generalized SPRT of the trinomial model (win, draw, loss): the
+        // score is assumed normal with the variance of the games played
+        double llr(const Score& score) const;
+        Decision decide(const Score& score) const;
+    };
+} // namespace match
@@ -0,0 +1,134 @@
+#include "epd-parser.hh"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace epd_parser
+{
+    namespace
+    {
+        bool is_blank(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        void skip_blanks(std::string_view& line)
+        {
+            while (!line.empty() && is_blank(line.front()))
+                line.remove_prefix(1);
+        }
+
+        // Remove and return the next word, ended by a blank or a ';'
+        std::string_view next_word(std::string_view& line)
+        {
+            skip_blanks(line);
+            size_t end = 0;
+            while (end < line.size() && !is_blank(line[end])
+                   && line[end] != ';')
+                end++;
+            const std::string_view word = line.substr(0, end);
+            line.remove_prefix(end);
+            return word;
+        }
+    } // namespace
+
+    const std::vector<std::string>* EpdRecord::operation(
+            const std::string_view opcode) const
+    {
+        for (const auto& op : operations)
+            if (op.opcode == opcode)
+                return &op.operands;
+        return nullptr;
+    }
+
+    std::string EpdRecord::id(void) const
+    {
+        const auto* operands = operation("id");
+        return operands == nullptr || operands->empty() ? ""
+                                                        : operands->front();
+    }
+
+    EpdRecord parse_epd_line(std::string_view line)
+    {
+        const std::string text(line);
+        EpdRecord record;
+
+        for (int field = 0; field < 4; ++field)
+        {
+            const std::string_view word = next_word(line);
+            if (word.empty())
+                throw std::invalid_argument("incomplete EPD position: "
+                                            + text);
+            if (field > 0)
+                record.fen.push_back(' ');
+            record.fen.append(word);
+        }
+
+        while (true)
+        {
+            const std::string_view opcode = next_word(line);
+            if (opcode.empty())
+            {
+                if (line.empty())
+                    break;
+                throw std::invalid_argument("missing EPD opcode: " + text);
+            }
+
+            EpdOperation operation{std::string(opcode), {}};
+            while (true)
+            {
+                skip_blanks(line);
+                if (line.empty())
+                    break;
+                if (line.front() == ';')
+                {
+                    line.remove_prefix(1);
+                    break;
+                }
+
+                if (line.front() == '"')
+                {
+                    const size_t end = line.find('"', 1);
+                    if (end == std::string_view::npos)
+                        throw std::invalid_argument("unterminated EPD "
+                                                    "string: " + text);
+                    operation.operands.emplace_back(line.substr(1, end - 1));
+                    line.remove_prefix(end + 1);
+                }
+                else
+                    operation.operands.emplace_back(next_word(line));
+            }
+            record.operations.push_back(std::move(operation));
+        }
+
+        return record;
+    }
+
+    std::vector<EpdRecord> parse_epd(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+            throw std::invalid_argument("cannot open " + path);
+
+        std::vector<EpdRecord> records;
+        std::string line;
+        for (size_t number = 1; std::getline(file, line); ++number)
+        {
+            std::string_view view = line;
+            skip_blanks(view);
+            if (view.empty() || view.front() == '#')
+                continue;
+
+            try
+            {
+                records.push_back(parse_epd_line(view));
+            }
+            catch (const std::invalid_argument& error)
+            {
+                throw std::invalid_argument(path + ":" + std::to_string(number)
+                                            + ": " + error.what());
+            }
+        }
+        return records;
+    }
+} // namespace epd_parser
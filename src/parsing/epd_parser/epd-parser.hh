@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+namespace epd_parser
+{
+    // An operation of an EPD record, eg: bm Nf3 Qd2; or id "WAC.001";
+    struct EpdOperation
+    {
+        std::string opcode;
+        // Quotes are removed from string operands
+        std::vector<std::string> operands;
+    };
+
+    struct EpdRecord
+    {
+        // Piece placement, side to move, castling and en passant fields
+        std::string fen;
+        std::vector<EpdOperation> operations;
+
+        // Operands of the first operation with this opcode, if any
+        const std::vector<std::string>* operation(std::string_view opcode)
+            const;
+
+        // Value of the id operation, empty when there is none
+        std::string id(void) const;
+    };
+
+    // Parse an EPD line, throws a std::invalid_argument if it is malformed
+    EpdRecord parse_epd_line(std::string_view line);
+
+    // Records of an EPD file, blank lines and lines starting with # are
+    // skipped. Throws a std::invalid_argument naming the faulty line.
+    std::vector<EpdRecord> parse_epd(const std::string& path);
+} // namespace epd_parser
@@ -4,15 +4,23 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <thread>
+#include <stdexcept>
 #include <dlfcn.h>
 
 #include "chess_engine/board/move-initialization.hh"
 #include "chess_engine/ai/ai-launcher.hh"
+#include "chess_engine/ai/bench.hh"
+#include "chess_engine/ai/epd-suite.hh"
+#include "chess_engine/ai/gensfen.hh"
+#include "chess_engine/book/book-builder.hh"
 #include "listener/listener.hh"
 #include "listener/listener-manager.hh"
 #include "parsing/pgn_parser/pgn-parser.hh"
+#include "parsing/pgn_parser/pgn-validation.hh"
 #include "parsing/perft_parser/perft-object.hh"
 #include "parsing/perft_parser/perft-parser.hh"
+#include "utils/trace.hh"
 
 using namespace boost::program_options;
 
@@ -94,13 +102,62 @@ namespace option_parser
                   << std::endl;
     }
 
+    // Format: bench [depth] [threads]
+    static void on_bench(int argc, const char* argv[])
+    {
+        const auto parse = [](const std::string& arg)
+        {
+            size_t end = 0;
+            int value = 0;
+            try
+            {
+                value = std::stoi(arg, &end);
+            }
+            catch (const std::logic_error&)
+            {}
+            if (end != arg.size() || value <= 0)
+                throw std::invalid_argument("bench: bad argument " + arg);
+            return value;
+        };
+
+        if (argc > 4)
+            throw std::invalid_argument("usage: bench [depth] [threads]");
+        const int16_t depth = argc > 2 ? parse(argv[2])
+                                       : ai::bench_default_depth;
+        const unsigned threads = argc > 3 ? parse(argv[3]) : 1;
+
+        board::MoveInitialization::get_instance();
+        ai::bench(depth, threads, std::cout);
+    }
+
     void handle_input_option(int argc, const char* argv[])
     {
+        if (argc > 1 && std::string(argv[1]) == "bench")
+        {
+            try
+            {
+                on_bench(argc, argv);
+            }
+            catch (const std::invalid_argument& ex)
+            {
+                std::cerr << ex.what() << '\n';
+            }
+            return;
+        }
+
         listener::ListenerManager manager;
         try
         {
-            std::string pgn_path, perft_path;
-            std::vector<std::string> listeners_path;
+            std::string pgn_path, perft_path, book_path, epd_path;
+            std::string trace_path, gensfen_path;
+            std::vector<std::string> listeners_path, book_sources;
+            std::vector<std::string> validate_paths;
+            book::BuilderOptions book_options;
+            ai::EpdOptions epd_options;
+            ai::GensfenOptions gensfen_options;
+            uint64_t gensfen_nodes = 0;
+            unsigned movetime = 0;
+            unsigned threads = 1;
 
             options_description desc{"Allowed options"};
             desc.add_options()
@@ -108,23 +165,96 @@ namespace option_parser
             ("pgn", value<std::string>(&pgn_path), "path to the PGN game file")
             ("listeners,l", value<std::vector<std::string>>(&listeners_path),
                 "list of paths to listener plugins")
-            ("perft", value<std::string>(&perft_path), "path to a perft file");
+            ("perft", value<std::string>(&perft_path), "path to a perft file")
+            ("epd", value<std::string>(&epd_path),
+                "path to an EPD test suite to solve")
+            ("depth", value<int16_t>(&epd_options.limits.depth),
+                "deepest search of each EPD position")
+            ("movetime", value<unsigned>(&movetime),
+                "milliseconds of search for each EPD position (default 1000 "
+                "without --depth)")
+            ("validate", value<std::vector<std::string>>(&validate_paths)
+                ->multitoken(),
+                "PGN files or directories whose games are checked")
+            ("build-book", value<std::vector<std::string>>(&book_sources)
+                ->multitoken(),
+                "PGN files or directories to build a Polyglot book from")
+            ("book-output", value<std::string>(&book_path)
+                ->default_value("book.bin"), "path of the built book")
+            ("book-plies", value<unsigned>(&book_options.plies)
+                ->default_value(16), "plies of each game added to the book")
+            ("book-min-games", value<uint32_t>(&book_options.min_games)
+                ->default_value(1), "games needed to keep a book move")
+            ("gensfen", value<std::string>(&gensfen_path),
+                "path of the training positions generated by self-play")
+            ("gensfen-positions", value<uint64_t>(&gensfen_options.positions)
+                ->default_value(gensfen_options.positions),
+                "number of generated positions")
+            ("gensfen-depth", value<int16_t>(&gensfen_options.limits.depth)
+                ->default_value(gensfen_options.limits.depth),
+                "deepest search of each move of the self-play games")
+            ("gensfen-nodes", value<uint64_t>(&gensfen_nodes),
+                "nodes of the search of each move, by 1024 (no limit by "
+                "default)")
+            ("threads,t", value<unsigned>(&threads)
+                ->default_value(std::max(1u,
+                                std::thread::hardware_concurrency())),
+                "number of worker threads")
+            ("trace", value<std::string>(&trace_path),
+                "write a Chrome trace of the run (build_trace builds only)");
 
             variables_map vm;
             store(parse_command_line(argc, argv, desc), vm);
             notify(vm);
 
             if (vm.count("help"))
-                std::cout << desc << '\n'; // print help message
+                std::cout << desc << "\nbench [depth] [threads]: search "
+                          << ai::bench_size() << " positions and print "
+                          << "the node count and the speed\n";
             else
             {
                 board::MoveInitialization::get_instance();
+                if (vm.count("trace"))
+                {
+                    if (utils::trace::enabled())
+                        utils::trace::flush_at_exit(trace_path);
+                    else
+                        std::cerr << "--trace: built without CHESS_TRACE, "
+                                  << "use a build_trace directory\n";
+                }
                 if (vm.count("listeners"))
                     load_listerners(listeners_path, manager);
                 if (vm.count("pgn"))
                     manager.play_pgn_moves(pgn_parser::parse_pgn(pgn_path));
                 else if (vm.count("perft"))
                     on_perft(perft_path);
+                else if (vm.count("epd"))
+                {
+                    if (!vm.count("movetime") && !vm.count("depth"))
+                        movetime = 1000;
+                    if (movetime > 0)
+                        epd_options.limits.movetime =
+                                std::chrono::milliseconds(movetime);
+                    epd_options.threads = threads;
+                    std::cout << ai::run_epd(epd_path, epd_options,
+                                             std::cout);
+                }
+                else if (vm.count("validate"))
+                    std::cout << pgn_parser::validate_games(
+                            validate_paths, threads, std::cout);
+                else if (vm.count("build-book"))
+                {
+                    book_options.threads = threads;
+                    book::build_book(book_sources, book_path, book_options);
+                }
+                else if (vm.count("gensfen"))
+                {
+                    if (gensfen_nodes > 0)
+                        gensfen_options.limits.nodes = gensfen_nodes;
+                    gensfen_options.threads = threads;
+                    std::cout << ai::gensfen(gensfen_path, gensfen_options,
+                                             std::cout);
+                }
                 else
                     ai::play_ai();
             }
@@ -133,5 +263,13 @@ namespace option_parser
         {
             std::cerr << ex.what() << '\n';
         }
+        catch (const std::invalid_argument& ex)
+        {
+            std::cerr << ex.what() << '\n';
+        }
+        catch (const std::runtime_error& ex)
+        {
+            std::cerr << ex.what() << '\n';
+        }
     }
 }
\ No newline at end of file
@@ -38,13 +38,11 @@ namespace perft_parser
         std::vector<std::string> ranks;
         boost::split(ranks, splited_input.at(0), boost::is_any_of("/"));
 
-        // TODO find more opti than that
-        // Need to push front since ranks are given from 8 to 1
+        // Ranks are given from 8 to 1
         std::vector<FenRank> franks;
-        for (const std::string& rank : ranks)
-        {
-            franks.insert(franks.begin(), FenRank(rank));
-        }
+        franks.reserve(ranks.size());
+        for (auto rank = ranks.rbegin(); rank != ranks.rend(); ++rank)
+            franks.emplace_back(*rank);
 
         // Color
         board::Color side_to_move = ((splited_input.at(1)[0] == 'w')
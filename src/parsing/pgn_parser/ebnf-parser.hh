@@ -19,7 +19,7 @@ namespace pgn_parser
 {
     using opt_piece_t = std::optional<PieceType>;
 
-    std::string move_to_string(const board::Move& move)
+    inline std::string move_to_string(const board::Move& move)
     {
         std::string result;
         result.push_back((char)(utils::utype(move.get_start().get_file())
@@ -72,7 +72,7 @@ namespace pgn_parser
         return PieceType::KING;
     }
 
-    board::Move string_to_move(const board::Chessboard& chessboard,
+    inline board::Move string_to_move(const board::Chessboard& chessboard,
                                const std::string& str_move)
     {
         assert(str_move.size() == 4 || str_move.size() == 5);
@@ -129,39 +129,7 @@ namespace pgn_parser
                     queen_castling, king_castling, en_passant, promotion);
     }
 
-    void add_move_to_board(board::Chessboard& chessboard,
-                           const std::string& string_board)
-    {
-        static bool first = true;
-        static constexpr std::string_view startpos = "startpos";
-        static constexpr std::string_view move_str = "moves";
-        std::vector<std::string> tokens;
-        boost::split(tokens, string_board, boost::is_any_of(" "));
-        assert(tokens.size() >= 2);
-
-        if (first)
-        {
-            if (tokens.at(1) != startpos) // Init with a fenstring
-            {
-                constexpr int fen_size = 6;
-                std::vector<std::string> fenstring;
-                for (int i = 2; i < 2 + fen_size; ++i)
-                    fenstring.emplace_back(tokens.at(i));
-                chessboard = Chessboard(perft_parser::parse_fen(fenstring));
-            }
-        }
-
-        if ((tokens.size() > 2 && tokens.at(1) == startpos
-             && tokens.at(2) == move_str) // Case position start_pos moves
-            || (tokens.size() > 8 && tokens.at(8) == move_str))
-                // Case position fen_string param param param moves
-        {
-            const std::string last_move = tokens.back();
-            chessboard.do_move(string_to_move(chessboard, last_move));
-        }
-    }
-
-    std::optional<int16_t> get_depth(const std::string& go_str)
+    inline std::optional<int16_t> get_depth(const std::string& go_str)
     {
         static constexpr std::string_view depth_str = "depth";
         std::vector<std::string> tokens;
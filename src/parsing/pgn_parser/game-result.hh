@@ -0,0 +1,13 @@
+#pragma once
+
+namespace pgn_parser
+{
+    // Termination marker of the movetext
+    enum class GameResult
+    {
+        WHITE_WIN,
+        BLACK_WIN,
+        DRAW,
+        UNKNOWN, // "*": game in progress or abandoned
+    };
+} // namespace pgn_parser
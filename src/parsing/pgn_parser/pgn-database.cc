@@ -0,0 +1,89 @@
+#include "pgn-database.hh"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "pgn-exception.hh"
+
+namespace pgn_parser
+{
+    std::vector<std::string> find_pgn_files(
+            const std::vector<std::string>& paths)
+    {
+        namespace fs = std::filesystem;
+        std::vector<std::string> files;
+        for (const auto& path : paths)
+        {
+            std::error_code error;
+            if (!fs::is_directory(path, error))
+            {
+                files.push_back(path);
+                continue;
+            }
+
+            for (const auto& file : fs::recursive_directory_iterator(path,
+                                                                     error))
+                if (file.is_regular_file()
+                    && file.path().extension() == ".pgn")
+                    files.push_back(file.path().string());
+        }
+
+        // Same order whatever the order of the directory entries
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    PgnDatabase::PgnDatabase(const std::vector<std::string>& paths)
+        : files_(find_pgn_files(paths))
+    {}
+
+    bool PgnDatabase::next(DatabaseGame& game)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        game.view.tags.clear();
+        game.view.moves.clear();
+        game.error.reset();
+        while (true)
+        {
+            try
+            {
+                if (reader_ == nullptr)
+                {
+                    if (next_file_ == files_.size())
+                        return false;
+                    game_index_ = 0;
+                    reader_ = std::make_shared<PgnReader>(
+                            files_[next_file_++]);
+                }
+
+                if (reader_->next(game.view))
+                {
+                    game.reader = reader_;
+                    game.file = next_file_ - 1;
+                    game.index = game_index_++;
+                    return true;
+                }
+                reader_.reset();
+            }
+            catch (const PgnParsingException& error)
+            {
+                // The reader has skipped to the next game, if any
+                game.reader = reader_;
+                game.file = next_file_ - 1;
+                game.index = game_index_++;
+                game.error = error.what();
+                return true;
+            }
+        }
+    }
+
+    const std::string& PgnDatabase::get_file(const size_t file) const
+    {
+        return files_[file];
+    }
+
+    size_t PgnDatabase::get_file_count(void) const
+    {
+        return files_.size();
+    }
+} // namespace pgn_parser
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+
+#include "pgn-reader.hh"
+
+namespace pgn_parser
+{
+    // PGN files of the paths, directories are walked recursively
+    std::vector<std::string> find_pgn_files(
+            const std::vector<std::string>& paths);
+
+    // A game handed out by a PgnDatabase
+    struct DatabaseGame
+    {
+        // Keeps the views of the game alive
+        std::shared_ptr<PgnReader> reader;
+        PgnGameView view;
+        // Index of the file in the database and of the game in the file
+        size_t file = 0;
+        size_t index = 0;
+        // Set when the game (or the whole file) could not be read, the
+        // view is then incomplete
+        std::optional<std::string> error;
+    };
+
+    /*
+    ** Games of a set of PGN files, read one after the other, and shared by
+    ** several threads: tokenizing is cheap next to replaying, so a single
+    ** reader serves all the workers.
+    */
+    class PgnDatabase
+    {
+    public:
+        explicit PgnDatabase(const std::vector<std::string>& paths);
+
+        // Next game of the files, thread safe
+        // Return false once every game has been read
+        bool next(DatabaseGame& game);
+
+        const std::string& get_file(size_t file) const;
+        size_t get_file_count(void) const;
+
+    private:
+        std::mutex mutex_;
+        const std::vector<std::string> files_;
+        size_t next_file_ = 0;
+        std::shared_ptr<PgnReader> reader_;
+        size_t game_index_ = 0;
+    };
+} // namespace pgn_parser
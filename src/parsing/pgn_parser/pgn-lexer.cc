@@ -0,0 +1,105 @@
+#include "pgn-lexer.hh"
+
+#include <array>
+#include <cstdint>
+
+namespace pgn_parser::lexer
+{
+    namespace
+    {
+        enum CharClass : uint8_t
+        {
+            PIECE = 1 << 0,     // K Q B N R
+            PROMOTION = 1 << 1, // Q B N R
+            FILE = 1 << 2,      // a to h
+            RANK = 1 << 3,      // 1 to 8
+            DIGIT = 1 << 4,     // 0 to 9
+            SEPARATOR = 1 << 5, // x -
+            REPORT = 1 << 6,    // + #
+        };
+
+        constexpr std::array<uint8_t, 256> make_classes(void)
+        {
+            std::array<uint8_t, 256> classes{};
+            for (const char c : {'K', 'Q', 'B', 'N', 'R'})
+                classes[c] |= PIECE;
+            for (const char c : {'Q', 'B', 'N', 'R'})
+                classes[c] |= PROMOTION;
+            for (char c = 'a'; c <= 'h'; ++c)
+                classes[c] |= FILE;
+            for (char c = '1'; c <= '8'; ++c)
+                classes[c] |= RANK;
+            for (char c = '0'; c <= '9'; ++c)
+                classes[c] |= DIGIT;
+            classes['x'] |= SEPARATOR;
+            classes['-'] |= SEPARATOR;
+            classes['+'] |= REPORT;
+            classes['#'] |= REPORT;
+            return classes;
+        }
+
+        constexpr std::array<uint8_t, 256> classes = make_classes();
+
+        bool is(const char c, const uint8_t char_class)
+        {
+            return classes[static_cast<unsigned char>(c)] & char_class;
+        }
+
+        // Remove the optional trailing + or #
+        std::string_view strip_report(std::string_view word)
+        {
+            if (!word.empty() && is(word.back(), REPORT))
+                word.remove_suffix(1);
+            return word;
+        }
+    } // namespace
+
+    bool is_san_move(std::string_view word)
+    {
+        word = strip_report(word);
+
+        // Promotion suffix
+        const size_t size = word.size();
+        if (size >= 2 && word[size - 2] == '=')
+        {
+            if (!is(word[size - 1], PROMOTION))
+                return false;
+            word.remove_suffix(2);
+        }
+
+        // Destination square
+        const size_t end = word.size();
+        if (end < 2 || !is(word[end - 2], FILE) || !is(word[end - 1], RANK))
+            return false;
+
+        // Optional piece, start file, start rank and separator, in order
+        // The classes are disjoint so each one is matched at most once
+        size_t i = 0;
+        for (const uint8_t char_class : {PIECE, FILE, RANK, SEPARATOR})
+            if (i < end - 2 && is(word[i], char_class))
+                i++;
+        return i == end - 2;
+    }
+
+    bool is_castling(std::string_view word)
+    {
+        word = strip_report(word);
+        return word == "O-O" || word == "O-O-O";
+    }
+
+    bool is_turn_number(const std::string_view word)
+    {
+        if (word.empty())
+            return false;
+        for (const char c : word)
+            if (!is(c, DIGIT))
+                return false;
+        return true;
+    }
+
+    bool is_tag_line(const std::string_view line)
+    {
+        return line.size() >= 2 && line.front() == '['
+               && line.back() == ']';
+    }
+} // namespace pgn_parser::lexer
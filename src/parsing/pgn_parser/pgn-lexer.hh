@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string_view>
+
+/*
+** Recognizers of the PGN tokens, without regular expressions. Each one is a
+** single left to right pass over the token, driven by a table of character
+** classes.
+*/
+namespace pgn_parser::lexer
+{
+    // Standard algebraic move, as matched by
+    // [KQBNR]?[a-h]?[1-8]?[x-]?[a-h][1-8](=[QBNR])?[+#]?
+    bool is_san_move(std::string_view word);
+
+    // O-O or O-O-O, followed by at most one + or #
+    bool is_castling(std::string_view word);
+
+    // One or more digits
+    bool is_turn_number(std::string_view word);
+
+    // A whole line between brackets, eg: [Event "?"]
+    bool is_tag_line(std::string_view line);
+} // namespace pgn_parser::lexer
@@ -1,10 +1,11 @@
 #include "pgn-parser.hh"
 
-#include <fstream>
-#include <regex>
+#include <algorithm>
 #include <iostream>
 
 #include "pgn-exception.hh"
+#include "pgn-lexer.hh"
+#include "san.hh"
 #include "chess_engine/board/entity/piece-type.hh"
 
 namespace pgn_parser
@@ -19,26 +20,15 @@ namespace pgn_parser
         return static_cast<board::Rank>(symbol - '1');
     }
 
-    /*
-    ** parse end of game. return false if it's not
-    ** a valid end
-    */
-    bool parse_end(const std::string& word)
-    {
-        return word == "1/2-1/2" || word == "1-0" || word == "0-1"
-            || word == "*";
-    }
-
     /*
     ** Parse move-text.
     ** An exception is thrown if there are syntax errors
     */
     void parse_action(const std::string& word)
     {
-        std::regex san_regex{
-            "[KQBNR]?[a-h]?[1-8]?[x-]?[a-h][1-8](=[QBNR])?[+#]?"};
-        if (!std::regex_match(word, san_regex) /* not a standard move */
-            && word[0] != 'O' /* not a castling */)
+        if (!lexer::is_san_move(word) /* not a standard move */
+            && word[0] != 'O' /* not a castling */
+            && word.compare(0, 3, "0-0") != 0 /* castling with zeros */)
             throw pgn_parser::PgnParsingException("syntax error", word);
     }
 
@@ -64,15 +54,13 @@ namespace pgn_parser
     /* simply parse turn number token */
     void parse_turn_number(const std::string& word)
     {
-        std::regex number_regex{"[[:digit:]]+"};
-        if (!std::regex_match(word, number_regex))
+        if (!lexer::is_turn_number(word))
             throw pgn_parser::PgnParsingException("wrong turn number", word);
     }
 
     board::PgnMove parse_castling(const std::string& word, board::Color side)
     {
-        std::regex castling_regex{"O-O(-O)?[+#]{0,1}"};
-        if (!std::regex_match(word, castling_regex))
+        if (!lexer::is_castling(word))
             throw pgn_parser::PgnParsingException("bad castling", word);
 
         /*
@@ -96,69 +84,6 @@ namespace pgn_parser
         return ReportType::NONE;
     }
 
-    // parse the header of a pgn file as a string
-    const std::string parse_header(std::ifstream& pgn)
-    {
-        std::string header_part;
-        std::regex header_regex{"\\[.*\\]"};
-
-        while (std::getline(pgn, header_part, '\n'))
-        {
-            if (!header_part.empty()
-                && !std::regex_match(header_part, header_regex))
-            {
-                pgn.seekg(-header_part.length() - 1, pgn.cur);
-                break;
-            }
-        }
-        return header_part;
-    }
-
-    // parse the body of a pgn file as a list of string
-    const std::vector<std::string> parse_body(std::ifstream& pgn)
-    {
-        /* tokenize everything */
-        std::vector<std::string> tokens;
-        std::string token;
-
-        while (pgn >> token)
-        {
-            std::stringstream ss{token};
-            std::string sub_token;
-
-            while (std::getline(ss, sub_token, '.'))
-                if (sub_token.length())
-                    tokens.push_back(sub_token);
-        }
-
-        /* separating tokens in number | move | end */
-        std::vector<std::string> moves_txt;
-        unsigned idx = 0;
-
-        try
-        {
-            for (const auto& tok : tokens)
-            {
-                if (parse_end(tok))
-                    break;
-                else if (idx++ % 3 == 0)
-                    parse_turn_number(tok);
-                else
-                {
-                    /* it should be an action */
-                    parse_action(tok);
-                    moves_txt.push_back(tok);
-                }
-            }
-        } catch (const pgn_parser::PgnParsingException& parse_error)
-        {
-            std::cerr << parse_error.what() << '\n';
-            std::exit(1);
-        }
-
-        return moves_txt;
-    }
-
     // convert a list of string into a list of move
     const std::vector<board::PgnMove>
     string_to_move(const std::vector<std::string>& body)
@@ -179,6 +104,32 @@ namespace pgn_parser
         using Position = board::Position;
         using Color = board::Color;
 
+        // Once a move is illegal, the game cannot go on
+        if (illegal_move_)
+            return;
+
+        try
+        {
+            const board::Move move = san_to_move(board_, word);
+            moves_.emplace_back(move.get_start(), move.get_end(),
+                                move.get_piece(), move.get_capture(),
+                                parse_report(word), move.get_promotion(),
+                                move.get_queen_castling(),
+                                move.get_king_castling());
+            board_.do_move(move);
+            side_ = side_ == Color::WHITE ? Color::BLACK : Color::WHITE;
+            return;
+        } catch (const pgn_parser::PgnParsingException&)
+        {
+            /*
+            ** An illegal move is kept when it can be built from the word
+            ** alone, so that playing the game reports it
+            */
+            if (word.front() != 'O' && !has_start_square(word))
+                throw;
+            illegal_move_ = true;
+        }
+
         if (word.front() == 'O')
         {
             try
@@ -222,6 +173,18 @@ namespace pgn_parser
         side_ = side_ == Color::WHITE ? Color::BLACK : Color::WHITE;
     }
 
+    bool MoveTextParser::has_start_square(const std::string& word)
+    {
+        // Skip the piece, the start square is followed by the end one
+        const size_t i =
+                parse_piecetype(word.front()) == board::PieceType::PAWN ? 0 : 1;
+        return word.size() >= i + 4 && word[i] >= 'a' && word[i] <= 'h'
+               && word[i + 1] >= '1' && word[i + 1] <= '8'
+               && (word[i + 2] == 'x' || word[i + 2] == '-'
+                   || (word[i + 2] >= 'a' && word[i + 2] <= 'h'))
+               && lexer::is_san_move(word.substr(i + 2));
+    }
+
     const std::vector<board::PgnMove> MoveTextParser::moves_get()
     {
         return moves_;
@@ -229,12 +192,30 @@ namespace pgn_parser
 
     const std::vector<board::PgnMove> parse_pgn(const std::string& file)
     {
-        std::ifstream pgn(file);
-        parse_header(pgn);
-
-        auto body = parse_body(pgn);
+        try
+        {
+            // The views of the game point into the reader
+            PgnReader reader(file);
+            PgnGameView game;
+            if (!reader.next(game))
+                throw pgn_parser::PgnParsingException("no game", file);
+            return parse_game(game).moves;
+        } catch (const pgn_parser::PgnParsingException& parse_error)
+        {
+            std::cerr << parse_error.what() << '\n';
+            std::exit(1);
+        }
+    }
 
-        auto moves = string_to_move(body);
-        return moves;
+    const PgnGame parse_game(const PgnGameView& game)
+    {
+        std::vector<std::string> body;
+        body.reserve(game.moves.size());
+        for (const auto move : game.moves)
+        {
+            body.emplace_back(move);
+            parse_action(body.back());
+        }
+        return PgnGame{string_to_move(body), game.result};
     }
 } // namespace pgn_parser
@@ -3,18 +3,39 @@
 #include <string>
 #include <vector>
 
+#include "chess_engine/board/chessboard.hh"
+#include "game-result.hh"
 #include "pgn-move.hh"
+#include "pgn-reader.hh"
 #include "report-type.hh"
 
 namespace pgn_parser
 {
-    // parse a PGN file into a list of moves
+    struct PgnGame
+    {
+        std::vector<board::PgnMove> moves;
+        GameResult result = GameResult::UNKNOWN;
+    };
+
+    /*
+    ** parse the first game of a PGN file into a list of moves, with
+    ** PgnReader. Syntax errors are written to stderr and exit
+    */
     const std::vector<board::PgnMove> parse_pgn(const std::string& file);
 
+    /*
+    ** convert a game of a PgnReader into its moves and result. Syntax
+    ** errors throw a PgnParsingException
+    */
+    const PgnGame parse_game(const PgnGameView& game);
+
     /*
     ** Functor class used to parse the pgn part associated with
-    ** moves. It's used by the main parse function 'parse_pgn' to
+    ** moves. It's used by the parse function 'parse_game' to
     ** translate standard algebraic notation to Move objects.
+    ** The moves are replayed from the initial position to resolve
+    ** short SAN (see san.hh). A PgnParsingException is thrown if a
+    ** move cannot be resolved.
     */
     class MoveTextParser
     {
@@ -31,9 +52,14 @@ namespace pgn_parser
     private:
         board::Color side_ = board::Color::WHITE;
         std::vector<board::PgnMove> moves_;
+        // Position of the game, the SAN moves are resolved against it
+        board::Chessboard board_;
+        bool illegal_move_ = false;
 
         /* Auxiliary functions */
         board::PgnMove::opt_piece_t parse_promotion(char promotion);
+        // Long notation, eg: Ng1-f3 or e2e4
+        static bool has_start_square(const std::string& word);
     };
 
     // Convert a character into a File
@@ -42,11 +68,6 @@ namespace pgn_parser
     // Convert a character into a rank
     board::Rank to_rank(char symbol);
 
-    /* Parse a string, deduce if a move induce a check,
-    ** a checkmate or nothing
-    */
-    bool parse_end(const std::string& word);
-
     /*
     ** Check is a string is a move and throw a exception
     ** if it is not
@@ -73,17 +94,6 @@ namespace pgn_parser
     */
     ReportType parse_report(const std::string& word);
 
-    /*
-    ** Parse the header of a pgn. It is only to move
-    ** forward our reader
-    */
-    const std::string parse_header(std::ifstream& pgn);
-
-    /*
-    ** Parse the body of a pgn file and extract each move
-    */
-    const std::vector<std::string> parse_body(std::ifstream& pgn);
-
     /*
     ** Convert a vector of string that represent the moves of
     ** the pgn into a vector of PgnMove
@@ -0,0 +1,255 @@
+#include "pgn-reader.hh"
+
+#include <cctype>
+#include <filesystem>
+
+#include "pgn-exception.hh"
+
+namespace pgn_parser
+{
+    namespace
+    {
+        // Characters of a symbol token, as defined by the PGN standard
+        bool is_symbol_char(const char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_'
+                   || c == '+' || c == '#' || c == '=' || c == ':'
+                   || c == '-' || c == '/';
+        }
+
+        bool is_digit(const char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        bool is_result(const std::string_view symbol)
+        {
+            return symbol == "1-0" || symbol == "0-1" || symbol == "1/2-1/2";
+        }
+
+        // Castling written with zeros, as san_to_move accepts it:
+        // 0-0 and 0-0-0, with their check or annotation suffix
+        bool is_zero_castling(const std::string_view symbol)
+        {
+            return symbol.substr(0, 3) == "0-0";
+        }
+
+        GameResult to_result(const std::string_view symbol)
+        {
+            if (symbol == "1-0")
+                return GameResult::WHITE_WIN;
+            if (symbol == "0-1")
+                return GameResult::BLACK_WIN;
+            return GameResult::DRAW;
+        }
+    } // namespace
+
+    std::optional<std::string_view> PgnGameView::tag(
+            const std::string_view name) const
+    {
+        for (const auto& t : tags)
+            if (t.name == name)
+                return t.value;
+        return std::nullopt;
+    }
+
+    PgnReader::PgnReader(const std::string& path)
+    {
+        if (file_.open(path, utils::MappedFile::Access::SEQUENTIAL))
+        {
+            text_ = std::string_view(
+                    reinterpret_cast<const char*>(file_.data()),
+                    file_.size());
+            return;
+        }
+
+        // Empty files cannot be mapped but hold no game either
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(path, error)
+            || std::filesystem::file_size(path, error) != 0)
+            throw PgnParsingException("cannot read file", path);
+    }
+
+    PgnReader::PgnReader(TextTag, const std::string_view text)
+        : text_(text)
+    {}
+
+    PgnReader PgnReader::from_text(const std::string_view text)
+    {
+        return PgnReader(TextTag{}, text);
+    }
+
+    size_t PgnReader::get_game_count(void) const
+    {
+        return game_count_;
+    }
+
+    bool PgnReader::next(PgnGameView& game)
+    {
+        game.tags.clear();
+        game.moves.clear();
+        game.result = GameResult::UNKNOWN;
+
+        bool in_game = false;
+        bool in_movetext = false;
+        try
+        {
+            while (true)
+            {
+                skip_whitespace();
+                if (pos_ >= text_.size())
+                    break;
+
+                const char c = text_[pos_];
+                if (c == '[')
+                {
+                    // Tags of the next game, the result was missing
+                    if (in_movetext)
+                        break;
+                    game.tags.push_back(read_tag());
+                    in_game = true;
+                }
+                else if (c == '%' && (pos_ == 0 || text_[pos_ - 1] == '\n'))
+                    skip_line();
+                else if (c == ';')
+                    skip_line();
+                else if (c == '{')
+                    skip_comment();
+                else if (c == '(')
+                    skip_variation();
+                else if (c == '$')
+                {
+                    ++pos_;
+                    while (pos_ < text_.size() && is_digit(text_[pos_]))
+                        ++pos_;
+                }
+                else if (c == '.' || c == '!' || c == '?')
+                    ++pos_;
+                else if (c == '*')
+                {
+                    ++pos_;
+                    in_game = true;
+                    break;
+                }
+                else
+                {
+                    const std::string_view symbol = read_symbol();
+                    in_game = in_movetext = true;
+                    if (is_result(symbol))
+                    {
+                        game.result = to_result(symbol);
+                        break;
+                    }
+                    if (!is_digit(symbol[0]) || is_zero_castling(symbol))
+                        game.moves.push_back(symbol);
+                    else if (symbol.find_first_not_of("0123456789")
+                             != std::string_view::npos)
+                        throw PgnParsingException("wrong turn number",
+                                                  std::string(symbol));
+                }
+            }
+        } catch (const PgnParsingException&)
+        {
+            recover();
+            throw;
+        }
+
+        if (!in_game)
+            return false;
+        game_count_++;
+        return true;
+    }
+
+    void PgnReader::skip_whitespace(void)
+    {
+        while (pos_ < text_.size()
+               && std::isspace(static_cast<unsigned char>(text_[pos_])))
+            ++pos_;
+    }
+
+    void PgnReader::skip_line(void)
+    {
+        const auto end = text_.find('\n', pos_);
+        pos_ = end == std::string_view::npos ? text_.size() : end + 1;
+    }
+
+    void PgnReader::skip_comment(void)
+    {
+        const auto end = text_.find('}', pos_);
+        if (end == std::string_view::npos)
+            throw PgnParsingException("unterminated comment",
+                                      std::string(text_.substr(pos_, 16)));
+        pos_ = end + 1;
+    }
+
+    void PgnReader::skip_variation(void)
+    {
+        const size_t start = pos_;
+        int depth = 0;
+        while (pos_ < text_.size())
+        {
+            const char c = text_[pos_];
+            if (c == '{')
+                skip_comment();
+            else if (c == ';')
+                skip_line();
+            else
+            {
+                ++pos_;
+                if (c == '(')
+                    depth++;
+                else if (c == ')' && --depth == 0)
+                    return;
+            }
+        }
+        throw PgnParsingException("unterminated variation",
+                                  std::string(text_.substr(start, 16)));
+    }
+
+    PgnTag PgnReader::read_tag(void)
+    {
+        const size_t start = pos_++; // '['
+        skip_whitespace();
+        PgnTag tag;
+        tag.name = read_symbol();
+        skip_whitespace();
+
+        if (pos_ >= text_.size() || text_[pos_] != '"')
+            throw PgnParsingException("bad tag pair",
+                                      std::string(text_.substr(start, 32)));
+        const size_t value_start = ++pos_;
+        while (pos_ < text_.size() && text_[pos_] != '"')
+            pos_ += text_[pos_] == '\\' ? 2 : 1;
+        if (pos_ >= text_.size())
+            throw PgnParsingException("unterminated tag value",
+                                      std::string(text_.substr(start, 32)));
+        tag.value = text_.substr(value_start, pos_++ - value_start);
+
+        skip_whitespace();
+        if (pos_ >= text_.size() || text_[pos_] != ']')
+            throw PgnParsingException("bad tag pair",
+                                      std::string(text_.substr(start, 32)));
+        ++pos_;
+        return tag;
+    }
+
+    std::string_view PgnReader::read_symbol(void)
+    {
+        const size_t start = pos_;
+        while (pos_ < text_.size() && is_symbol_char(text_[pos_]))
+            ++pos_;
+        if (pos_ == start)
+            throw PgnParsingException("unexpected character",
+                                      pos_ < text_.size()
+                                      ? std::string(1, text_[pos_])
+                                      : "end of file");
+        return text_.substr(start, pos_ - start);
+    }
+
+    void PgnReader::recover(void)
+    {
+        // The next game starts with a tag at the beginning of a line
+        const auto next = text_.find("\n[", pos_);
+        pos_ = next == std::string_view::npos ? text_.size() : next + 1;
+    }
+} // namespace pgn_parser
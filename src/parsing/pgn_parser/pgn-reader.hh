@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+
+#include "game-result.hh"
+#include "utils/mapped-file.hh"
+
+namespace pgn_parser
+{
+    // A tag pair, eg: [White "Tal, Mihail"]
+    // The value is the raw text between the quotes: escaped characters
+    // (\" and \\) are left as is
+    struct PgnTag
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    /*
+    ** A game of a PGN database. The views point into the text of the
+    ** reader and are valid as long as the reader is alive.
+    */
+    struct PgnGameView
+    {
+        std::vector<PgnTag> tags;
+        // Moves of the main line, without move numbers, annotations,
+        // comments or variations, eg: "Nf3", "exd8=Q+", "O-O"
+        std::vector<std::string_view> moves;
+        GameResult result = GameResult::UNKNOWN;
+
+        // Value of the first tag with this name
+        std::optional<std::string_view> tag(std::string_view name) const;
+    };
+
+    /*
+    ** Pull based reader of multi-game PGN databases. The file is memory
+    ** mapped and each call to next() tokenizes a single game, in place,
+    ** so the memory used does not depend on the size of the database.
+    **
+    ** Comments ({...} and ;...), escaped lines (%...), NAGs ($n), move
+    ** suffix annotations (!, ?) and variations (nested (...)) are skipped.
+    */
+    class PgnReader
+    {
+    public:
+        // Map the file, throws a PgnParsingException if it cannot be read
+        explicit PgnReader(const std::string& path);
+
+        // Read games from a text owned by the caller
+        static PgnReader from_text(std::string_view text);
+
+        PgnReader(const PgnReader&) = delete;
+        PgnReader& operator=(const PgnReader&) = delete;
+
+        /*
+        ** Store the next game in game, reusing its buffers. Return false
+        ** once every game has been read. A syntax error throws a
+        ** PgnParsingException and skips to the tags of the next game, so
+        ** that reading can go on.
+        */
+        bool next(PgnGameView& game);
+
+        // Number of games returned by next() so far
+        size_t get_game_count(void) const;
+
+    private:
+        struct TextTag {};
+        PgnReader(TextTag, std::string_view text);
+
+        utils::MappedFile file_;
+        std::string_view text_;
+        size_t pos_ = 0;
+        size_t game_count_ = 0;
+
+        void skip_whitespace(void);
+        void skip_line(void);
+        void skip_comment(void);
+        void skip_variation(void);
+        PgnTag read_tag(void);
+        std::string_view read_symbol(void);
+        void recover(void);
+    };
+} // namespace pgn_parser
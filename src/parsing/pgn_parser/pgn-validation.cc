@@ -0,0 +1,191 @@
+#include "pgn-validation.hh"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <iomanip>
+#include <sstream>
+#include <exception>
+#include <optional>
+#include <algorithm>
+
+#include "pgn-database.hh"
+#include "pgn-exception.hh"
+#include "san.hh"
+#include "utils/utype.hh"
+
+using namespace board;
+
+namespace pgn_parser
+{
+    namespace
+    {
+        std::optional<GameResult> to_result(const std::string_view tag)
+        {
+            if (tag == "1-0")
+                return GameResult::WHITE_WIN;
+            if (tag == "0-1")
+                return GameResult::BLACK_WIN;
+            if (tag == "1/2-1/2")
+                return GameResult::DRAW;
+            if (tag == "*")
+                return GameResult::UNKNOWN;
+            return std::nullopt;
+        }
+
+        const char* result_name(const GameResult result)
+        {
+            switch (result)
+            {
+            case GameResult::WHITE_WIN:
+                return "1-0";
+            case GameResult::BLACK_WIN:
+                return "0-1";
+            case GameResult::DRAW:
+                return "1/2-1/2";
+            default:
+                return "*";
+            }
+        }
+
+        const char* status_name(const GameStatus status)
+        {
+            switch (status)
+            {
+            case GameStatus::LEGAL:
+                return "legal";
+            case GameStatus::SYNTAX_ERROR:
+                return "syntax error";
+            case GameStatus::ILLEGAL_MOVE:
+                return "illegal move";
+            default:
+                return "result mismatch";
+            }
+        }
+
+        GameReport mismatch(const GameResult result, const std::string& why)
+        {
+            return GameReport{GameStatus::RESULT_MISMATCH, 0,
+                              std::string(result_name(result)) + " but "
+                              + why};
+        }
+    } // namespace
+
+    GameReport validate_game(const PgnGameView& game, Chessboard& board)
+    {
+        const auto fen = game.tag("FEN");
+        if (fen.has_value())
+        {
+            try
+            {
+                board = Chessboard::from_fen(fen.value());
+            } catch (const std::exception&)
+            {
+                return GameReport{GameStatus::SYNTAX_ERROR, 0,
+                                  "bad FEN " + std::string(fen.value())};
+            }
+        }
+        else
+            board = Chessboard();
+
+        std::vector<Move> legal_moves = board.generate_legal_moves();
+        for (size_t ply = 0; ply < game.moves.size(); ++ply)
+        {
+            try
+            {
+                board.do_move(san_to_move(legal_moves, game.moves[ply]));
+            } catch (const PgnParsingException& error)
+            {
+                return GameReport{GameStatus::ILLEGAL_MOVE, ply + 1,
+                                  error.what()};
+            }
+            legal_moves = board.generate_legal_moves();
+        }
+
+        const auto tag = game.tag("Result");
+        if (tag.has_value() && to_result(tag.value()) != game.result)
+            return mismatch(game.result, "the Result tag is "
+                                         + std::string(tag.value()));
+
+        if (game.result == GameResult::UNKNOWN || !legal_moves.empty())
+            return GameReport{};
+
+        if (!board.is_check())
+        {
+            if (game.result != GameResult::DRAW)
+                return mismatch(game.result, "the game ends in stalemate");
+        }
+        else if (game.result != (board.get_white_turn()
+                                 ? GameResult::BLACK_WIN
+                                 : GameResult::WHITE_WIN))
+            return mismatch(game.result, "the game ends in checkmate");
+
+        return GameReport{};
+    }
+
+    ValidationSummary validate_games(const std::vector<std::string>& paths,
+                                     const unsigned threads,
+                                     std::ostream& report)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        PgnDatabase database(paths);
+
+        std::array<std::atomic<size_t>, nb_game_status> counts{};
+        std::mutex report_mutex;
+        const auto worker = [&]()
+        {
+            Chessboard board;
+            DatabaseGame game;
+            while (database.next(game))
+            {
+                const GameReport result = game.error.has_value()
+                        ? GameReport{GameStatus::SYNTAX_ERROR, 0,
+                                     game.error.value()}
+                        : validate_game(game.view, board);
+                counts[utils::utype(result.status)]++;
+                if (result.status == GameStatus::LEGAL)
+                    continue;
+
+                std::lock_guard<std::mutex> lock(report_mutex);
+                report << database.get_file(game.file) << ": game "
+                       << game.index + 1 << ": "
+                       << status_name(result.status);
+                if (result.ply > 0)
+                    report << " at ply " << result.ply;
+                report << ": " << result.detail << '\n';
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::max(1u, threads); ++t)
+            workers.emplace_back(worker);
+        for (auto& thread : workers)
+            thread.join();
+
+        ValidationSummary summary;
+        for (size_t i = 0; i < nb_game_status; ++i)
+        {
+            summary.counts[i] = counts[i];
+            summary.games += counts[i];
+        }
+        summary.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        return summary;
+    }
+
+    std::ostream& operator<<(std::ostream& os,
+                             const ValidationSummary& summary)
+    {
+        const double rate = summary.seconds > 0
+                            ? summary.games / summary.seconds : 0;
+        std::ostringstream timing;
+        timing << std::fixed << std::setprecision(2) << summary.seconds
+               << " s (" << std::setprecision(0) << rate << " games/s)";
+        os << summary.games << " games in " << timing.str() << '\n';
+        for (size_t i = 0; i < nb_game_status; ++i)
+            os << status_name(static_cast<GameStatus>(i)) << ": "
+               << summary.counts[i] << '\n';
+        return os;
+    }
+} // namespace pgn_parser
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "chess_engine/board/chessboard.hh"
+#include "pgn-reader.hh"
+
+// Batch validation of PGN databases
+namespace pgn_parser
+{
+    enum class GameStatus
+    {
+        LEGAL,
+        SYNTAX_ERROR,    // The game could not be tokenized
+        ILLEGAL_MOVE,    // A move is illegal, ambiguous or malformed
+        RESULT_MISMATCH, // The result contradicts the tag or the final board
+    };
+
+    constexpr size_t nb_game_status = 4;
+
+    struct GameReport
+    {
+        GameStatus status = GameStatus::LEGAL;
+        // Ply of the illegal move, starting at 1
+        size_t ply = 0;
+        std::string detail;
+    };
+
+    /*
+    ** Replay the game on the board, from the initial position or from its
+    ** FEN tag, checking that every move is legal and that the result
+    ** agrees with the Result tag and with a final mate or stalemate
+    */
+    GameReport validate_game(const PgnGameView& game,
+                             board::Chessboard& board);
+
+    struct ValidationSummary
+    {
+        size_t games = 0;
+        // Number of games of each GameStatus
+        std::array<size_t, nb_game_status> counts{};
+        double seconds = 0;
+    };
+
+    /*
+    ** Validate every game of the PGN files of the paths (directories are
+    ** walked) on a pool of threads, each one with its own board. The games
+    ** that are not legal are reported, one line each, on report.
+    */
+    ValidationSummary validate_games(const std::vector<std::string>& paths,
+                                     unsigned threads, std::ostream& report);
+
+    // Counts and throughput
+    std::ostream& operator<<(std::ostream& os,
+                             const ValidationSummary& summary);
+} // namespace pgn_parser
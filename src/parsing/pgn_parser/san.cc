@@ -0,0 +1,211 @@
+#include "san.hh"
+
+#include <optional>
+
+#include "pgn-exception.hh"
+#include "utils/utype.hh"
+
+using namespace board;
+
+namespace pgn_parser
+{
+    namespace
+    {
+        bool is_file(const char c)
+        {
+            return c >= 'a' && c <= 'h';
+        }
+
+        bool is_rank(const char c)
+        {
+            return c >= '1' && c <= '8';
+        }
+
+        std::optional<PieceType> to_piece(const char c)
+        {
+            switch (c)
+            {
+            case 'K':
+                return PieceType::KING;
+            case 'Q':
+                return PieceType::QUEEN;
+            case 'R':
+                return PieceType::ROOK;
+            case 'B':
+                return PieceType::BISHOP;
+            case 'N':
+                return PieceType::KNIGHT;
+            default:
+                return std::nullopt;
+            }
+        }
+
+        char file_char(const Position& position)
+        {
+            return static_cast<char>('a' + utils::utype(position.get_file()));
+        }
+
+        char rank_char(const Position& position)
+        {
+            return static_cast<char>('1' + utils::utype(position.get_rank()));
+        }
+
+        // The only move matching the filter, throws otherwise
+        template <typename Filter>
+        Move find_move(const std::vector<Move>& legal_moves,
+                       const std::string_view san, const Filter& filter)
+        {
+            const Move* found = nullptr;
+            for (const auto& move : legal_moves)
+            {
+                if (!filter(move))
+                    continue;
+                if (found != nullptr)
+                    throw PgnParsingException("ambiguous move",
+                                              std::string(san));
+                found = &move;
+            }
+            if (found == nullptr)
+                throw PgnParsingException("illegal move", std::string(san));
+            return *found;
+        }
+    } // namespace
+
+    Move san_to_move(const std::vector<Move>& legal_moves,
+                     const std::string_view san)
+    {
+        std::string_view word = san;
+        while (!word.empty() && word.find_last_of("+#!?") == word.size() - 1)
+            word.remove_suffix(1);
+
+        if (word == "O-O" || word == "0-0")
+            return find_move(legal_moves, san, [](const Move& move)
+                             { return move.get_king_castling(); });
+        if (word == "O-O-O" || word == "0-0-0")
+            return find_move(legal_moves, san, [](const Move& move)
+                             { return move.get_queen_castling(); });
+
+        PieceType piece = PieceType::PAWN;
+        if (!word.empty() && to_piece(word.front()).has_value())
+        {
+            piece = to_piece(word.front()).value();
+            word.remove_prefix(1);
+        }
+
+        // Promotion, the '=' is sometimes left out
+        std::optional<PieceType> promotion;
+        if (piece == PieceType::PAWN && !word.empty()
+            && to_piece(word.back()).has_value())
+        {
+            promotion = to_piece(word.back());
+            word.remove_suffix(1);
+            if (!word.empty() && word.back() == '=')
+                word.remove_suffix(1);
+        }
+
+        // Destination square
+        const size_t size = word.size();
+        if (size < 2 || !is_file(word[size - 2]) || !is_rank(word[size - 1])
+            || promotion == PieceType::KING)
+            throw PgnParsingException("syntax error", std::string(san));
+        const Position end(static_cast<File>(word[size - 2] - 'a'),
+                           static_cast<Rank>(word[size - 1] - '1'));
+        word.remove_suffix(2);
+
+        // Disambiguation then capture or long notation separator
+        std::optional<char> from_file;
+        std::optional<char> from_rank;
+        if (!word.empty() && is_file(word.front()))
+        {
+            from_file = word.front();
+            word.remove_prefix(1);
+        }
+        if (!word.empty() && is_rank(word.front()))
+        {
+            from_rank = word.front();
+            word.remove_prefix(1);
+        }
+        if (!word.empty() && (word.front() == 'x' || word.front() == '-'))
+            word.remove_prefix(1);
+        if (!word.empty())
+            throw PgnParsingException("syntax error", std::string(san));
+
+        return find_move(legal_moves, san, [&](const Move& move)
+            {
+                return move.get_piece() == piece && move.get_end() == end
+                       && move.get_promotion() == promotion
+                       && (!from_file || file_char(move.get_start())
+                                         == from_file.value())
+                       && (!from_rank || rank_char(move.get_start())
+                                         == from_rank.value());
+            });
+    }
+
+    Move san_to_move(const Chessboard& board, const std::string_view san)
+    {
+        Chessboard position = board;
+        return san_to_move(position.generate_legal_moves(), san);
+    }
+
+    std::string move_to_san(const Chessboard& board, const Move& move)
+    {
+        std::string san;
+        if (move.get_king_castling())
+            san = "O-O";
+        else if (move.get_queen_castling())
+            san = "O-O-O";
+        else
+        {
+            const Position& start = move.get_start();
+            if (move.get_piece() == PieceType::PAWN)
+            {
+                if (move.get_capture())
+                    san.push_back(file_char(start));
+            }
+            else
+            {
+                san.push_back(piece_to_char(move.get_piece()));
+
+                // Other pieces of the same type going to the same square
+                Chessboard position = board;
+                bool ambiguous = false;
+                bool same_file = false;
+                bool same_rank = false;
+                for (const auto& other : position.generate_legal_moves())
+                {
+                    if (other.get_piece() != move.get_piece()
+                        || other.get_end() != move.get_end()
+                        || other.get_start() == start)
+                        continue;
+                    ambiguous = true;
+                    same_file |= other.get_start().get_file()
+                                 == start.get_file();
+                    same_rank |= other.get_start().get_rank()
+                                 == start.get_rank();
+                }
+                if (ambiguous && (!same_file || same_rank))
+                    san.push_back(file_char(start));
+                if (ambiguous && same_file)
+                    san.push_back(rank_char(start));
+            }
+
+            if (move.get_capture())
+                san.push_back('x');
+            san.push_back(file_char(move.get_end()));
+            san.push_back(rank_char(move.get_end()));
+            if (move.get_promotion().has_value())
+            {
+                san.push_back('=');
+                san.push_back(piece_to_char(move.get_promotion().value()));
+            }
+        }
+
+        Chessboard child = board;
+        child.do_move(move);
+        if (child.is_checkmate())
+            san.push_back('#');
+        else if (child.is_check())
+            san.push_back('+');
+        return san;
+    }
+} // namespace pgn_parser
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "chess_engine/board/chessboard.hh"
+
+// Standard algebraic notation (SAN)
+namespace pgn_parser
+{
+    /*
+    ** Find the legal move written by the word. Short SAN ("Nf3", "Rad1",
+    ** "exd6", "e8=Q"), long forms with a full start square ("Ng1-f3",
+    ** "e2e4") and castling ("O-O", "0-0-0") are accepted. Check marks and
+    ** annotations (!, ?) are ignored.
+    ** Throws a PgnParsingException if the word is malformed, or if no
+    ** legal move or more than one legal move matches it
+    */
+    board::Move san_to_move(const std::vector<board::Move>& legal_moves,
+                            std::string_view san);
+    board::Move san_to_move(const board::Chessboard& board,
+                            std::string_view san);
+
+    /*
+    ** Shortest SAN of a legal move of the board: the start file, rank or
+    ** square is only written if needed, followed by + or # when the move
+    ** gives check or mate
+    */
+    std::string move_to_san(const board::Chessboard& board,
+                            const board::Move& move);
+} // namespace pgn_parser
@@ -0,0 +1,73 @@
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "tuner.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace boost::program_options;
+
+int main(int argc, const char* argv[])
+{
+    try
+    {
+        std::string dataset_path;
+        std::string output_path;
+        tuner::Options options;
+
+        options_description desc{"Allowed options"};
+        desc.add_options()
+        ("help,h", "show usage")
+        ("dataset", value<std::string>(&dataset_path)->required(),
+            "labelled positions, one 'FEN result' per line")
+        ("output,o", value<std::string>(&output_path)
+            ->default_value("evaluation-params.hh"),
+            "path of the regenerated parameter header")
+        ("epochs,e", value<unsigned>(&options.epochs)->default_value(1000),
+            "number of gradient descent iterations")
+        ("rate,r", value<double>(&options.learning_rate)->default_value(1.0),
+            "learning rate (centipawns)")
+        ("threads,t", value<unsigned>(&options.threads)
+            ->default_value(std::max(1u, std::thread::hardware_concurrency())),
+            "number of worker threads");
+
+        positional_options_description positional;
+        positional.add("dataset", 1);
+
+        variables_map vm;
+        store(command_line_parser(argc, argv).options(desc)
+              .positional(positional).run(), vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << "Usage: chess-tune DATASET [options]\n"
+                      << desc << '\n';
+            return 0;
+        }
+        notify(vm);
+        options.threads = std::max(1u, options.threads);
+
+        board::MoveInitialization::get_instance();
+        const auto dataset = tuner::load_dataset(dataset_path,
+                                                 options.threads);
+        std::cout << dataset.size() << " positions loaded" << std::endl;
+        if (dataset.size() == 0)
+            return 1;
+
+        const auto parameters = tuner::tune(dataset,
+                                            tuner::default_parameters(),
+                                            options);
+
+        std::ofstream output(output_path);
+        tuner::write_parameters(output, parameters);
+        std::cout << "parameters written to " << output_path << std::endl;
+    }
+    catch (const error& ex)
+    {
+        std::cerr << ex.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
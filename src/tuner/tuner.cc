@@ -0,0 +1,603 @@
+#include "tuner.hh"
+
+#include <cmath>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "chess_engine/ai/evaluation.hh"
+#include "chess_engine/ai/endgame.hh"
+#include "utils/bits-utils.hh"
+
+using namespace board;
+
+namespace tuner
+{
+    namespace
+    {
+        constexpr int quiescence_max_depth = 8;
+
+        // Same order than piecetype_array_without_king
+        constexpr const char* table_names[] = {
+            "black_piece_square_table_queen",
+            "black_piece_square_table_rook",
+            "black_piece_square_table_bishop",
+            "black_piece_square_table_knight",
+            "black_piece_square_table_pawn"
+        };
+
+        // Run func(begin, end, thread_index) on contiguous chunks of [0, size)
+        void parallel_for(const size_t size, const unsigned threads,
+                          const std::function<void(size_t, size_t,
+                                                   unsigned)>& func)
+        {
+            std::vector<std::thread> workers;
+            const size_t chunk = (size + threads - 1) / threads;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                const size_t begin = std::min(size, t * chunk);
+                const size_t end = std::min(size, begin + chunk);
+                workers.emplace_back(func, begin, end, t);
+            }
+            for (auto& worker : workers)
+                worker.join();
+        }
+
+        double sigmoid(const double scaling, const double evaluation)
+        {
+            return 1.0 / (1.0 + std::pow(10.0, -scaling * evaluation / 400.0));
+        }
+
+        double evaluate(const Dataset& dataset, const size_t i,
+                        const parameters_t& parameters)
+        {
+            double evaluation = 0;
+            for (auto j = dataset.offsets[i]; j < dataset.offsets[i + 1]; ++j)
+            {
+                const auto& coefficient = dataset.coefficients[j];
+                evaluation += coefficient.value * parameters[coefficient.index];
+            }
+            return evaluation;
+        }
+
+        // Negamax on captures and promotions only, stores the best line
+        int quiescence(Chessboard& board, int alpha, const int beta,
+                       const int depth, std::vector<Move>& pv)
+        {
+            const int sign = board.get_white_turn() ? 1 : -1;
+            const int stand_pat = sign * ai::evaluate(board);
+
+            pv.clear();
+            if (stand_pat >= beta || depth == 0)
+                return stand_pat;
+            alpha = std::max(alpha, stand_pat);
+
+            std::vector<Move> child_pv;
+            for (const auto& move : board.generate_legal_moves())
+            {
+                if (!move.get_capture() && !move.get_promotion().has_value())
+                    continue;
+
+                Chessboard child = board;
+                child.do_move(move);
+                const int score = -quiescence(child, -beta, -alpha,
+                                              depth - 1, child_pv);
+                if (score > alpha)
+                {
+                    alpha = score;
+                    pv.clear();
+                    pv.push_back(move);
+                    pv.insert(pv.end(), child_pv.begin(), child_pv.end());
+                    if (alpha >= beta)
+                        break;
+                }
+            }
+
+            return alpha;
+        }
+
+        std::string strip(const std::string& token)
+        {
+            const auto begin = token.find_first_not_of("[]\";");
+            const auto end = token.find_last_not_of("[]\";");
+            if (begin == std::string::npos)
+                return "";
+            return token.substr(begin, end - begin + 1);
+        }
+
+        bool parse_result(const std::string& token, float& result)
+        {
+            const std::string value = strip(token);
+            if (value == "1-0")
+                result = 1;
+            else if (value == "0-1")
+                result = 0;
+            else if (value == "1/2-1/2")
+                result = 0.5;
+            else
+            {
+                try
+                {
+                    result = std::stof(value);
+                }
+                catch (const std::exception&)
+                {
+                    return false;
+                }
+            }
+            return result >= 0 && result <= 1;
+        }
+
+        bool parse_line(const std::string& line, Chessboard& board,
+                        float& result)
+        {
+            std::istringstream ss(line);
+            std::vector<std::string> tokens;
+            std::string token;
+            while (ss >> token)
+                tokens.push_back(token);
+
+            if (tokens.size() < 5 || !parse_result(tokens.back(), result))
+                return false;
+
+            const std::string fen = tokens[0] + ' ' + tokens[1] + ' '
+                                    + tokens[2] + ' ' + tokens[3];
+            try
+            {
+                board = Chessboard::from_fen(fen);
+            }
+            catch (const std::invalid_argument&)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        void add_table_coefficients(std::vector<int>& dense,
+                                    const size_t table,
+                                    uint64_t white, uint64_t black)
+        {
+            // White pieces use the table along the reversed rank axis
+            int pos = utils::pop_lsb(white);
+            while (pos >= 0)
+            {
+                dense[table + (pos ^ 56)]++;
+                pos = utils::pop_lsb(white);
+            }
+            pos = utils::pop_lsb(black);
+            while (pos >= 0)
+            {
+                dense[table + pos]--;
+                pos = utils::pop_lsb(black);
+            }
+        }
+
+        void write_table(std::ostream& os, const std::string& name,
+                         const parameters_t& parameters, const size_t table)
+        {
+            os << "    constexpr piece_square_table_t " << name << " = {\n";
+            for (size_t rank = 0; rank < 8; ++rank)
+            {
+                os << "        ";
+                for (size_t file = 0; file < 8; ++file)
+                {
+                    const auto i = table + rank * 8 + file;
+                    os << std::setw(3) << std::lround(parameters[i]);
+                    if (rank != 7 || file != 7)
+                        os << (file == 7 ? "," : ", ");
+                }
+                os << '\n';
+            }
+            os << "    };\n";
+        }
+
+        // Store the count integers following the name in text, from index
+        void read_numbers(const std::string& text, const std::string& name,
+                          parameters_t& parameters, const size_t index,
+                          const size_t count)
+        {
+            auto pos = text.find(name);
+            if (pos == std::string::npos)
+                throw std::invalid_argument("missing " + name);
+            pos += name.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                pos = text.find_first_of("-0123456789", pos);
+                if (pos == std::string::npos)
+                    throw std::invalid_argument("truncated " + name);
+                size_t length = 0;
+                parameters[index + i] = std::stoi(text.substr(pos),
+                                                  &length);
+                pos += length;
+            }
+        }
+    } // namespace
+
+    size_t Dataset::size(void) const
+    {
+        return results.size();
+    }
+
+    parameters_t default_parameters(void)
+    {
+        parameters_t parameters(layout::size, 0);
+
+        for (size_t i = 0; i < 5; ++i)
+            parameters[layout::material + i] = ai::piecetype_values[i];
+        parameters[layout::queen_on_open_file] = ai::queen_on_open_file_bonus;
+        parameters[layout::rook_on_open_file] = ai::rook_on_open_file_bonus;
+
+        for (size_t piece = 0; piece < 5; ++piece)
+            for (size_t i = 0; i < layout::table_size; ++i)
+                parameters[layout::piece_square_tables
+                           + piece * layout::table_size + i] =
+                        ai::black_piece_square_tables[piece][i];
+
+        for (size_t i = 0; i < layout::table_size; ++i)
+        {
+            parameters[layout::middle_game_king + i] =
+                    ai::black_middle_game_piece_square_table_king[i];
+            parameters[layout::end_game_king + i] =
+                    ai::black_end_game_piece_square_table_king[i];
+        }
+
+        return parameters;
+    }
+
+    // Mirrors ai::evaluate term by term
+    std::vector<coefficient_t> extract_coefficients(const Chessboard& board)
+    {
+        const Board& b = board.get_board();
+        std::vector<int> dense(layout::size, 0);
+
+        for (auto piece : piecetype_array_without_king)
+        {
+            const auto piece_i = utils::utype(piece);
+            const uint64_t white = b(piece, Color::WHITE);
+            const uint64_t black = b(piece, Color::BLACK);
+
+            dense[layout::material + piece_i] +=
+                    utils::bits_count(white) - utils::bits_count(black);
+            add_table_coefficients(dense, layout::piece_square_tables
+                                          + piece_i * layout::table_size,
+                                   white, black);
+        }
+
+        add_table_coefficients(dense, ai::is_end_game(board)
+                                      ? layout::end_game_king
+                                      : layout::middle_game_king,
+                               b(PieceType::KING, Color::WHITE),
+                               b(PieceType::KING, Color::BLACK));
+
+        const uint64_t files = utils::file_fill(b(PieceType::PAWN));
+        if (files)
+        {
+            if (files & b(PieceType::QUEEN, Color::WHITE))
+                dense[layout::queen_on_open_file]++;
+            if (files & b(PieceType::QUEEN, Color::BLACK))
+                dense[layout::queen_on_open_file]--;
+            if (files & b(PieceType::ROOK, Color::WHITE))
+                dense[layout::rook_on_open_file]++;
+            if (files & b(PieceType::ROOK, Color::BLACK))
+                dense[layout::rook_on_open_file]--;
+        }
+
+        std::vector<coefficient_t> coefficients;
+        for (size_t i = 0; i < dense.size(); ++i)
+            if (dense[i] != 0)
+                coefficients.push_back({static_cast<uint16_t>(i),
+                                        static_cast<int16_t>(dense[i])});
+        return coefficients;
+    }
+
+    Chessboard quiescence_leaf(const Chessboard& board)
+    {
+        Chessboard leaf = board;
+        std::vector<Move> pv;
+        quiescence(leaf, -ai::piecetype_values[0] * 100,
+                   ai::piecetype_values[0] * 100, quiescence_max_depth, pv);
+
+        for (const auto& move : pv)
+            leaf.do_move(move);
+        return leaf;
+    }
+
+    Dataset load_dataset(const std::string& path, const unsigned threads)
+    {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line))
+            if (!line.empty())
+                lines.push_back(line);
+
+        std::vector<Dataset> parts(threads);
+        std::vector<size_t> skipped(threads, 0);
+        std::vector<size_t> mismatches(threads, 0);
+        const parameters_t parameters = default_parameters();
+
+        parallel_for(lines.size(), threads,
+            [&](const size_t begin, const size_t end, const unsigned t)
+            {
+                Dataset& part = parts[t];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Chessboard board;
+                    float result;
+                    if (!parse_line(lines[i], board, result))
+                    {
+                        skipped[t]++;
+                        continue;
+                    }
+
+                    // Endgame knowledge is not expressed by the parameters
+                    const Chessboard leaf = quiescence_leaf(board);
+                    if (ai::endgame::evaluate(leaf).has_value()
+                        || ai::endgame::scale_factor(leaf.get_board())
+                           != ai::endgame::scale_normal)
+                    {
+                        skipped[t]++;
+                        continue;
+                    }
+
+                    const auto coefficients = extract_coefficients(leaf);
+                    part.coefficients.insert(part.coefficients.end(),
+                                             coefficients.begin(),
+                                             coefficients.end());
+                    part.offsets.push_back(part.coefficients.size());
+                    part.results.push_back(result);
+
+                    // The linear model must match the compiled evaluation
+                    const auto row = part.results.size() - 1;
+                    if (std::lround(evaluate(part, row, parameters))
+                        != ai::evaluate(leaf))
+                        mismatches[t]++;
+                }
+            });
+
+        Dataset dataset;
+        for (const auto& part : parts)
+        {
+            const auto base = dataset.coefficients.size();
+            dataset.coefficients.insert(dataset.coefficients.end(),
+                                        part.coefficients.begin(),
+                                        part.coefficients.end());
+            for (size_t i = 1; i < part.offsets.size(); ++i)
+                dataset.offsets.push_back(base + part.offsets[i]);
+            dataset.results.insert(dataset.results.end(),
+                                   part.results.begin(), part.results.end());
+        }
+
+        size_t total_skipped = 0;
+        size_t total_mismatches = 0;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            total_skipped += skipped[t];
+            total_mismatches += mismatches[t];
+        }
+        if (total_skipped)
+            std::cerr << total_skipped
+                      << " unreadable lines or known endings skipped\n";
+        if (total_mismatches)
+            std::cerr << "warning: " << total_mismatches
+                      << " positions differ from the compiled evaluation\n";
+
+        return dataset;
+    }
+
+    double mean_squared_error(const Dataset& dataset,
+                              const parameters_t& parameters,
+                              const double scaling,
+                              const unsigned threads)
+    {
+        std::vector<double> errors(threads, 0);
+
+        parallel_for(dataset.size(), threads,
+            [&](const size_t begin, const size_t end, const unsigned t)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const double s = sigmoid(scaling,
+                                             evaluate(dataset, i, parameters));
+                    const double diff = dataset.results[i] - s;
+                    errors[t] += diff * diff;
+                }
+            });
+
+        double error = 0;
+        for (const auto e : errors)
+            error += e;
+        return error / std::max<size_t>(1, dataset.size());
+    }
+
+    double find_scaling(const Dataset& dataset,
+                        const parameters_t& parameters,
+                        const unsigned threads)
+    {
+        double best = 1.0;
+        double best_error = mean_squared_error(dataset, parameters,
+                                               best, threads);
+
+        // Refine the scaling one decimal at a time
+        for (double step = 0.1; step >= 0.001; step /= 10)
+        {
+            const double center = best;
+            for (int i = -10; i <= 10; ++i)
+            {
+                const double scaling = center + i * step;
+                if (scaling <= 0)
+                    continue;
+                const double error = mean_squared_error(dataset, parameters,
+                                                        scaling, threads);
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best = scaling;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    parameters_t gradient(const Dataset& dataset,
+                          const parameters_t& parameters,
+                          const double scaling,
+                          const unsigned threads)
+    {
+        std::vector<parameters_t> gradients(threads,
+                                            parameters_t(layout::size, 0));
+        parallel_for(dataset.size(), threads,
+            [&](const size_t begin, const size_t end, const unsigned t)
+            {
+                auto& gradient = gradients[t];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const double s = sigmoid(scaling, evaluate(dataset, i,
+                                                               parameters));
+                    // d(r - s)^2 / d eval, up to constant factors
+                    const double g = (s - dataset.results[i]) * s * (1 - s);
+                    for (auto j = dataset.offsets[i];
+                         j < dataset.offsets[i + 1]; ++j)
+                    {
+                        const auto& coefficient = dataset.coefficients[j];
+                        gradient[coefficient.index] += g * coefficient.value;
+                    }
+                }
+            });
+
+        parameters_t total(layout::size, 0);
+        for (size_t p = 0; p < layout::size; ++p)
+        {
+            for (const auto& thread_gradient : gradients)
+                total[p] += thread_gradient[p];
+            total[p] *= 2.0 * std::log(10.0) * scaling / 400.0
+                        / std::max<size_t>(1, dataset.size());
+        }
+        return total;
+    }
+
+    parameters_t tune(const Dataset& dataset,
+                      parameters_t parameters,
+                      const Options& options)
+    {
+        constexpr double beta1 = 0.9;
+        constexpr double beta2 = 0.999;
+        constexpr double epsilon = 1e-8;
+
+        const unsigned threads = options.threads;
+        const double scaling = find_scaling(dataset, parameters, threads);
+        std::cout << "scaling " << scaling << ", error "
+                  << mean_squared_error(dataset, parameters, scaling, threads)
+                  << std::endl;
+
+        parameters_t momentum(layout::size, 0);
+        parameters_t velocity(layout::size, 0);
+
+        for (unsigned epoch = 1; epoch <= options.epochs; ++epoch)
+        {
+            const parameters_t gradients = gradient(dataset, parameters,
+                                                    scaling, threads);
+            for (size_t p = 0; p < layout::size; ++p)
+            {
+                const double gradient = gradients[p];
+                momentum[p] = beta1 * momentum[p] + (1 - beta1) * gradient;
+                velocity[p] = beta2 * velocity[p]
+                              + (1 - beta2) * gradient * gradient;
+                const double m = momentum[p] / (1 - std::pow(beta1, epoch));
+                const double v = velocity[p] / (1 - std::pow(beta2, epoch));
+                parameters[p] -= options.learning_rate * m
+                                 / (std::sqrt(v) + epsilon);
+            }
+
+            if (epoch % 50 == 0 || epoch == options.epochs)
+                std::cout << "epoch " << epoch << ", error "
+                          << mean_squared_error(dataset, parameters,
+                                                scaling, threads)
+                          << std::endl;
+        }
+
+        return parameters;
+    }
+
+    void write_parameters(std::ostream& os, const parameters_t& parameters)
+    {
+        using namespace layout;
+
+        os << "#pragma once\n\n"
+           << "#include <array>\n\n"
+           << "#include \"chess_engine/board/chessboard.hh\"\n\n"
+           << "// Tunable parameters of the classic evaluation\n"
+           << "// This file can be regenerated by the chess-tune binary\n"
+           << "namespace ai\n{\n"
+           << "    constexpr size_t width = board::Chessboard::width;\n"
+           << "    constexpr size_t nb_pieces = board::nb_pieces;\n\n"
+           << "    using piece_square_table_t = "
+           << "std::array<int, width * width>;\n"
+           << "    using piece_square_tables_t =\n"
+           << "            std::array<piece_square_table_t, nb_pieces - 1>;"
+           << "\n\n"
+           << "    constexpr int queen_on_open_file_bonus = "
+           << std::lround(parameters[queen_on_open_file]) << ";\n"
+           << "    constexpr int rook_on_open_file_bonus = "
+           << std::lround(parameters[rook_on_open_file]) << ";\n\n"
+           << "    // QUEEN, ROOK, BISHOP, KNIGHT, PAWN, KING\n"
+           << "    constexpr std::array<int, nb_pieces> piecetype_values\n"
+           << "    {\n        ";
+        for (size_t i = 0; i < 5; ++i)
+            os << std::lround(parameters[material + i]) << ", ";
+        os << ai::piecetype_values[utils::utype(PieceType::KING)] << "\n"
+           << "    };\n\n"
+           << "    // NOTE The tables are well ordered for black pieces\n"
+           << "    // They should be symetrically accessed\n"
+           << "    // (as if the ranks where reversed) for white pieces\n"
+           << "    //\n"
+           << "    //        File H -- File A\n"
+           << "    // Rank 1\n"
+           << "    //   |\n"
+           << "    // Rank 8\n";
+
+        for (size_t piece = 0; piece < 5; ++piece)
+        {
+            write_table(os, table_names[piece], parameters,
+                        piece_square_tables + piece * table_size);
+            os << '\n';
+        }
+        write_table(os, "black_middle_game_piece_square_table_king",
+                    parameters, middle_game_king);
+        os << '\n';
+        write_table(os, "black_end_game_piece_square_table_king",
+                    parameters, end_game_king);
+        os << "}\n";
+    }
+
+    parameters_t read_parameters(std::istream& is)
+    {
+        using namespace layout;
+
+        std::ostringstream buffer;
+        buffer << is.rdbuf();
+        const std::string text = buffer.str();
+
+        parameters_t parameters(layout::size, 0);
+        read_numbers(text, "queen_on_open_file_bonus =", parameters,
+                     queen_on_open_file, 1);
+        read_numbers(text, "rook_on_open_file_bonus =", parameters,
+                     rook_on_open_file, 1);
+        read_numbers(text, "piecetype_values\n", parameters, material, 5);
+        for (size_t piece = 0; piece < 5; ++piece)
+            read_numbers(text, table_names[piece] + std::string(" ="),
+                         parameters, piece_square_tables + piece * table_size,
+                         table_size);
+        read_numbers(text, "black_middle_game_piece_square_table_king =",
+                     parameters, middle_game_king, table_size);
+        read_numbers(text, "black_end_game_piece_square_table_king =",
+                     parameters, end_game_king, table_size);
+        return parameters;
+    }
+} // namespace tuner
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include "chess_engine/board/chessboard.hh"
+
+// Texel tuning of the classic evaluation parameters (evaluation-params.hh)
+//
+// The classic evaluation is linear in its parameters. Each position of the
+// dataset is resolved by a quiescence search once, and its leaf is turned
+// into a sparse vector of coefficients such that:
+//     evaluate(leaf) = sum(coefficient[i] * parameter[i])
+// Every iteration of the tuner is then a sparse matrix-vector product over
+// the whole dataset, spread across all the cores.
+namespace tuner
+{
+    // Layout of the parameter vector
+    namespace layout
+    {
+        constexpr size_t table_size = 64;
+
+        // QUEEN, ROOK, BISHOP, KNIGHT, PAWN (kings always cancel out)
+        constexpr size_t material = 0;
+        constexpr size_t queen_on_open_file = material + 5;
+        constexpr size_t rook_on_open_file = queen_on_open_file + 1;
+        // Black oriented tables, same order than piecetype_array_without_king
+        constexpr size_t piece_square_tables = rook_on_open_file + 1;
+        constexpr size_t middle_game_king = piece_square_tables
+                                            + 5 * table_size;
+        constexpr size_t end_game_king = middle_game_king + table_size;
+        constexpr size_t size = end_game_king + table_size;
+    }
+
+    using parameters_t = std::vector<double>;
+
+    struct coefficient_t
+    {
+        uint16_t index;
+        int16_t value;
+    };
+
+    // Compressed sparse rows: the coefficients of the position i are in
+    // [offsets[i], offsets[i + 1])
+    struct Dataset
+    {
+        std::vector<uint32_t> offsets{0};
+        std::vector<coefficient_t> coefficients;
+        std::vector<float> results; // 1 white wins, 0.5 draw, 0 black wins
+
+        size_t size(void) const;
+    };
+
+    struct Options
+    {
+        unsigned threads;
+        unsigned epochs;
+        double learning_rate;
+    };
+
+    // Parameters currently compiled in evaluation-params.hh
+    parameters_t default_parameters(void);
+
+    // Coefficients of the classic evaluation of the board
+    std::vector<coefficient_t> extract_coefficients(
+            const board::Chessboard& board);
+
+    // Play the principal variation of a capture only search,
+    // so that the returned board is quiet
+    board::Chessboard quiescence_leaf(const board::Chessboard& board);
+
+    // Each line: a FEN (clocks are optional) followed by the game result:
+    // "1-0", "0-1", "1/2-1/2" or a white score such as "[0.5]"
+    Dataset load_dataset(const std::string& path, const unsigned threads);
+
+    // Best scaling constant of the sigmoid for the given parameters
+    double find_scaling(const Dataset& dataset,
+                        const parameters_t& parameters,
+                        const unsigned threads);
+
+    double mean_squared_error(const Dataset& dataset,
+                              const parameters_t& parameters,
+                              const double scaling,
+                              const unsigned threads);
+
+    // Gradient of mean_squared_error with respect to each parameter
+    parameters_t gradient(const Dataset& dataset,
+                          const parameters_t& parameters,
+                          const double scaling,
+                          const unsigned threads);
+
+    // Minimise the mean squared error with Adam gradient descent
+    parameters_t tune(const Dataset& dataset,
+                      parameters_t parameters,
+                      const Options& options);
+
+    // Write parameters with the evaluation-params.hh format
+    void write_parameters(std::ostream& os, const parameters_t& parameters);
+
+    // Read back the parameters of a header written by write_parameters
+    // Throws a std::invalid_argument if one of them is missing
+    parameters_t read_parameters(std::istream& is);
+} // namespace tuner
@@ -0,0 +1,51 @@
+#include "mapped-file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace utils
+{
+    MappedFile::~MappedFile()
+    {
+        if (data_ != nullptr)
+            munmap(const_cast<uint8_t*>(data_), size_);
+    }
+
+    bool MappedFile::open(const std::string& path, const Access access)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // The mapping keeps its own reference
+        if (data == MAP_FAILED)
+            return false;
+
+        madvise(data, st.st_size, access == Access::RANDOM ? MADV_RANDOM
+                                                           : MADV_SEQUENTIAL);
+
+        data_ = static_cast<const uint8_t*>(data);
+        size_ = st.st_size;
+        return true;
+    }
+
+    const uint8_t* MappedFile::data(void) const
+    {
+        return data_;
+    }
+
+    size_t MappedFile::size(void) const
+    {
+        return size_;
+    }
+} // namespace utils
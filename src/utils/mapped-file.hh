@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace utils
+{
+    // Read only memory mapping of a whole file, released on destruction
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // How the mapping is going to be read, a hint for the kernel
+        enum class Access
+        {
+            RANDOM,    // Lookups anywhere in the file, no read ahead
+            SEQUENTIAL // Single pass from the beginning, aggressive read ahead
+        };
+
+        // False if the file cannot be opened or mapped, or is empty
+        bool open(const std::string& path, Access access = Access::RANDOM);
+
+        const uint8_t* data(void) const;
+        size_t size(void) const;
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+} // namespace utils
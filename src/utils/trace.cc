@@ -0,0 +1,162 @@
+#include "trace.hh"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace utils::trace
+{
+    namespace
+    {
+        struct Event
+        {
+            const char* name;
+            // Nanoseconds since the first recorded event of the program
+            int64_t timestamp;
+            // Duration in nanoseconds, or value of the counter
+            int64_t value;
+            bool counter;
+        };
+
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(const unsigned thread_id)
+                : tid(thread_id)
+                , events(ring_size)
+            {}
+
+            const unsigned tid;
+            std::vector<Event> events;
+            // Events ever recorded, the ring holds the last ring_size ones
+            size_t recorded = 0;
+        };
+
+        // Buffers outlive their thread so that they can still be flushed
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::string exit_path;
+        };
+
+        Registry& registry(void)
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        const trace_clock::time_point epoch = trace_clock::now();
+
+        ThreadBuffer& local_buffer(void)
+        {
+            thread_local ThreadBuffer* buffer = nullptr;
+            if (buffer == nullptr)
+            {
+                Registry& reg = registry();
+                const std::lock_guard lock(reg.mutex);
+                reg.buffers.push_back(
+                        std::make_unique<ThreadBuffer>(reg.buffers.size()));
+                buffer = reg.buffers.back().get();
+            }
+            return *buffer;
+        }
+
+        void record(const Event& event)
+        {
+            ThreadBuffer& buffer = local_buffer();
+            buffer.events[buffer.recorded++ % ring_size] = event;
+        }
+
+        int64_t nanoseconds(const trace_clock::duration duration)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    duration).count();
+        }
+
+        // Chrome traces are in microseconds
+        std::ostream& write_us(std::ostream& os, const int64_t ns)
+        {
+            return os << ns / 1000 << '.' << std::setw(3)
+                      << std::setfill('0') << ns % 1000 << std::setfill(' ');
+        }
+
+        void flush_registered_path(void)
+        {
+            flush(registry().exit_path);
+        }
+    } // namespace
+
+    void record_scope(const char* name, const trace_clock::time_point begin,
+                      const trace_clock::time_point end)
+    {
+        record(Event{name, nanoseconds(begin - epoch),
+                     nanoseconds(end - begin), false});
+    }
+
+    void record_counter(const char* name, const int64_t value)
+    {
+        record(Event{name, nanoseconds(trace_clock::now() - epoch), value,
+                     true});
+    }
+
+    void flush(std::ostream& os)
+    {
+        Registry& reg = registry();
+        const std::lock_guard lock(reg.mutex);
+
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for (const auto& buffer : reg.buffers)
+        {
+            const size_t count = std::min(buffer->recorded, ring_size);
+            for (size_t i = buffer->recorded - count; i < buffer->recorded;
+                 ++i)
+            {
+                const Event& event = buffer->events[i % ring_size];
+                os << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+                   << "\",\"ph\":\"" << (event.counter ? 'C' : 'X')
+                   << "\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+                write_us(os, event.timestamp);
+                if (event.counter)
+                    os << ",\"args\":{\"value\":" << event.value << "}}";
+                else
+                {
+                    os << ",\"dur\":";
+                    write_us(os, event.value) << '}';
+                }
+                first = false;
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    bool flush(const std::string& path)
+    {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+        flush(file);
+        return static_cast<bool>(file);
+    }
+
+    void flush_at_exit(const std::string& path)
+    {
+        Registry& reg = registry();
+        const std::lock_guard lock(reg.mutex);
+        if (reg.exit_path.empty())
+            std::atexit(flush_registered_path);
+        reg.exit_path = path;
+    }
+
+    void clear(void)
+    {
+        Registry& reg = registry();
+        const std::lock_guard lock(reg.mutex);
+        for (auto& buffer : reg.buffers)
+            buffer->recorded = 0;
+    }
+} // namespace utils::trace
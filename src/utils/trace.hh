@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*
+** Hot path tracing, compiled in with -DCHESS_TRACE only (build_trace
+** directory). Each thread records its events in its own ring buffer, the
+** oldest events being overwritten, and everything is written as a Chrome
+** trace (chrome://tracing, ui.perfetto.dev) by flush.
+**
+** TRACE_SCOPE(name): time the enclosing scope
+** TRACE_COUNTER(name, value): sample a counter
+**
+** name must be a string literal: only the pointer is recorded.
+*/
+namespace utils::trace
+{
+    using trace_clock = std::chrono::steady_clock;
+
+    // Events kept by each thread
+    constexpr size_t ring_size = 1 << 16;
+
+    void record_scope(const char* name, trace_clock::time_point begin,
+                      trace_clock::time_point end);
+    void record_counter(const char* name, int64_t value);
+
+    // The traced threads must not record while flushing
+    void flush(std::ostream& os);
+    bool flush(const std::string& path);
+    // Flush to path when the program exits, even on exit()
+    void flush_at_exit(const std::string& path);
+    // Drop the recorded events of every thread
+    void clear(void);
+
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const char* name)
+            : name_(name)
+            , begin_(trace_clock::now())
+        {}
+
+        ~ScopedTimer()
+        {
+            record_scope(name_, begin_, trace_clock::now());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const char* name_;
+        trace_clock::time_point begin_;
+    };
+
+    constexpr bool enabled(void)
+    {
+#ifdef CHESS_TRACE
+        return true;
+#else
+        return false;
+#endif /* CHESS_TRACE */
+    }
+} // namespace utils::trace
+
+#ifdef CHESS_TRACE
+# define TRACE_CONCAT_(a, b) a##b
+# define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+# define TRACE_SCOPE(name) \
+    const ::utils::trace::ScopedTimer TRACE_CONCAT(trace_scope_, __LINE__)(name)
+# define TRACE_COUNTER(name, value) \
+    ::utils::trace::record_counter(name, static_cast<int64_t>(value))
+#else
+# define TRACE_SCOPE(name) static_cast<void>(0)
+# define TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif /* CHESS_TRACE */
@@ -0,0 +1,293 @@
+#include <benchmark/benchmark.h>
+
+#include <regex>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+#include "chess_engine/ai/evaluation.hh"
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/board/move-generation.hh"
+#include "chess_engine/board/move-initialization.hh"
+#include "parsing/perft_parser/perft-parser.hh"
+#include "parsing/pgn_parser/pgn-lexer.hh"
+#include "parsing/pgn_parser/pgn-reader.hh"
+#include "utils/bits-utils.hh"
+#include "utils/utype.hh"
+
+// Micro-benchmarks of the board primitives. Each iteration goes over every
+// position of the perft files of CHESS_BENCH_CORPUS (tests/eval-perft by
+// default), so that the numbers of two commits can be compared. The PGN
+// token benchmarks go over the games of CHESS_BENCH_PGN (tests/eval-pgn).
+
+using namespace board;
+
+namespace
+{
+    struct CorpusPosition
+    {
+        // Complete FEN of the perft file, without the depth
+        std::string fen;
+        Chessboard board;
+        std::vector<Move> legal_moves;
+    };
+
+    std::vector<CorpusPosition> load_corpus(void)
+    {
+        MoveInitialization::get_instance();
+        namespace fs = std::filesystem;
+
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(CHESS_BENCH_CORPUS))
+            if (entry.path().extension() == ".perft")
+                files.push_back(entry.path().string());
+        std::sort(files.begin(), files.end());
+
+        std::vector<CorpusPosition> corpus;
+        for (const auto& file : files)
+        {
+            std::string line;
+            std::getline(std::ifstream(file), line);
+            const std::string fen = line.substr(0, line.find_last_of(' '));
+            Chessboard board = Chessboard::from_fen(fen);
+            const auto legal_moves = board.generate_legal_moves();
+            corpus.push_back(CorpusPosition{fen, board, legal_moves});
+        }
+
+        if (corpus.empty())
+            std::cerr << "no perft file in " << CHESS_BENCH_CORPUS << '\n';
+        return corpus;
+    }
+
+    std::vector<CorpusPosition>& corpus(void)
+    {
+        static std::vector<CorpusPosition> positions = load_corpus();
+        return positions;
+    }
+
+    void set_positions_processed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * corpus().size());
+    }
+
+    struct PgnToken
+    {
+        std::string text;
+        // Turn number, a move otherwise
+        bool number;
+    };
+
+    // Turn numbers and moves of the movetexts, as the PGN parser checks them
+    std::vector<PgnToken> load_pgn_tokens(void)
+    {
+        namespace fs = std::filesystem;
+
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(CHESS_BENCH_PGN))
+            if (entry.path().extension() == ".pgn")
+                files.push_back(entry.path().string());
+        std::sort(files.begin(), files.end());
+
+        std::vector<PgnToken> tokens;
+        for (const auto& file : files)
+        {
+            pgn_parser::PgnReader reader(file);
+            pgn_parser::PgnGameView game;
+            while (reader.next(game))
+                for (size_t ply = 0; ply < game.moves.size(); ++ply)
+                {
+                    if (ply % 2 == 0)
+                        tokens.push_back({std::to_string(ply / 2 + 1), true});
+                    tokens.push_back({std::string(game.moves[ply]), false});
+                }
+        }
+
+        if (tokens.empty())
+            std::cerr << "no PGN game in " << CHESS_BENCH_PGN << '\n';
+        return tokens;
+    }
+
+    std::vector<PgnToken>& pgn_tokens(void)
+    {
+        static std::vector<PgnToken> tokens = load_pgn_tokens();
+        return tokens;
+    }
+
+    // Expressions of the PGN parser before pgn-lexer.hh
+    const char* const san_expression =
+        "[KQBNR]?[a-h]?[1-8]?[x-]?[a-h][1-8](=[QBNR])?[+#]?";
+    const char* const number_expression = "[[:digit:]]+";
+} // namespace
+
+// Attacks of every piece of a type, state.range(0) being the PieceType
+static void BM_GetTargets(benchmark::State& state)
+{
+    const auto piece = static_cast<PieceType>(state.range(0));
+    const auto& init = MoveInitialization::get_instance();
+    for (auto _ : state)
+        for (const auto& position : corpus())
+        {
+            const Board& board = position.board.get_board();
+            const uint64_t blockers = board();
+            for (const auto color : {Color::WHITE, Color::BLACK})
+            {
+                uint64_t pieces = board(piece, color);
+                for (int pos = utils::pop_lsb(pieces); pos >= 0;
+                     pos = utils::pop_lsb(pieces))
+                    benchmark::DoNotOptimize(piece == PieceType::PAWN
+                            ? init.get_pawn_targets(pos, color)
+                            : init.get_targets(piece, pos, blockers));
+            }
+        }
+    set_positions_processed(state);
+}
+BENCHMARK(BM_GetTargets)
+    ->ArgName("piece")
+    ->DenseRange(utils::utype(PieceType::QUEEN),
+                 utils::utype(PieceType::KING));
+
+static void BM_GenerateAllMoves(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            benchmark::DoNotOptimize(
+                    move_generation::generate_all_moves(position.board));
+    set_positions_processed(state);
+}
+BENCHMARK(BM_GenerateAllMoves);
+
+static void BM_GenerateLegalMoves(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (auto& position : corpus())
+            benchmark::DoNotOptimize(position.board.generate_legal_moves());
+    set_positions_processed(state);
+}
+BENCHMARK(BM_GenerateLegalMoves);
+
+// Every legal move of every position, on a copy of the board
+static void BM_DoMove(benchmark::State& state)
+{
+    size_t moves = 0;
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            for (const auto& move : position.legal_moves)
+            {
+                Chessboard board = position.board;
+                board.do_move(move);
+                benchmark::DoNotOptimize(board);
+                moves++;
+            }
+    state.SetItemsProcessed(moves);
+}
+BENCHMARK(BM_DoMove);
+
+// Every square of every position
+static void BM_PosThreatened(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            for (int pos = 0; pos < 64; ++pos)
+                benchmark::DoNotOptimize(
+                        position.board.pos_threatened(Position(pos)));
+    state.SetItemsProcessed(state.iterations() * corpus().size() * 64);
+}
+BENCHMARK(BM_PosThreatened);
+
+static void BM_IsCheck(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (auto& position : corpus())
+            benchmark::DoNotOptimize(position.board.is_check());
+    set_positions_processed(state);
+}
+BENCHMARK(BM_IsCheck);
+
+static void BM_Evaluate(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            benchmark::DoNotOptimize(ai::evaluate(position.board));
+    set_positions_processed(state);
+}
+BENCHMARK(BM_Evaluate);
+
+static void BM_FromFen(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            benchmark::DoNotOptimize(Chessboard::from_fen(position.fen));
+    set_positions_processed(state);
+}
+BENCHMARK(BM_FromFen);
+
+static void BM_ParsePerft(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            benchmark::DoNotOptimize(
+                    Chessboard(perft_parser::parse_perft(position.fen
+                                                         + " 1")));
+    set_positions_processed(state);
+}
+BENCHMARK(BM_ParsePerft);
+
+static void BM_WriteFen(benchmark::State& state)
+{
+    Chessboard::fen_buffer_t buffer;
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            benchmark::DoNotOptimize(position.board.write_fen(buffer));
+    set_positions_processed(state);
+}
+BENCHMARK(BM_WriteFen);
+
+// Every square of every position
+static void BM_BoardAt(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& position : corpus())
+            for (int pos = 0; pos < 64; ++pos)
+                benchmark::DoNotOptimize(
+                        position.board.get_board()[Position(pos)]);
+    state.SetItemsProcessed(state.iterations() * corpus().size() * 64);
+}
+BENCHMARK(BM_BoardAt);
+
+// The PGN parser used to compile its regex on every token: state.range(0)
+// is 0 to do the same, 1 to compile the expressions once
+static void BM_PgnTokensRegex(benchmark::State& state)
+{
+    const bool precompiled = state.range(0);
+    const std::regex san_regex{san_expression};
+    const std::regex number_regex{number_expression};
+    for (auto _ : state)
+        for (const auto& token : pgn_tokens())
+        {
+            const char* expression = token.number ? number_expression
+                                                  : san_expression;
+            const std::regex& regex = token.number ? number_regex
+                                                   : san_regex;
+            benchmark::DoNotOptimize(precompiled
+                    ? std::regex_match(token.text, regex)
+                    : std::regex_match(token.text, std::regex{expression}));
+        }
+    state.SetItemsProcessed(state.iterations() * pgn_tokens().size());
+}
+BENCHMARK(BM_PgnTokensRegex)->ArgName("precompiled")->Arg(0)->Arg(1);
+
+static void BM_PgnTokensLexer(benchmark::State& state)
+{
+    for (auto _ : state)
+        for (const auto& token : pgn_tokens())
+            benchmark::DoNotOptimize(token.number
+                    ? pgn_parser::lexer::is_turn_number(token.text)
+                    : pgn_parser::lexer::is_san_move(token.text));
+    state.SetItemsProcessed(state.iterations() * pgn_tokens().size());
+}
+BENCHMARK(BM_PgnTokensLexer);
+
+BENCHMARK_MAIN();
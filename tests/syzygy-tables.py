@@ -0,0 +1,499 @@
+#!/usr/bin/env python3
+"""Generate the KQvK and KRvK Syzygy tables of the unit tests.
+
+The tables are solved by retrograde analysis, then written in the format
+of the Syzygy files (.rtbw and .rtbz): the values are indexed as in
+src/chess_engine/syzygy/table.cc, compressed by recursive pairing and a
+canonical Huffman code, and split in blocks found through a sparse index.
+Every index is decoded back before the files are written.
+
+Usage: syzygy-tables.py [output directory, default: tests/syzygy]
+"""
+
+import heapq
+import os
+import struct
+import sys
+from bisect import bisect_right
+from collections import Counter
+
+WDL_MAGIC = 0x5d23e871
+DTZ_MAGIC = 0xa50c66d7
+
+# Flags of the pairs data
+STM = 1
+MAPPED = 2
+
+# Piece codes of the files
+KING, QUEEN, ROOK = 6, 5, 4
+BLACK = 8
+
+BLOCK_SIZE_LOG = 6  # 64 bytes blocks
+SPAN_LOG = 6        # A sparse index entry every 64 values
+MIN_PAIR_COUNT = 4  # Rarer pairs are not worth their 3 bytes of tree
+TABLE_SIZE = 31332  # Three unique pieces, see Table::set_groups
+
+KING_STEPS = [(-1, -1), (-1, 0), (-1, 1), (0, -1),
+              (0, 1), (1, -1), (1, 0), (1, 1)]
+SLIDES = {
+    QUEEN: KING_STEPS,
+    ROOK: [(-1, 0), (1, 0), (0, -1), (0, 1)],
+}
+
+
+def file_of(s):
+    return s % 8
+
+
+def rank_of(s):
+    return s // 8
+
+
+def off_diagonal(s):
+    return rank_of(s) - file_of(s)
+
+
+# Index of a position, as in Table::probe
+
+B1_H1_H7 = {}
+for s in range(64):
+    if off_diagonal(s) < 0:
+        B1_H1_H7[s] = len(B1_H1_H7)
+
+A1_D1_D4 = {}
+for s in range(64):
+    if off_diagonal(s) < 0 and file_of(s) <= 3 and rank_of(s) <= 3:
+        A1_D1_D4[s] = len(A1_D1_D4)
+for s in range(64):
+    if off_diagonal(s) == 0 and file_of(s) <= 3:
+        A1_D1_D4[s] = len(A1_D1_D4)
+
+
+def encode(squares):
+    """Index of three unique pieces, in the order of the file."""
+    sq = list(squares)
+    if file_of(sq[0]) > 3:
+        sq = [s ^ 7 for s in sq]
+    if rank_of(sq[0]) > 3:
+        sq = [s ^ 56 for s in sq]
+    for i in range(3):
+        if off_diagonal(sq[i]) == 0:
+            continue
+        if off_diagonal(sq[i]) > 0:
+            for j in range(i, 3):
+                sq[j] = ((sq[j] >> 3) | (sq[j] << 3)) & 63
+        break
+
+    adjust1 = int(sq[1] > sq[0])
+    adjust2 = int(sq[2] > sq[0]) + int(sq[2] > sq[1])
+    if off_diagonal(sq[0]):
+        return (A1_D1_D4[sq[0]] * 63 + (sq[1] - adjust1)) * 62 \
+            + sq[2] - adjust2
+    if off_diagonal(sq[1]):
+        return (6 * 63 + rank_of(sq[0]) * 28 + B1_H1_H7[sq[1]]) * 62 \
+            + sq[2] - adjust2
+    if off_diagonal(sq[2]):
+        return 6 * 63 * 62 + 4 * 28 * 62 + rank_of(sq[0]) * 7 * 28 \
+            + (rank_of(sq[1]) - adjust1) * 28 + B1_H1_H7[sq[2]]
+    return 6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 \
+        + rank_of(sq[0]) * 7 * 6 + (rank_of(sq[1]) - adjust1) * 6 \
+        + rank_of(sq[2]) - adjust2
+
+
+# Retrograde analysis of a king and a piece against a lone king
+
+def steps(s, directions, occupied):
+    """Squares reached from s, sliding up to the first occupied square
+    when occupied is not None."""
+    for df, dr in directions:
+        f, r = file_of(s) + df, rank_of(s) + dr
+        while 0 <= f < 8 and 0 <= r < 8:
+            t = r * 8 + f
+            yield t
+            if occupied is None or t in occupied:
+                break
+            f, r = f + df, r + dr
+
+
+def adjacent(a, b):
+    return max(abs(file_of(a) - file_of(b)),
+               abs(rank_of(a) - rank_of(b))) <= 1
+
+
+def slider_attacks(piece, s, target, blocker):
+    """Whether the piece on s attacks target, blocker being in the way."""
+    return target in steps(s, SLIDES[piece], {target, blocker})
+
+
+def solve(piece):
+    """Plies to mate of the positions (wk, piece, bk), for each side to
+    move: positive when white wins, negative when black loses, 0 for the
+    draws, None for the illegal positions."""
+    white = {}  # White to move
+    black = {}  # Black to move
+    moves_left = {}
+    mated = []
+
+    for wk in range(64):
+        for x in range(64):
+            for bk in range(64):
+                if len({wk, x, bk}) < 3 or adjacent(wk, bk):
+                    continue
+                if not slider_attacks(piece, x, bk, wk):
+                    white[wk, x, bk] = 0
+
+                # Black king moves, taking the piece leads to a draw
+                count = 0
+                for t in steps(bk, KING_STEPS, None):
+                    if adjacent(t, wk):
+                        continue
+                    if t == x or not slider_attacks(piece, x, t, wk):
+                        count += 1
+                        if t == x:
+                            count = 1 << 30
+                black[wk, x, bk] = 0
+                moves_left[wk, x, bk] = count
+                if count == 0 and slider_attacks(piece, x, bk, wk):
+                    mated.append((wk, x, bk))
+
+    def white_parents(position):
+        wk, x, bk = position
+        for f in steps(wk, KING_STEPS, None):
+            if f not in (x, bk) and not adjacent(f, bk) \
+                    and (f, x, bk) in white:
+                yield (f, x, bk)
+        for f in steps(x, SLIDES[piece], {wk, bk}):
+            if f not in (wk, bk) and (wk, f, bk) in white:
+                yield (wk, f, bk)
+
+    def black_parents(position):
+        wk, x, bk = position
+        for f in steps(bk, KING_STEPS, None):
+            if f not in (wk, x) and not adjacent(f, wk):
+                yield (wk, x, f)
+
+    for position in mated:
+        black[position] = -1
+    lost = mated
+    plies = 0
+    while lost:
+        won = []
+        for position in lost:
+            for parent in white_parents(position):
+                if white[parent] == 0:
+                    white[parent] = plies + 1
+                    won.append(parent)
+        lost = []
+        for position in won:
+            for parent in black_parents(position):
+                moves_left[parent] -= 1
+                if moves_left[parent] == 0:
+                    black[parent] = -(plies + 2)
+                    lost.append(parent)
+        plies += 2
+
+    return white, black
+
+
+# Compression
+
+class Pairs:
+    """Values of one side to move, compressed as read by Table::set_sizes
+    and Table::decompress."""
+
+    def __init__(self, values):
+        self.size = len(values)
+        self.single_value = len(set(values)) == 1
+        if self.single_value:
+            self.value = values[0]
+            return
+        symbols, lengths, sequence = self.pair(values)
+        self.huffman(symbols, lengths, sequence)
+        self.split()
+        self.index()
+
+    @staticmethod
+    def pair(values):
+        """Replace the most frequent pairs of symbols by new symbols."""
+        leaves = sorted(set(values))
+        # (value, None) for the leaves, (left, right) for the pairs
+        symbols = [(v, None) for v in leaves]
+        lengths = [1] * len(leaves)
+        leaf = {v: i for i, v in enumerate(leaves)}
+        sequence = [leaf[v] for v in values]
+
+        while len(symbols) < 0xfff:
+            best = None
+            counts = Counter(zip(sequence, sequence[1:]))
+            for (a, b), count in counts.most_common():
+                if count < MIN_PAIR_COUNT:
+                    break
+                if lengths[a] + lengths[b] <= 256:
+                    best = (a, b)
+                    break
+            if best is None:
+                break
+
+            new = len(symbols)
+            symbols.append(best)
+            lengths.append(lengths[best[0]] + lengths[best[1]])
+            paired = []
+            i = 0
+            while i < len(sequence):
+                if i + 1 < len(sequence) \
+                        and (sequence[i], sequence[i + 1]) == best:
+                    paired.append(new)
+                    i += 2
+                else:
+                    paired.append(sequence[i])
+                    i += 1
+            sequence = paired
+
+        return symbols, lengths, sequence
+
+    def huffman(self, symbols, lengths, sequence):
+        counts = Counter(sequence)
+        code_length = dict.fromkeys(counts, 0)
+        if len(counts) == 1:
+            code_length[sequence[0]] = 1
+        heap = [(count, s, [s]) for s, count in sorted(counts.items())]
+        heapq.heapify(heap)
+        while len(heap) > 1:
+            c1, k1, s1 = heapq.heappop(heap)
+            c2, k2, s2 = heapq.heappop(heap)
+            for s in s1 + s2:
+                code_length[s] += 1
+            heapq.heappush(heap, (c1 + c2, min(k1, k2), s1 + s2))
+
+        # Longer codes have the lower symbols, consecutive for each length,
+        # the symbols only found in pairs come last
+        coded = sorted(code_length, key=lambda s: (-code_length[s], s))
+        others = [s for s in range(len(symbols)) if s not in counts]
+        number = {s: i for i, s in enumerate(coded + others)}
+
+        self.btree = [None] * len(symbols)
+        self.lengths = [None] * len(symbols)
+        for old, new in number.items():
+            left, right = symbols[old]
+            self.btree[new] = (left, 0xfff) if right is None \
+                else (number[left], number[right])
+            self.lengths[new] = lengths[old]
+        self.sequence = [number[s] for s in sequence]
+        self.code_length = {number[s]: n for s, n in code_length.items()}
+
+        # Lowest symbol and code of each length, the longest codes being 0
+        self.min_length = min(code_length.values())
+        self.max_length = max(code_length.values())
+        per_length = Counter(self.code_length.values())
+        self.lowest = {}
+        self.base = {}
+        lowest = 0
+        base = 0
+        for length in range(self.max_length, self.min_length - 1, -1):
+            if length < self.max_length:
+                base = (base + per_length[length + 1]) // 2
+            self.lowest[length] = lowest
+            self.base[length] = base
+            lowest += per_length[length]
+
+    def code(self, symbol):
+        length = self.code_length[symbol]
+        return self.base[length] + symbol - self.lowest[length], length
+
+    def split(self):
+        # The decoder reads ahead: the last 64 bits of a block are unused
+        block_size = 1 << BLOCK_SIZE_LOG
+        budget = block_size * 8 - 64
+        self.blocks = []
+        self.block_lengths = []
+        block = []
+        bits = 0
+        values = 0
+        for symbol in self.sequence + [None]:
+            length = self.code(symbol)[1] if symbol is not None else 0
+            if symbol is None or (block and bits + length > budget) \
+                    or values + self.lengths[symbol] > 65536:
+                buffer = 0
+                for s in block:
+                    code, n = self.code(s)
+                    buffer = buffer << n | code
+                buffer <<= block_size * 8 - bits
+                self.blocks.append(buffer.to_bytes(block_size, 'big'))
+                self.block_lengths.append(values - 1)
+                block, bits, values = [], 0, 0
+            if symbol is not None:
+                block.append(symbol)
+                bits += length
+                values += self.lengths[symbol]
+
+    def index(self):
+        """Block and offset of the middle value of each span."""
+        starts = [0]
+        for length in self.block_lengths:
+            starts.append(starts[-1] + length + 1)
+        span = 1 << SPAN_LOG
+        self.sparse_index = []
+        for k in range((self.size + span - 1) // span):
+            target = k * span + span // 2
+            block = min(bisect_right(starts, target) - 1, len(self.blocks) - 1)
+            offset = target - starts[block]
+            assert offset < 1 << 16
+            self.sparse_index.append((block, offset))
+
+    def sizes(self, flags):
+        """Header of the pairs data, see Table::set_sizes."""
+        if self.single_value:
+            return bytes([flags | 0x80, self.value])
+        data = bytes([flags, BLOCK_SIZE_LOG, SPAN_LOG, 0])
+        data += struct.pack('<I', len(self.blocks))
+        data += bytes([self.max_length, self.min_length])
+        for length in range(self.min_length, self.max_length + 1):
+            data += struct.pack('<H', self.lowest[length])
+        data += struct.pack('<H', len(self.btree))
+        for left, right in self.btree:
+            data += bytes([left & 0xff, left >> 8 | (right & 0xf) << 4,
+                           right >> 4])
+        if len(self.btree) % 2:
+            data += b'\0'
+        return data
+
+    def decompress(self, index):
+        """Value of the index, as Table::decompress reads it."""
+        if self.single_value:
+            return self.value
+        span = 1 << SPAN_LOG
+        block, offset = self.sparse_index[index // span]
+        offset += index % span - span // 2
+        while offset < 0:
+            block -= 1
+            offset += self.block_lengths[block] + 1
+        while offset > self.block_lengths[block]:
+            offset -= self.block_lengths[block] + 1
+            block += 1
+
+        bits = ''.join(format(b, '08b') for b in self.blocks[block])
+        position = 0
+        while True:
+            for length in range(self.min_length, self.max_length + 1):
+                code = int(bits[position:position + length], 2)
+                first = self.base[length]
+                count = sum(1 for n in self.code_length.values()
+                            if n == length)
+                if first <= code < first + count:
+                    symbol = self.lowest[length] + code - first
+                    break
+            position += length
+            if offset < self.lengths[symbol]:
+                break
+            offset -= self.lengths[symbol]
+
+        while self.btree[symbol][1] != 0xfff:
+            left, right = self.btree[symbol]
+            if offset < self.lengths[left]:
+                symbol = left
+            else:
+                offset -= self.lengths[left]
+                symbol = right
+        return self.btree[symbol][0]
+
+
+def align(data, alignment):
+    return data + b'\0' * (-len(data) % alignment)
+
+
+def table_file(magic, pieces, sides, flags, dtz_map=None):
+    """Whole file, the pairs data of each side to move in sides."""
+    data = struct.pack('<I', magic)
+    data += bytes([1, 0])  # Different material for both sides, group order
+    data += bytes(piece | piece << 4 for piece in pieces)
+    data = align(data, 2)
+    for pairs in sides:
+        data += pairs.sizes(flags)
+    if dtz_map is not None:
+        for values in dtz_map:
+            data += bytes([len(values)] + values)
+        data = align(data, 2)
+    for pairs in sides:
+        if not pairs.single_value:
+            for block, offset in pairs.sparse_index:
+                data += struct.pack('<IH', block, offset)
+    for pairs in sides:
+        if not pairs.single_value:
+            for length in pairs.block_lengths:
+                data += struct.pack('<H', length)
+    for pairs in sides:
+        if not pairs.single_value:
+            data = align(data, 64)
+            data += b''.join(pairs.blocks)
+    # Checksum of the generator, not read by the decoder
+    return align(data, 64) + b'\0' * 16
+
+
+def fill(values):
+    """Give the values of the positions which cannot be probed (illegal,
+    or not stored) the one of the previous index, for longer runs."""
+    first = next(v for v in values if v is not None)
+    previous = first
+    for i, value in enumerate(values):
+        if value is None:
+            values[i] = previous
+        else:
+            previous = value
+    return values
+
+
+def generate(piece, name, directory):
+    white, black = solve(piece)
+    # Pieces in the order of the file, white first
+    order = [KING, piece, KING | BLACK]
+
+    wdl = [[None] * TABLE_SIZE for _ in range(2)]
+    dtz = [None] * TABLE_SIZE
+    for side, positions in enumerate((white, black)):
+        for (wk, x, bk), plies in positions.items():
+            index = encode((wk, x, bk))
+            value = 4 if plies > 0 else 0 if plies < 0 else 2
+            assert wdl[side][index] in (None, value)
+            wdl[side][index] = value
+            # White wins in an odd number of plies, stored in moves
+            if side == 0 and plies > 0:
+                assert dtz[index] in (None, plies)
+                dtz[index] = plies
+
+    longest = max(v for v in dtz if v is not None)
+    print(f'{name}: longest win in {longest} plies')
+
+    sides = [Pairs(fill(values)) for values in wdl]
+    for side, values in zip(sides, wdl):
+        for i, value in enumerate(values):
+            assert side.decompress(i) == value
+    with open(os.path.join(directory, name + '.rtbw'), 'wb') as file:
+        file.write(table_file(WDL_MAGIC, order, sides, 0))
+
+    # The values are the indices in the map of the wins, the most frequent
+    # distances first
+    moves = Counter((v - 1) // 2 for v in dtz if v is not None)
+    win_map = [m for m, _ in sorted(moves.items(),
+                                    key=lambda item: (-item[1], item[0]))]
+    symbol = {m: i for i, m in enumerate(win_map)}
+    stored = fill([None if v is None else symbol[(v - 1) // 2]
+                   for v in dtz])
+    pairs = Pairs(stored)
+    for i, value in enumerate(stored):
+        assert pairs.decompress(i) == value
+    # Only white to move is stored (STM clear)
+    with open(os.path.join(directory, name + '.rtbz'), 'wb') as file:
+        file.write(table_file(DTZ_MAGIC, order, [pairs], MAPPED,
+                              [win_map, [], [], []]))
+
+
+def main():
+    directory = sys.argv[1] if len(sys.argv) > 1 \
+        else os.path.join(os.path.dirname(__file__), 'syzygy')
+    os.makedirs(directory, exist_ok=True)
+    generate(QUEEN, 'KQvK', directory)
+    generate(ROOK, 'KRvK', directory)
+
+
+if __name__ == '__main__':
+    main()
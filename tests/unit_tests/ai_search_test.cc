@@ -1,8 +1,12 @@
 #include "gtest/gtest.h"
 
+#include <thread>
 #include <optional>
+#include <algorithm>
+#include <sstream>
 
 #include "chess_engine/ai/ai-mini.hh"
+#include "chess_engine/ai/bench.hh"
 #include "chess_engine/board/chessboard.hh"
 
 using namespace board;
@@ -30,6 +34,154 @@ TEST(Check, minimax_search_simple_checkmat2)
     EXPECT_EQ(File::G, bestmove.value().get_end().get_file());
 }
 
+TEST(Check, iterative_search)
+{
+    ai::AiMini our_ai = ai::AiMini();
+    Chessboard chessboard = Chessboard::from_fen("4r2k/6pp/7N/3Q4/8/8/8/6K1 w - -");
+
+    std::vector<int16_t> depths;
+    const auto info = our_ai.search(chessboard, ai::SearchLimits{8, {}},
+                                     [&](const ai::SearchInfo& iteration)
+                                     {
+                                         depths.push_back(iteration.depth);
+                                     });
+    // The search stops once the mate is found
+    EXPECT_EQ(depths, (std::vector<int16_t>{1, 2, 3, 4}));
+    EXPECT_EQ(info.depth, 4);
+    EXPECT_EQ(info.score, INT16_MAX);
+    EXPECT_GT(info.stats.nodes, 0);
+    EXPECT_EQ(info.stats.iteration_times.size(), depths.size());
+    ASSERT_TRUE(info.move.has_value());
+    EXPECT_EQ(PieceType::QUEEN, info.move.value().get_piece());
+}
+
+TEST(Check, search_stats)
+{
+    ai::AiMini our_ai = ai::AiMini();
+    Chessboard chessboard = Chessboard::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+
+    const auto info = our_ai.search(chessboard, ai::SearchLimits{3, {}});
+    const auto& stats = info.stats;
+    EXPECT_EQ(info.depth, 3);
+    EXPECT_GT(stats.qnodes, 0);
+    EXPECT_LT(stats.qnodes, stats.nodes);
+    EXPECT_GT(stats.seldepth, info.depth);
+    EXPECT_GT(stats.beta_cutoffs, 0);
+    EXPECT_LE(stats.first_move_cutoffs, stats.beta_cutoffs);
+    EXPECT_EQ(stats.iteration_times.size(), 3u);
+
+    // The principal variation is a legal line starting with the move
+    ASSERT_FALSE(info.pv.empty());
+    ASSERT_TRUE(info.move.has_value());
+    EXPECT_EQ(info.pv.front(), info.move.value());
+    for (const auto& move : info.pv)
+    {
+        const auto legal_moves = chessboard.generate_legal_moves();
+        EXPECT_NE(std::find(legal_moves.begin(), legal_moves.end(), move),
+                  legal_moves.end());
+        chessboard.do_move(move);
+    }
+
+    std::ostringstream json;
+    ai::write_json(json, stats);
+    EXPECT_NE(json.str().find("\"nodes\":" + std::to_string(stats.nodes)),
+              std::string::npos);
+    EXPECT_NE(json.str().find("\"iteration_times_ms\":["),
+              std::string::npos);
+}
+
+TEST(Check, multipv)
+{
+    ai::AiMini our_ai = ai::AiMini();
+    Chessboard chessboard = Chessboard::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+
+    ai::SearchLimits limits{3, {}};
+    const auto single = our_ai.search(chessboard, limits);
+    our_ai.clear();
+    limits.multipv = 3;
+    const auto info = our_ai.search(chessboard, limits);
+
+    // The first line is the search of a single line
+    ASSERT_EQ(info.lines.size(), 3u);
+    EXPECT_EQ(info.lines.front().score, single.score);
+    EXPECT_EQ(info.lines.front().pv.front(), single.move.value());
+    EXPECT_EQ(info.pv, info.lines.front().pv);
+
+    // Distinct moves, best first for white
+    for (size_t i = 1; i < info.lines.size(); ++i)
+    {
+        EXPECT_NE(info.lines[i].pv.front(), info.lines[i - 1].pv.front());
+        EXPECT_LE(info.lines[i].score, info.lines[i - 1].score);
+    }
+    EXPECT_NE(info.lines[0].pv.front(), info.lines[2].pv.front());
+
+    // No more lines than legal moves
+    Chessboard mate = Chessboard::from_fen("4r2k/6pp/7N/3Q4/8/8/8/6K1 w - -");
+    limits.multipv = 500;
+    limits.depth = 1;
+    EXPECT_EQ(our_ai.search(mate, limits).lines.size(),
+              mate.generate_legal_moves().size());
+}
+
+TEST(Check, iterative_search_movetime)
+{
+    ai::AiMini our_ai = ai::AiMini();
+    Chessboard chessboard = Chessboard();
+
+    const auto movetime = std::chrono::milliseconds(100);
+    const auto info = our_ai.search(chessboard,
+                                    ai::SearchLimits{64, movetime});
+    EXPECT_TRUE(info.move.has_value());
+    EXPECT_GE(info.depth, 1);
+    EXPECT_LT(info.depth, 64);
+    EXPECT_LT(info.time, 2 * movetime);
+}
+
+TEST(Check, iterative_search_control)
+{
+    ai::AiMini our_ai = ai::AiMini();
+    Chessboard chessboard = Chessboard();
+
+    // Without limit but the control, as for go infinite
+    ai::SearchControl control;
+    ai::SearchLimits limits;
+    limits.control = &control;
+    std::thread stopper([&control]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        control.stop();
+    });
+    const auto info = our_ai.search(chessboard, limits);
+    stopper.join();
+    EXPECT_TRUE(info.move.has_value());
+    EXPECT_LT(info.depth, 64);
+    EXPECT_LT(info.time, std::chrono::seconds(2));
+
+    // A deadline in the past, as for a late ponderhit: only the first
+    // iteration completes
+    control.reset();
+    control.set_deadline(ai::SearchControl::clock::now());
+    const auto late = our_ai.search(chessboard, limits);
+    EXPECT_EQ(late.depth, 1);
+    EXPECT_TRUE(late.move.has_value());
+}
+
+TEST(Check, bench_signature)
+{
+    // Any change of the search moves this total: update it on purpose,
+    // with the one of `chessengine bench` in the commit message
+    constexpr uint64_t depth_2_nodes = 19308;
+    std::ostringstream single, parallel;
+    const auto result = ai::bench(2, 1, single);
+
+    EXPECT_EQ(ai::bench_size(), 50);
+    EXPECT_EQ(result.nodes, depth_2_nodes);
+    EXPECT_EQ(ai::bench(2, 4, parallel).nodes, result.nodes);
+    EXPECT_NE(single.str().find("nodes searched : "
+                                + std::to_string(result.nodes)),
+              std::string::npos);
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/board/move-initialization.hh"
+#include "chess_engine/book/book-builder.hh"
+#include "chess_engine/book/polyglot.hh"
+#include "parsing/pgn_parser/pgn-database.hh"
+#include "parsing/pgn_parser/pgn-parser.hh"
+
+using namespace board;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    void write_game(const fs::path& path, const std::string& movetext)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path);
+        file << "[Event \"?\"]\n[Site \"?\"]\n\n" << movetext << '\n';
+    }
+
+    // First game of the file
+    pgn_parser::PgnGame read_game(const fs::path& path)
+    {
+        pgn_parser::PgnReader reader(path.string());
+        pgn_parser::PgnGameView game;
+        EXPECT_TRUE(reader.next(game));
+        return pgn_parser::parse_game(game);
+    }
+
+    class BookBuilderTest : public ::testing::Test
+    {
+    protected:
+        fs::path directory_ = fs::temp_directory_path() / "book_builder_test";
+        fs::path book_ = directory_ / "book.bin";
+
+        void SetUp() override
+        {
+            MoveInitialization::get_instance();
+            fs::remove_all(directory_);
+            write_game(directory_ / "a.pgn",
+                       "1. e2-e4 e7-e5 2. Ng1-f3 Nb8-c6 1-0");
+            write_game(directory_ / "b.pgn", "1. e2-e4 c7-c5 1/2-1/2");
+            write_game(directory_ / "nested" / "c.pgn",
+                       "1. d2-d4 d7-d5 0-1");
+            write_game(directory_ / "unfinished.pgn", "1. e2-e4 e7-e5 *");
+            write_game(directory_ / "illegal.pgn", "1. e2-e5 e7-e5 1-0");
+            write_game(directory_ / "notes.txt", "1. g2-g4 e7-e5 1-0");
+        }
+
+        void TearDown() override
+        {
+            book::Book::unload();
+            fs::remove_all(directory_);
+        }
+    };
+} // namespace
+
+TEST_F(BookBuilderTest, FindFiles)
+{
+    const auto files = pgn_parser::find_pgn_files({directory_.string()});
+
+    EXPECT_EQ(files.size(), 5);
+}
+
+TEST_F(BookBuilderTest, ParseResult)
+{
+    using pgn_parser::GameResult;
+
+    const auto game = read_game(directory_ / "a.pgn");
+    EXPECT_EQ(game.moves.size(), 4);
+    EXPECT_EQ(game.result, GameResult::WHITE_WIN);
+    EXPECT_EQ(read_game(directory_ / "unfinished.pgn").result,
+              GameResult::UNKNOWN);
+}
+
+TEST_F(BookBuilderTest, Weights)
+{
+    book::BuilderOptions options;
+    options.plies = 2;
+    options.threads = 4;
+
+    // 1.e4 (win, draw), 1...c5 (draw), 1.d4 d5 (win for black)
+    // Losing moves have no weight
+    ASSERT_EQ(book::build_book({directory_.string()}, book_.string(),
+                               options), 3);
+    ASSERT_TRUE(book::Book::load(book_.string()));
+
+    Chessboard board;
+    auto moves = book::Book::get()->lookup(board);
+    ASSERT_EQ(moves.size(), 1);
+    EXPECT_EQ(moves[0].move.get_end().get_index(), 28); // e4
+    EXPECT_EQ(moves[0].weight, 3);
+
+    board.do_move(moves[0].move);
+    moves = book::Book::get()->lookup(board);
+    ASSERT_EQ(moves.size(), 1);
+    EXPECT_EQ(moves[0].move.get_end().get_index(), 34); // c5
+    EXPECT_EQ(moves[0].weight, 1);
+}
+
+TEST_F(BookBuilderTest, MinGames)
+{
+    book::BuilderOptions options;
+    options.min_games = 2;
+
+    ASSERT_EQ(book::build_book({directory_.string()}, book_.string(),
+                               options), 1);
+}
+
+TEST_F(BookBuilderTest, IllegalGame)
+{
+    book::BookBuilder builder(book::BuilderOptions{});
+
+    EXPECT_FALSE(builder.add_game(read_game(directory_ / "illegal.pgn")));
+    EXPECT_TRUE(builder.add_game(read_game(directory_ / "a.pgn")));
+    EXPECT_EQ(builder.size(), 4);
+}
+
+TEST_F(BookBuilderTest, MultiGameFile)
+{
+    const auto database = directory_ / "database";
+    write_game(database / "games.pgn",
+               "1. e2-e4 {main} e7-e5 (1... c7-c5) 1-0\n\n"
+               "[Event \"?\"]\n1. e2-e4 e7-e5 1-0\n\n"
+               "[Event \"?\"]\n1. d2-d4 1/2-1/2");
+
+    book::BuilderOptions options;
+    ASSERT_EQ(book::build_book({database.string()}, book_.string(),
+                               options), 2);
+    ASSERT_TRUE(book::Book::load(book_.string()));
+
+    const auto moves = book::Book::get()->lookup(Chessboard());
+    ASSERT_EQ(moves.size(), 2);
+    EXPECT_EQ(moves[0].weight, 4); // e4: 2 wins
+    EXPECT_EQ(moves[1].weight, 1); // d4: 1 draw
+}
@@ -244,6 +244,103 @@ TEST(Constructor, PerftObjectTurn)
     EXPECT_FALSE(black_turn_board.get_white_turn());
 }
 
+TEST(FromFen, SameAsPerftParser)
+{
+    auto fen_strings = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnb1kbNr/2pPPppp/7r/P4P2/3N4/8/1Q1Q1Q1Q/6r1 b - f6 0 1",
+        "8/8/8/8/8/8/8/8 w kQ - 0 1",
+    };
+
+    for (const std::string fen_string : fen_strings)
+        EXPECT_EQ(Chessboard::from_fen(fen_string),
+                  Chessboard(parse_perft(fen_string + " 0"))) << fen_string;
+}
+
+TEST(FromFen, Clocks)
+{
+    auto board = Chessboard::from_fen(
+            "4k3/8/8/8/8/8/8/4K2R b K - 37 52");
+    EXPECT_EQ(board.get_halfmove_clock(), 37);
+    EXPECT_EQ(board.get_fullmove_number(), 52);
+
+    board.do_move(dummy_move(Position(File::E, Rank::EIGHT),
+                             Position(File::D, Rank::EIGHT),
+                             PieceType::KING));
+    EXPECT_EQ(board.get_halfmove_clock(), 38);
+    EXPECT_EQ(board.get_fullmove_number(), 53);
+
+    board = Chessboard::from_fen("4k3/8/8/8/8/8/8/4K3 w - e3");
+    EXPECT_EQ(board.get_halfmove_clock(), 0);
+    EXPECT_EQ(board.get_fullmove_number(), 1);
+    EXPECT_EQ(board.get_en_passant(), Position(File::E, Rank::THREE));
+
+    EXPECT_TRUE(Chessboard::from_fen("4k3/8/8/8/8/8/8/4K3 w - - 100 80")
+                .is_draw());
+}
+
+TEST(FromFen, Malformed)
+{
+    auto fen_strings = {
+        "",
+        "4k3/8/8/8/8/8/8/4K3",
+        "4k3/8/8/8/8/8/8/4K3 x - -",
+        "4k3/8/8/8/8/8/8/4K2 w - -",
+        "4k3/8/8/8/8/8/8/4K4 w - -",
+        "4k3/8/8/8/8/8/8/8/4K3 w - -",
+        "4k3/8/8/8/8/8/4K3 w - -",
+        "4x3/8/8/8/8/8/8/4K3 w - -",
+        "4k3/8/8/8/8/8/8/4K3 w A -",
+        "4k3/8/8/8/8/8/8/4K3 w - e4",
+        "4k3/8/8/8/8/8/8/4K3 w - - x 1",
+        "4k3/8/8/8/8/8/8/4K3 w - - 0 1 1",
+    };
+
+    for (const char* fen_string : fen_strings)
+        EXPECT_THROW(Chessboard::from_fen(fen_string), std::invalid_argument)
+            << fen_string;
+}
+
+TEST(WriteFen, RoundTrip)
+{
+    auto fen_strings = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnb1kbNr/2pPPppp/7r/P4P2/3N4/8/1Q1Q1Q1Q/6r1 b - f6 0 1",
+        "8/8/8/8/8/8/8/8 w Qk - 0 1",
+        "4k3/8/8/8/8/8/8/4K2R b K - 37 52",
+        "4k3/8/8/8/8/8/8/4K2R b K - 4294967295 4294967295",
+    };
+
+    Chessboard::fen_buffer_t buffer;
+    for (const std::string fen_string : fen_strings)
+    {
+        EXPECT_EQ(Chessboard::from_fen(fen_string).write_fen(buffer),
+                  fen_string);
+        EXPECT_EQ(Chessboard::from_fen(Chessboard::from_fen(fen_string)
+                                       .write_fen(buffer)),
+                  Chessboard::from_fen(fen_string));
+    }
+}
+
+TEST(WriteFen, AfterMoves)
+{
+    Chessboard board;
+    Chessboard::fen_buffer_t buffer;
+
+    board.do_move(dummy_double_pawn_push_move(Position(File::E, Rank::TWO),
+                                              Position(File::E, Rank::FOUR)));
+    EXPECT_EQ(board.write_fen(buffer),
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+
+    board.do_move(dummy_move(Position(File::G, Rank::EIGHT),
+                             Position(File::F, Rank::SIX),
+                             PieceType::KNIGHT));
+    EXPECT_EQ(board.write_fen(buffer),
+        "rnbqkb1r/pppppppp/5n2/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 1 2");
+}
+
 TEST(ToFenString, AfterConstruction)
 {
     auto fen_strings = {
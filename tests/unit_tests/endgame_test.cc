@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include "chess_engine/ai/endgame.hh"
+#include "chess_engine/ai/evaluation.hh"
+#include "chess_engine/ai/kpk.hh"
+
+using namespace board;
+using namespace ai;
+
+TEST(EndgameMaterialKey, SameSignature)
+{
+    Chessboard board = Chessboard("8/8/3k4/8/8/8/1R6/K7");
+
+    EXPECT_EQ(endgame::material_key(board.get_board()),
+              endgame::signature_key("KRvK", Color::WHITE));
+    EXPECT_NE(endgame::material_key(board.get_board()),
+              endgame::signature_key("KRvK", Color::BLACK));
+}
+
+TEST(EndgameInsufficientMaterial, OnlyKings)
+{
+    Chessboard board = Chessboard("7k/8/8/8/8/8/8/K7");
+
+    auto score = endgame::evaluate(board);
+    ASSERT_TRUE(score.has_value());
+    EXPECT_EQ(score->value, 0);
+    EXPECT_TRUE(score->exact);
+}
+
+TEST(EndgameInsufficientMaterial, LonelyBishop)
+{
+    Chessboard board = Chessboard("7k/8/8/8/8/8/8/KB6");
+
+    EXPECT_TRUE(endgame::is_insufficient_material(board.get_board()));
+    EXPECT_EQ(evaluate(board), 0);
+}
+
+TEST(EndgameInsufficientMaterial, SameColorBishops)
+{
+    Chessboard same = Chessboard("7k/8/8/8/8/8/b7/KB6");
+    Chessboard opposite = Chessboard("7k/8/8/8/8/8/8/KBb5");
+
+    EXPECT_TRUE(endgame::is_insufficient_material(same.get_board()));
+    EXPECT_FALSE(endgame::is_insufficient_material(opposite.get_board()));
+}
+
+TEST(EndgameKnownWin, RookForBlack)
+{
+    Chessboard board = Chessboard("8/8/3k4/8/8/8/1r6/K7");
+
+    auto score = endgame::evaluate(board);
+    ASSERT_TRUE(score.has_value());
+    EXPECT_LE(score->value, -endgame::known_win);
+}
+
+TEST(EndgameKnownWin, CornerKingIsBetter)
+{
+    Chessboard center = Chessboard("8/8/8/3k4/8/8/1Q6/K7");
+    Chessboard corner = Chessboard("k7/8/8/8/8/8/1Q6/K7");
+
+    EXPECT_GT(evaluate(corner), evaluate(center));
+}
+
+TEST(EndgameScaleFactor, OppositeColorBishops)
+{
+    Chessboard opposite = Chessboard("7k/5p2/8/8/8/8/PPP5/KB4b1");
+    Chessboard same = Chessboard("7k/5p2/8/8/8/8/PPP5/KB3b2");
+
+    EXPECT_EQ(endgame::scale_factor(opposite.get_board()),
+              endgame::scale_normal / 2);
+    EXPECT_EQ(endgame::scale_factor(same.get_board()),
+              endgame::scale_normal);
+}
+
+TEST(EndgameKPK, OutsideTheSquare)
+{
+    Chessboard board = Chessboard("7k/8/8/P7/8/8/8/7K", Color::WHITE);
+
+    auto score = endgame::evaluate(board);
+    ASSERT_TRUE(score.has_value());
+    EXPECT_TRUE(score->exact);
+    EXPECT_GE(score->value, endgame::known_win);
+}
+
+TEST(EndgameKPK, OutsideTheSquareForBlack)
+{
+    Chessboard board = Chessboard("7k/8/8/8/p7/8/8/7K", Color::BLACK);
+
+    auto score = endgame::evaluate(board);
+    ASSERT_TRUE(score.has_value());
+    EXPECT_TRUE(score->exact);
+    EXPECT_LE(score->value, -endgame::known_win);
+}
+
+TEST(EndgameKPK, RookPawnDraw)
+{
+    Chessboard board = Chessboard("k7/8/8/PK6/8/8/8/8", Color::WHITE);
+
+    auto score = endgame::evaluate(board);
+    ASSERT_TRUE(score.has_value());
+    EXPECT_TRUE(score->exact);
+    EXPECT_EQ(score->value, 0);
+}
+
+TEST(EndgameKPK, KingInFrontOfThePawn)
+{
+    // White king on e6, pawn on e5, black king on e8
+    for (const auto color : {Color::WHITE, Color::BLACK})
+        EXPECT_TRUE(endgame::kpk::probe(Color::WHITE, 44, 36, 60, color));
+}
+
+TEST(EndgameKPK, Opposition)
+{
+    // White king on e4, pawn on e3, black king on e6: the side to move
+    // loses the opposition
+    EXPECT_FALSE(endgame::kpk::probe(Color::WHITE, 28, 20, 44, Color::WHITE));
+    EXPECT_TRUE(endgame::kpk::probe(Color::WHITE, 28, 20, 44, Color::BLACK));
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "chess_engine/ai/epd-suite.hh"
+#include "chess_engine/board/move-initialization.hh"
+#include "parsing/epd_parser/epd-parser.hh"
+
+using namespace epd_parser;
+
+TEST(EpdParser, Operations)
+{
+    const EpdRecord record = parse_epd_line(
+        "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - "
+        "bm Qxf7#; am Qxe5+ Nf3; id \"mate; in one\"; c0 \"comment\"");
+
+    EXPECT_EQ(record.fen,
+        "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq -");
+    EXPECT_EQ(record.operations.size(), 4);
+    ASSERT_NE(record.operation("bm"), nullptr);
+    EXPECT_EQ(*record.operation("bm"), (std::vector<std::string>{"Qxf7#"}));
+    EXPECT_EQ(*record.operation("am"),
+              (std::vector<std::string>{"Qxe5+", "Nf3"}));
+    EXPECT_EQ(record.id(), "mate; in one");
+    EXPECT_EQ(record.operation("dm"), nullptr);
+
+    EXPECT_TRUE(parse_epd_line("8/8/8/8/8/8/8/K1k5 b - -").operations
+                .empty());
+    EXPECT_EQ(parse_epd_line("8/8/8/8/8/8/8/K1k5 b - - bm Kb2").operation(
+                  "bm")->size(), 1);
+}
+
+TEST(EpdParser, Malformed)
+{
+    EXPECT_THROW(parse_epd_line("8/8/8/8/8/8/8/K1k5 b -"),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_epd_line("8/8/8/8/8/8/8/K1k5 b - - id \"open;"),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_epd_line("8/8/8/8/8/8/8/K1k5 b - - bm Kb2;;"),
+                 std::invalid_argument);
+}
+
+TEST(EpdSuite, Solve)
+{
+    board::MoveInitialization::get_instance();
+    const auto path = std::filesystem::temp_directory_path() / "suite.epd";
+    std::ofstream(path)
+        << "# short mates\n"
+        << "4r2k/6pp/7N/3Q4/8/8/8/6K1 w - - bm Qg8+; id \"smothered\";\n"
+        << "\n"
+        << "6k1/5ppp/8/8/8/8/8/R5K1 w - - bm Ra8#; id \"back rank\";\n"
+        << "6k1/5ppp/8/8/8/8/8/R5K1 w - - am Ra8#; id \"avoid\";\n"
+        << "6k1/5ppp/8/8/8/8/8/R5K1 w - - bm Rh8#;\n";
+
+    ai::EpdOptions options;
+    options.limits.depth = 4;
+    options.threads = 2;
+    std::ostringstream report;
+    const ai::EpdSummary summary = ai::run_epd(path.string(), options,
+                                               report);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(summary.positions, 4);
+    EXPECT_EQ(summary.solved, 2);
+    EXPECT_EQ(summary.errors, 1);
+    EXPECT_GT(summary.nodes, 0);
+    EXPECT_NE(report.str().find("smothered: solved, played Qg8+"),
+              std::string::npos) << report.str();
+    EXPECT_NE(report.str().find("avoid: failed, played Ra8#"),
+              std::string::npos) << report.str();
+    EXPECT_NE(report.str().find("#4: error"), std::string::npos)
+        << report.str();
+}
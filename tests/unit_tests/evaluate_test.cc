@@ -141,6 +141,31 @@ TEST(EvaluateSquares, KingEndGame)
     EXPECT_EQ(evaluate_squares(board), 0 - (-30));
 }
 
+TEST(LazyEvaluate, InsideWindow)
+{
+    Chessboard board = Chessboard("1q2k3/8/8/8/8/8/8/R3K3");
+
+    EXPECT_EQ(evaluate(board, -1000, 1000), evaluate(board));
+}
+
+TEST(LazyEvaluate, FailLow)
+{
+    // Black is a queen up, far below a window around 0
+    Chessboard board = Chessboard("1q2k3/8/8/8/8/8/8/R3K3");
+    const int lazy = evaluate(board, -50, 50);
+
+    EXPECT_LE(lazy, -50);
+    EXPECT_GE(lazy, evaluate(board));
+}
+
+TEST(LazyEvaluate, FailHigh)
+{
+    Chessboard board = Chessboard("r3k3/8/8/8/8/8/8/1Q2K3");
+    const int lazy = evaluate(board, -50, 50);
+
+    EXPECT_GE(lazy, 50);
+    EXPECT_LE(lazy, evaluate(board));
+}
 
 int main(int argc, char **argv)
 {
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "chess_engine/ai/gensfen.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace ai;
+
+namespace
+{
+    std::string fen_of(const board::Chessboard& board)
+    {
+        board::Chessboard::fen_buffer_t buffer;
+        return std::string(board.write_fen(buffer));
+    }
+}
+
+TEST(Gensfen, PackRoundTrip)
+{
+    board::MoveInitialization::get_instance();
+    // The fullmove numbers are the ones of the plies
+    const std::vector<std::pair<std::string, uint16_t>> positions{
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0},
+        {"rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2", 2},
+        {"r3k2r/8/8/3pP3/8/8/8/R3K2R w Kq d6 0 21", 40},
+        {"8/8/8/8/3k4/8/3K4/8 b - - 37 50", 99},
+    };
+    for (const auto& [fen, ply] : positions)
+    {
+        const auto board = board::Chessboard::from_fen(fen);
+        const PackedSfen sfen = pack(board, -42, 1, ply);
+        EXPECT_EQ(sfen.score, -42);
+        EXPECT_EQ(sfen.result, 1);
+        EXPECT_EQ(sfen.ply, ply);
+        EXPECT_EQ(fen_of(unpack(sfen)), fen);
+    }
+
+    const auto sfen = pack(board::Chessboard(), 0, 0, 0);
+    EXPECT_EQ(sfen.occupancy, 0xffff00000000ffffULL);
+    // a8 is a black rook, b8 a black knight
+    EXPECT_EQ(sfen.pieces[0], 9 | 7 << 4);
+    EXPECT_EQ(sfen.state, 0b11110);
+    EXPECT_EQ(sfen.en_passant, 8);
+}
+
+TEST(Gensfen, InvalidRecord)
+{
+    PackedSfen sfen;
+    sfen.occupancy = 1;
+    sfen.pieces[0] = 12;
+    EXPECT_THROW(unpack(sfen), std::invalid_argument);
+    sfen.occupancy = ~0ULL;
+    sfen.pieces[0] = 0;
+    EXPECT_THROW(unpack(sfen), std::invalid_argument);
+}
+
+TEST(Gensfen, Generate)
+{
+    board::MoveInitialization::get_instance();
+    const auto path = std::filesystem::temp_directory_path()
+                      / "gensfen_test.bin";
+
+    GensfenOptions options;
+    options.limits.depth = 1;
+    options.positions = 300;
+    options.threads = 2;
+    options.max_plies = 60;
+    std::ostringstream report;
+    const auto summary = gensfen(path, options, report);
+    EXPECT_EQ(summary.positions, 300);
+    EXPECT_GT(summary.games, 0);
+    EXPECT_NE(report.str().find("300 / 300 positions"), std::string::npos);
+
+    // The blocks fill the file without gap
+    ASSERT_EQ(std::filesystem::file_size(path), 300 * sizeof(PackedSfen));
+    std::ifstream file(path, std::ios::binary);
+    std::vector<PackedSfen> records(300);
+    file.read(reinterpret_cast<char*>(records.data()),
+              records.size() * sizeof(PackedSfen));
+    for (const auto& record : records)
+    {
+        auto board = unpack(record);
+        EXPECT_FALSE(board.is_check());
+        EXPECT_GE(record.ply, options.random_plies);
+        EXPECT_LT(record.ply, options.max_plies);
+        EXPECT_GE(record.result, -1);
+        EXPECT_LE(record.result, 1);
+        EXPECT_LT(std::abs(record.score), options.score_limit);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+#include <stdexcept>
+
+#include "match/match.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace match;
+using namespace std::chrono_literals;
+
+namespace
+{
+    Opening opening_of(const std::string& fen)
+    {
+        board::MoveInitialization::get_instance();
+        return Opening{board::Chessboard::from_fen(fen), "fen " + fen, fen};
+    }
+
+    // Without the tags
+    std::string movetext(const std::string& pgn)
+    {
+        const auto start = pgn.find("\n\n");
+        EXPECT_NE(start, std::string::npos);
+        return pgn.substr(start + 2);
+    }
+} // namespace
+
+TEST(Match, ParseTimeControl)
+{
+    const auto blitz = parse_time_control("10+0.1");
+    EXPECT_EQ(blitz.base, 10000ms);
+    EXPECT_EQ(blitz.increment, 100ms);
+    const auto sudden_death = parse_time_control("60");
+    EXPECT_EQ(sudden_death.base, 60000ms);
+    EXPECT_EQ(sudden_death.increment, 0ms);
+    EXPECT_EQ(parse_time_control("0.5+0").base, 500ms);
+
+    for (const std::string text : {"", "abc", "10+", "+1", "-1", "0", "0+1",
+                                   "10+x", "10+-1", "1s"})
+        EXPECT_THROW(parse_time_control(text), std::invalid_argument)
+            << text;
+}
+
+TEST(Match, WritePgnTags)
+{
+    Game game;
+    game.result = Result::BLACK_WINS;
+    game.reason = "Black mates";
+    game.sans = {"f3", "e5", "g4", "Qh4#"};
+
+    std::ostringstream os;
+    write_pgn(os, game, Opening{board::Chessboard(), "startpos", ""}, 3,
+              "new \"build\"", "old");
+    const std::string pgn = os.str();
+    EXPECT_EQ(pgn.rfind("[Event \"chess-match\"]\n[Site \"?\"]\n[Date \"", 0),
+              0);
+    EXPECT_NE(pgn.find("\"]\n[Round \"3\"]\n[White \"new \\\"build\\\"\"]\n"
+                       "[Black \"old\"]\n[Result \"0-1\"]\n"
+                       "[Termination \"normal\"]\n\n"),
+              std::string::npos);
+    // The initial position needs no FEN
+    EXPECT_EQ(pgn.find("[SetUp"), std::string::npos);
+    EXPECT_EQ(pgn.find("[FEN"), std::string::npos);
+    EXPECT_EQ(movetext(pgn), "1. f3 e5 2. g4 Qh4# {Black mates} 0-1\n\n");
+}
+
+TEST(Match, WritePgnBlackToMove)
+{
+    const std::string fen = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR"
+                            " b KQkq - 0 7";
+    Game game;
+    game.termination = "adjudication";
+    game.reason = "Draw by adjudication";
+    game.sans = {"e5", "Nf3", "Nc6", "Bb5"};
+
+    std::ostringstream os;
+    write_pgn(os, game, opening_of(fen), 1, "a", "b");
+    const std::string pgn = os.str();
+    EXPECT_NE(pgn.find("[Result \"1/2-1/2\"]\n[SetUp \"1\"]\n[FEN \"" + fen
+                       + "\"]\n[Termination \"adjudication\"]\n"),
+              std::string::npos);
+    EXPECT_EQ(movetext(pgn), "7... e5 8. Nf3 Nc6 9. Bb5 "
+                             "{Draw by adjudication} 1/2-1/2\n\n");
+}
+
+TEST(Match, WritePgnWrapping)
+{
+    Game game;
+    game.reason = "Draw by repetition";
+    for (int i = 0; i < 60; ++i)
+        game.sans.push_back(i % 4 < 2 ? (i % 2 ? "Nf6" : "Nf3")
+                                      : (i % 2 ? "Ng8" : "Ng1"));
+
+    std::ostringstream os;
+    write_pgn(os, game, Opening{board::Chessboard(), "startpos", ""}, 1,
+              "a", "b");
+    const std::string text = movetext(os.str());
+    ASSERT_EQ(text.substr(text.size() - 2), "\n\n");
+
+    std::vector<std::string> lines;
+    std::istringstream stream(text.substr(0, text.size() - 2));
+    for (std::string line; std::getline(stream, line);)
+        lines.push_back(line);
+    ASSERT_GT(lines.size(), 3);
+
+    std::string joined;
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        const std::string& line = lines[i];
+        EXPECT_LE(line.size(), 80) << line;
+        EXPECT_NE(line.front(), ' ');
+        EXPECT_NE(line.back(), ' ');
+        // A move number stays on the line of its move
+        EXPECT_NE(line.back(), '.') << line;
+        // The first token of the next line would not have fit
+        if (i + 1 < lines.size())
+        {
+            const std::string& next = lines[i + 1];
+            auto end = next.find(' ');
+            if (next[end - 1] == '.')
+                end = next.find(' ', end + 1);
+            EXPECT_GT(line.size() + 1 + end, 80) << line;
+        }
+        joined += (joined.empty() ? "" : " ") + line;
+    }
+    EXPECT_EQ(joined.rfind("1. Nf3 Nf6 2. Ng1 Ng8 3. Nf3", 0), 0);
+    EXPECT_NE(joined.find(" 30. Ng1 Ng8 {Draw by repetition} 1/2-1/2"),
+              std::string::npos);
+}
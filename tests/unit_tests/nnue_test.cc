@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <climits>
+#include <random>
+#include <fstream>
+#include <vector>
+
+#include "chess_engine/ai/evaluation.hh"
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/nnue/network.hh"
+#include "chess_engine/nnue/accumulator.hh"
+
+using namespace board;
+
+namespace
+{
+    template <typename T>
+    void write_random(std::ofstream& file, std::mt19937& gen,
+                      const size_t size, const int range)
+    {
+        std::uniform_int_distribution<int> dist(-range, range);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const T value = dist(gen);
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    template <typename T>
+    void write_value(std::ofstream& file, const T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::string write_random_network(const uint32_t magic = nnue::file_magic,
+                                     const unsigned seed = 42)
+    {
+        const std::string path = "nnue_test_network.bin";
+        std::ofstream file(path, std::ios::binary);
+        std::mt19937 gen(seed);
+
+        write_value<uint32_t>(file, magic);
+        write_value<uint32_t>(file, nnue::file_version);
+        write_value<uint32_t>(file, nnue::half_dimensions);
+        write_value<uint32_t>(file, nnue::l1_dimensions);
+        write_value<uint32_t>(file, nnue::l2_dimensions);
+        write_random<int16_t>(file, gen, nnue::half_dimensions, 64);
+        write_random<int16_t>(file, gen,
+                nnue::input_dimensions * nnue::half_dimensions, 8);
+        write_random<int32_t>(file, gen, nnue::l1_dimensions, 512);
+        write_random<int16_t>(file, gen,
+                nnue::l1_dimensions * 2 * nnue::half_dimensions, 16);
+        write_random<int32_t>(file, gen, nnue::l2_dimensions, 512);
+        write_random<int16_t>(file, gen,
+                nnue::l2_dimensions * nnue::l1_dimensions, 64);
+        write_value<int32_t>(file, 0);
+        write_random<int16_t>(file, gen, nnue::l2_dimensions, 64);
+
+        return path;
+    }
+
+    void expect_same_accumulator(const Board& board,
+                                 const nnue::Accumulator& incremental)
+    {
+        nnue::Accumulator fresh;
+        for (const auto color : {Color::WHITE, Color::BLACK})
+        {
+            ASSERT_TRUE(incremental.is_computed(color));
+            fresh.refresh(board, color);
+            for (size_t i = 0; i < nnue::half_dimensions; ++i)
+                EXPECT_EQ(fresh.get_values(color)[i],
+                          incremental.get_values(color)[i]);
+        }
+    }
+}
+
+TEST(Nnue, LoadBadMagic)
+{
+    const std::string path = write_random_network(0xdeadbeef);
+    EXPECT_FALSE(nnue::Network::load(path));
+    EXPECT_EQ(nnue::Network::get(), nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(Nnue, LoadMissingFile)
+{
+    EXPECT_FALSE(nnue::Network::load("this/file/does/not/exist.bin"));
+    EXPECT_EQ(nnue::Network::get(), nullptr);
+}
+
+TEST(Nnue, IncrementalUpdateMatchesRefresh)
+{
+    const std::string path = write_random_network();
+    ASSERT_TRUE(nnue::Network::load(path));
+    std::remove(path.c_str());
+
+    // The stack keeps pointers to the boards of the line
+    std::vector<Chessboard> line(1);
+    line.reserve(41);
+    nnue::AccumulatorStack accumulators;
+    accumulators.push(0, line[0].get_board());
+
+    // Quiet moves, captures, castling and king moves
+    for (int i = 1; i <= 40; ++i)
+    {
+        Chessboard board = line.back();
+        const auto moves = board.generate_legal_moves();
+        if (moves.empty())
+            break;
+        board.do_move(moves[(i * 7) % moves.size()]);
+        line.push_back(board);
+        accumulators.push(i, line.back().get_board());
+        // Some plies are only computed from a farther ancestor
+        if (i % 3 != 0)
+            expect_same_accumulator(line.back().get_board(),
+                                    accumulators.get(i));
+    }
+
+    // The search and the evaluation out of it agree
+    for (int i = line.size() - 1; i > 0; i -= 5)
+        EXPECT_EQ(ai::evaluate(line[i], INT_MIN, INT_MAX, &accumulators, i),
+                  ai::evaluate(line[i]));
+
+    nnue::Network::unload();
+}
+
+TEST(Nnue, NetworkChangeInvalidatesAccumulators)
+{
+    std::string path = write_random_network();
+    ASSERT_TRUE(nnue::Network::load(path));
+    std::remove(path.c_str());
+
+    Chessboard board;
+    nnue::AccumulatorStack accumulators;
+    accumulators.push(0, board.get_board());
+    const int before = ai::evaluate(board, INT_MIN, INT_MAX,
+                                    &accumulators, 0);
+
+    nnue::Accumulator accumulator;
+    accumulator.refresh(board.get_board(), Color::WHITE);
+    EXPECT_TRUE(accumulator.is_computed(Color::WHITE));
+
+    path = write_random_network(nnue::file_magic, 7);
+    ASSERT_TRUE(nnue::Network::load(path));
+    std::remove(path.c_str());
+    EXPECT_FALSE(accumulator.is_computed(Color::WHITE));
+
+    // Computed again with the new network, without being pushed again
+    const int after = ai::evaluate(board, INT_MIN, INT_MAX,
+                                   &accumulators, 0);
+    EXPECT_EQ(after, ai::evaluate(board));
+    EXPECT_NE(before, after);
+
+    nnue::Network::unload();
+}
+
+TEST(Nnue, SymetricEvaluation)
+{
+    const std::string path = write_random_network();
+    ASSERT_TRUE(nnue::Network::load(path));
+    std::remove(path.c_str());
+
+    Chessboard white("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R",
+                     Color::WHITE);
+    Chessboard black("rnbqkb1r/pppp1ppp/5n2/4p3/4P3/2N5/PPPP1PPP/R1BQKBNR",
+                     Color::BLACK);
+
+    EXPECT_EQ(ai::evaluate(white), -ai::evaluate(black));
+
+    nnue::Network::unload();
+}
+
+TEST(Nnue, ClassicFallback)
+{
+    Chessboard board;
+    nnue::Network::unload();
+    EXPECT_EQ(ai::evaluate(board), ai::evaluate_material(board)
+                                   + ai::evaluate_squares(board)
+                                   + ai::evaluate_king_safety(board));
+}
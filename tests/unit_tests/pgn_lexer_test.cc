@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include "parsing/pgn_parser/pgn-exception.hh"
+#include "parsing/pgn_parser/pgn-lexer.hh"
+#include "parsing/pgn_parser/pgn-parser.hh"
+
+using namespace pgn_parser;
+
+TEST(PgnLexer, SanMoves)
+{
+    for (const auto word : {"e4", "e2e4", "e2-e4", "Nf3", "Ng1-f3", "Nbd7",
+                            "R1a2", "Qh4xe1#", "exd5", "e7e8=Q+", "a1"})
+        EXPECT_TRUE(lexer::is_san_move(word)) << word;
+
+    for (const auto word : {"", "e", "e9", "i4", "Pe4", "e4++", "e8=K",
+                            "e8=", "Nbb1d7", "xe4x", "e4 ", "O-O"})
+        EXPECT_FALSE(lexer::is_san_move(word)) << word;
+}
+
+TEST(PgnLexer, Castling)
+{
+    for (const auto word : {"O-O", "O-O-O", "O-O+", "O-O-O#"})
+        EXPECT_TRUE(lexer::is_castling(word)) << word;
+
+    for (const auto word : {"O", "O-O-O-O", "O-O++", "0-0", "O-O-"})
+        EXPECT_FALSE(lexer::is_castling(word)) << word;
+}
+
+TEST(PgnLexer, TurnNumbersAndTags)
+{
+    EXPECT_TRUE(lexer::is_turn_number("1"));
+    EXPECT_TRUE(lexer::is_turn_number("120"));
+    EXPECT_FALSE(lexer::is_turn_number(""));
+    EXPECT_FALSE(lexer::is_turn_number("1a"));
+
+    EXPECT_TRUE(lexer::is_tag_line("[Event \"?\"]"));
+    EXPECT_TRUE(lexer::is_tag_line("[]"));
+    EXPECT_FALSE(lexer::is_tag_line("["));
+    EXPECT_FALSE(lexer::is_tag_line("1. e4 [x]"));
+}
+
+TEST(PgnLexer, ParserErrors)
+{
+    EXPECT_NO_THROW(parse_action("Nf3+"));
+    EXPECT_THROW(parse_action("Nz3"), PgnParsingException);
+    EXPECT_THROW(parse_turn_number("one"), PgnParsingException);
+    EXPECT_THROW(parse_castling("O-O-O-O", board::Color::WHITE),
+                 PgnParsingException);
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "parsing/pgn_parser/pgn-exception.hh"
+#include "parsing/pgn_parser/pgn-parser.hh"
+#include "parsing/pgn_parser/pgn-reader.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace pgn_parser;
+
+namespace
+{
+    std::vector<std::string> to_strings(
+            const std::vector<std::string_view>& views)
+    {
+        return std::vector<std::string>(views.begin(), views.end());
+    }
+} // namespace
+
+TEST(PgnReader, MultipleGames)
+{
+    auto reader = PgnReader::from_text(
+        "[Event \"First\"]\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1. e4 e5 2. Nf3 1-0\n"
+        "\n"
+        "[Event \"Second\"]\n"
+        "\n"
+        "1.d4 d5 1/2-1/2\n"
+        "1. c4 *\n");
+    PgnGameView game;
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("Event"), "First");
+    EXPECT_EQ(game.tag("Result"), "1-0");
+    EXPECT_FALSE(game.tag("Site").has_value());
+    EXPECT_EQ(to_strings(game.moves),
+              (std::vector<std::string>{"e4", "e5", "Nf3"}));
+    EXPECT_EQ(game.result, GameResult::WHITE_WIN);
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("Event"), "Second");
+    EXPECT_EQ(to_strings(game.moves), (std::vector<std::string>{"d4", "d5"}));
+    EXPECT_EQ(game.result, GameResult::DRAW);
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_TRUE(game.tags.empty());
+    EXPECT_EQ(to_strings(game.moves), (std::vector<std::string>{"c4"}));
+    EXPECT_EQ(game.result, GameResult::UNKNOWN);
+
+    EXPECT_FALSE(reader.next(game));
+    EXPECT_EQ(reader.get_game_count(), 3);
+}
+
+TEST(PgnReader, CommentsAndVariations)
+{
+    auto reader = PgnReader::from_text(
+        "% escaped line 1. a4\n"
+        "[White \"Tal, \\\"Misha\\\"\"]\n"
+        "1. e4 {best by test (1. d4)} e5 $1 2. Nf3!? ; rest of line f4\n"
+        "(2. f4 exf4 (2... d5 {counter} 3. exd5) 3. Nf3) 2... Nc6\n"
+        "3... a6 0-1");
+    PgnGameView game;
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("White"), "Tal, \\\"Misha\\\"");
+    EXPECT_EQ(to_strings(game.moves),
+              (std::vector<std::string>{"e4", "e5", "Nf3", "Nc6", "a6"}));
+    EXPECT_EQ(game.result, GameResult::BLACK_WIN);
+    EXPECT_FALSE(reader.next(game));
+}
+
+TEST(PgnReader, ZeroCastling)
+{
+    auto reader = PgnReader::from_text(
+        "1. e4 e5 2. Nf3 Nc6 3. Bc4 d6 4. 0-0 Be6 5. d3 Qd7 6. Nc3 0-0-0\n"
+        "7. a3 0-1");
+    PgnGameView game;
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(to_strings(game.moves),
+              (std::vector<std::string>{"e4", "e5", "Nf3", "Nc6", "Bc4", "d6",
+                                        "0-0", "Be6", "d3", "Qd7", "Nc3",
+                                        "0-0-0", "a3"}));
+    EXPECT_EQ(game.result, GameResult::BLACK_WIN);
+}
+
+TEST(PgnReader, MissingResult)
+{
+    auto reader = PgnReader::from_text(
+        "[Event \"First\"]\n1. e4 e5\n"
+        "[Event \"Second\"]\n1. d4 1-0\n");
+    PgnGameView game;
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.moves.size(), 2);
+    EXPECT_EQ(game.result, GameResult::UNKNOWN);
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("Event"), "Second");
+}
+
+TEST(PgnReader, ErrorRecovery)
+{
+    auto reader = PgnReader::from_text(
+        "[Event \"Broken\"]\n1. e4 {never closed e5 1-0\n"
+        "[Event \"Bad number\"]\n1a. e4 1-0\n"
+        "[Event \"Fine\"]\n1. e4 1-0\n");
+    PgnGameView game;
+
+    EXPECT_THROW(reader.next(game), PgnParsingException);
+    EXPECT_THROW(reader.next(game), PgnParsingException);
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("Event"), "Fine");
+    EXPECT_FALSE(reader.next(game));
+}
+
+TEST(PgnReader, Database)
+{
+    PgnReader reader(CHESS_TEST_DATA "/eval-pgn/Tal.pgn");
+    PgnGameView game;
+
+    size_t moves = 0;
+    while (reader.next(game))
+    {
+        EXPECT_TRUE(game.tag("White").has_value());
+        EXPECT_NE(game.result, GameResult::UNKNOWN);
+        moves += game.moves.size();
+    }
+    EXPECT_EQ(reader.get_game_count(), 6);
+    EXPECT_GT(moves, 6 * 20);
+}
+
+TEST(PgnReader, MissingFile)
+{
+    EXPECT_THROW(PgnReader("/nonexistent/games.pgn"), PgnParsingException);
+}
+
+TEST(PgnReader, ParsePgnFirstGame)
+{
+    board::MoveInitialization::get_instance();
+    const auto path = std::filesystem::temp_directory_path()
+                      / "pgn_reader_test.pgn";
+    std::ofstream(path)
+        << "[Event \"First\"]\n\n"
+        << "1. e4 {open game} e5 (1... c5 2. Nf3) 2. Nf3 Nc6 3. Bc4 Bc5\n"
+        << "4. 0-0 Nf6 1-0\n\n"
+        << "[Event \"Second\"]\n\n1. d4 d5 0-1\n";
+
+    const auto moves = parse_pgn(path.string());
+    std::filesystem::remove(path);
+    ASSERT_EQ(moves.size(), 8);
+    EXPECT_TRUE(moves[6].to_Move().get_king_castling());
+}
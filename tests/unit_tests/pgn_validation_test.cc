@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/board/move-initialization.hh"
+#include "parsing/pgn_parser/pgn-reader.hh"
+#include "parsing/pgn_parser/pgn-validation.hh"
+#include "utils/utype.hh"
+
+using namespace board;
+using namespace pgn_parser;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    GameReport validate(const std::string& text)
+    {
+        MoveInitialization::get_instance();
+        auto reader = PgnReader::from_text(text);
+        PgnGameView game;
+        Chessboard board;
+        EXPECT_TRUE(reader.next(game));
+        return validate_game(game, board);
+    }
+
+    size_t count(const ValidationSummary& summary, const GameStatus status)
+    {
+        return summary.counts[utils::utype(status)];
+    }
+} // namespace
+
+TEST(PgnValidation, LegalGames)
+{
+    EXPECT_EQ(validate("[Result \"1-0\"]\n1. e4 e5 2. Nf3 Nc6 3. Bb5 1-0")
+              .status, GameStatus::LEGAL);
+    EXPECT_EQ(validate("1. f3 e5 2. g4 Qh4# 0-1").status, GameStatus::LEGAL);
+    EXPECT_EQ(validate("[FEN \"7k/5Q2/6K1/8/8/8/8/8 w - - 0 1\"]\n"
+                       "1. Qg7# 1-0").status, GameStatus::LEGAL);
+    EXPECT_EQ(validate("[FEN \"7k/8/5QK1/8/8/8/8/8 w - - 0 1\"]\n"
+                       "1. Qf7 1/2-1/2").status, GameStatus::LEGAL);
+    // Castling written with zeros
+    EXPECT_EQ(validate("1. e4 e5 2. Nf3 Nc6 3. Bc4 d6 4. 0-0 Be6 5. d3 Qd7 "
+                       "6. Nc3 0-0-0 *").status, GameStatus::LEGAL);
+}
+
+TEST(PgnValidation, IllegalMove)
+{
+    const GameReport report = validate("1. e4 e5 2. Ke3 Nc6 1-0");
+
+    EXPECT_EQ(report.status, GameStatus::ILLEGAL_MOVE);
+    EXPECT_EQ(report.ply, 3);
+    EXPECT_EQ(validate("1. e4 e5 2. d4 Nc6 3. Kd3 *").ply, 5);
+    EXPECT_EQ(validate("[FEN \"bad\"]\n1. e4 *").status,
+              GameStatus::SYNTAX_ERROR);
+}
+
+TEST(PgnValidation, ResultMismatch)
+{
+    EXPECT_EQ(validate("[Result \"0-1\"]\n1. e4 e5 1-0").status,
+              GameStatus::RESULT_MISMATCH);
+    EXPECT_EQ(validate("1. f3 e5 2. g4 Qh4# 1-0").status,
+              GameStatus::RESULT_MISMATCH);
+    EXPECT_EQ(validate("[FEN \"7k/8/5QK1/8/8/8/8/8 w - - 0 1\"]\n"
+                       "1. Qf7 1-0").status, GameStatus::RESULT_MISMATCH);
+    // Nothing to check against an unknown result
+    EXPECT_EQ(validate("1. f3 e5 2. g4 Qh4# *").status, GameStatus::LEGAL);
+}
+
+TEST(PgnValidation, Database)
+{
+    const fs::path directory = fs::temp_directory_path()
+                               / "pgn_validation_test";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+    std::ofstream(directory / "games.pgn")
+        << "[Event \"Legal\"]\n1. e4 e5 1-0\n"
+        << "[Event \"Illegal\"]\n1. e4 e4 1-0\n"
+        << "[Event \"Broken\"]\n1. e4 {unclosed 1-0\n"
+        << "[Event \"Mismatch\"]\n1. f3 e5 2. g4 Qh4# 1/2-1/2\n"
+        << "[Event \"Legal\"]\n1. d4 d5 0-1\n";
+
+    std::ostringstream report;
+    const ValidationSummary summary = validate_games({directory.string()},
+                                                     4, report);
+    fs::remove_all(directory);
+
+    EXPECT_EQ(summary.games, 5);
+    EXPECT_EQ(count(summary, GameStatus::LEGAL), 2);
+    EXPECT_EQ(count(summary, GameStatus::SYNTAX_ERROR), 1);
+    EXPECT_EQ(count(summary, GameStatus::ILLEGAL_MOVE), 1);
+    EXPECT_EQ(count(summary, GameStatus::RESULT_MISMATCH), 1);
+    EXPECT_NE(report.str().find("game 2: illegal move at ply 2"),
+              std::string::npos);
+}
+
+TEST(PgnValidation, EvalDatabases)
+{
+    std::ostringstream report;
+    const ValidationSummary summary =
+            validate_games({CHESS_TEST_DATA "/eval-pgn"}, 2, report);
+
+    EXPECT_GT(summary.games, 0);
+    EXPECT_EQ(count(summary, GameStatus::LEGAL), summary.games)
+        << report.str();
+}
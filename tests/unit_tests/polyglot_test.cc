@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/book/polyglot.hh"
+#include "parsing/perft_parser/perft-parser.hh"
+
+using namespace board;
+using namespace perft_parser;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    Chessboard from_fen(const std::string& fen)
+    {
+        return Chessboard(parse_perft(fen + " 0"));
+    }
+
+    uint16_t polyglot_move(const int from, const int to)
+    {
+        return static_cast<uint16_t>(from << 6 | to);
+    }
+
+    struct Entry
+    {
+        uint64_t key;
+        uint16_t move;
+        uint16_t weight;
+    };
+
+    void write_book(const fs::path& path, std::vector<Entry> entries)
+    {
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+        std::ofstream file(path, std::ios::binary);
+        for (const auto& entry : entries)
+        {
+            for (int shift = 56; shift >= 0; shift -= 8)
+                file.put(static_cast<char>(entry.key >> shift));
+            file.put(static_cast<char>(entry.move >> 8));
+            file.put(static_cast<char>(entry.move));
+            file.put(static_cast<char>(entry.weight >> 8));
+            file.put(static_cast<char>(entry.weight));
+            for (int i = 0; i < 4; ++i)
+                file.put(0);
+        }
+    }
+
+    const std::string castling_fen = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+
+    class PolyglotTest : public ::testing::Test
+    {
+    protected:
+        fs::path path_ = fs::temp_directory_path() / "polyglot_test.bin";
+
+        void SetUp() override
+        {
+            const uint64_t start = book::polyglot_key(Chessboard());
+            const uint64_t castling = book::polyglot_key(
+                    from_fen(castling_fen));
+
+            write_book(path_, {
+                {start, polyglot_move(12, 28), 3},    // e2e4
+                {start, polyglot_move(11, 27), 1},    // d2d4
+                {start, polyglot_move(12, 36), 5},    // e2e5: illegal
+                {castling, polyglot_move(4, 7), 1},   // e1h1: O-O
+                {castling, polyglot_move(4, 0), 0},   // e1a1: O-O-O
+                {start + 1, polyglot_move(6, 21), 1}, // Another position
+            });
+            ASSERT_TRUE(book::Book::load(path_.string()));
+        }
+
+        void TearDown() override
+        {
+            book::Book::unload();
+            fs::remove(path_);
+        }
+    };
+} // namespace
+
+TEST(PolyglotKey, StartPosition)
+{
+    EXPECT_EQ(book::polyglot_key(Chessboard()), 0x463b96181691fc9c);
+}
+
+TEST(PolyglotKey, ReferencePositions)
+{
+    const std::vector<std::pair<std::string, uint64_t>> positions = {
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+         0x823c9b50fd114196},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",
+         0x0756b94461c50fb0},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2",
+         0x662fafb965db29d4},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+         0x22a48b5a8e47ff78},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3",
+         0x652a607ca3f242c1},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4",
+         0x00fdd303c946bdd9},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3",
+         0x3c8123ea7b067637},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4",
+         0x5c3f9b829b279560},
+    };
+
+    for (const auto& [fen, key] : positions)
+        EXPECT_EQ(book::polyglot_key(from_fen(fen)), key) << fen;
+}
+
+TEST(PolyglotBook, InvalidFile)
+{
+    EXPECT_FALSE(book::Book::load("/nonexistent/book.bin"));
+    EXPECT_EQ(book::Book::get(), nullptr);
+}
+
+TEST_F(PolyglotTest, Lookup)
+{
+    const auto moves = book::Book::get()->lookup(Chessboard());
+
+    ASSERT_EQ(moves.size(), 2);
+    EXPECT_EQ(moves[0].move.get_end().get_index(), 28);
+    EXPECT_EQ(moves[0].weight, 3);
+    EXPECT_EQ(moves[1].move.get_end().get_index(), 27);
+    EXPECT_EQ(moves[1].weight, 1);
+}
+
+TEST_F(PolyglotTest, Castling)
+{
+    const auto moves = book::Book::get()->lookup(from_fen(castling_fen));
+
+    ASSERT_EQ(moves.size(), 2);
+    EXPECT_TRUE(moves[0].move.get_king_castling());
+    EXPECT_TRUE(moves[1].move.get_queen_castling());
+
+    // Zero weight moves are never played
+    for (int i = 0; i < 20; ++i)
+    {
+        const auto move = book::Book::get()->probe(from_fen(castling_fen));
+        ASSERT_TRUE(move.has_value());
+        EXPECT_TRUE(move->get_king_castling());
+    }
+}
+
+TEST_F(PolyglotTest, OutOfBook)
+{
+    Chessboard board = from_fen(
+            "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+
+    EXPECT_TRUE(book::Book::get()->lookup(board).empty());
+    EXPECT_FALSE(book::Book::get()->probe(board).has_value());
+}
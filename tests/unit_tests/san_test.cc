@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/board/move-initialization.hh"
+#include "parsing/perft_parser/perft-parser.hh"
+#include "parsing/pgn_parser/pgn-exception.hh"
+#include "parsing/pgn_parser/pgn-parser.hh"
+#include "parsing/pgn_parser/pgn-reader.hh"
+#include "parsing/pgn_parser/san.hh"
+
+using namespace board;
+using namespace pgn_parser;
+
+namespace
+{
+    Chessboard from_fen(const std::string& fen)
+    {
+        MoveInitialization::get_instance();
+        return Chessboard(perft_parser::parse_perft(fen + " 0"));
+    }
+
+    // Start and end squares, eg: g1f3
+    std::string squares(const Move& move)
+    {
+        std::string result;
+        for (const auto& position : {move.get_start(), move.get_end()})
+        {
+            result.push_back('a' + static_cast<int>(position.get_file()));
+            result.push_back('1' + static_cast<int>(position.get_rank()));
+        }
+        return result;
+    }
+} // namespace
+
+TEST(San, ShortAndLongForms)
+{
+    const Chessboard board = from_fen(
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    EXPECT_EQ(squares(san_to_move(board, "Nf3")), "g1f3");
+    EXPECT_EQ(squares(san_to_move(board, "Nf3!?")), "g1f3");
+    EXPECT_EQ(squares(san_to_move(board, "Ng1-f3")), "g1f3");
+    EXPECT_EQ(squares(san_to_move(board, "e4")), "e2e4");
+    EXPECT_EQ(squares(san_to_move(board, "e2e4")), "e2e4");
+    EXPECT_TRUE(san_to_move(board, "e4").get_double_pawn_push());
+}
+
+TEST(San, Errors)
+{
+    const Chessboard board = from_fen(
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    EXPECT_THROW(san_to_move(board, "Nd2"), PgnParsingException);
+    EXPECT_THROW(san_to_move(board, "e5"), PgnParsingException);
+    EXPECT_THROW(san_to_move(board, "Nz3"), PgnParsingException);
+    EXPECT_THROW(san_to_move(board, "Nf3g"), PgnParsingException);
+    EXPECT_THROW(san_to_move(board, "O-O"), PgnParsingException);
+}
+
+TEST(San, Disambiguation)
+{
+    const Chessboard knights = from_fen("4k3/8/8/8/8/5N2/8/1N2K3 w - - 0 1");
+    EXPECT_THROW(san_to_move(knights, "Nd2"), PgnParsingException);
+    EXPECT_EQ(squares(san_to_move(knights, "Nbd2")), "b1d2");
+    EXPECT_EQ(move_to_san(knights, san_to_move(knights, "Nfd2")), "Nfd2");
+
+    const Chessboard rooks = from_fen("4k3/8/8/8/8/8/8/R4RK1 w - - 0 1");
+    EXPECT_EQ(move_to_san(rooks, san_to_move(rooks, "Rad1")), "Rad1");
+
+    const Chessboard file = from_fen("4k3/8/8/R7/8/8/8/R5K1 w - - 0 1");
+    EXPECT_EQ(move_to_san(file, san_to_move(file, "R1a3")), "R1a3");
+
+    const Chessboard queens = from_fen("2k5/8/8/8/4Q2Q/8/8/K6Q w - - 0 1");
+    EXPECT_EQ(move_to_san(queens, san_to_move(queens, "Qh4e1")), "Qh4e1");
+}
+
+TEST(San, SpecialMoves)
+{
+    const Chessboard en_passant = from_fen(
+            "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1");
+    const Move capture = san_to_move(en_passant, "exd6");
+    EXPECT_TRUE(capture.get_en_passant());
+    EXPECT_EQ(move_to_san(en_passant, capture), "exd6");
+
+    const Chessboard promotion = from_fen("3r4/4P3/8/8/8/8/8/k3K3 w - - 0 1");
+    EXPECT_EQ(san_to_move(promotion, "e8=Q").get_promotion(),
+              PieceType::QUEEN);
+    EXPECT_EQ(san_to_move(promotion, "e8Q").get_promotion(),
+              PieceType::QUEEN);
+    EXPECT_EQ(move_to_san(promotion, san_to_move(promotion, "exd8=N")),
+              "exd8=N");
+    EXPECT_THROW(san_to_move(promotion, "e8"), PgnParsingException);
+
+    const Chessboard castling = from_fen(
+            "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    EXPECT_TRUE(san_to_move(castling, "O-O").get_king_castling());
+    EXPECT_TRUE(san_to_move(castling, "0-0-0").get_queen_castling());
+    EXPECT_EQ(move_to_san(castling, san_to_move(castling, "O-O-O")),
+              "O-O-O");
+}
+
+TEST(San, CheckAndMate)
+{
+    const Chessboard board = from_fen(
+        "r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 2 3");
+
+    EXPECT_EQ(move_to_san(board, san_to_move(board, "Qxf7")), "Qxf7#");
+    EXPECT_EQ(move_to_san(board, san_to_move(board, "Bxf7")), "Bxf7+");
+}
+
+TEST(San, RoundTrip)
+{
+    Chessboard board = from_fen(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    const auto moves = board.generate_legal_moves();
+    for (const auto& move : moves)
+        EXPECT_EQ(san_to_move(moves, move_to_san(board, move)), move)
+            << move_to_san(board, move);
+}
+
+TEST(San, MoveTextParser)
+{
+    MoveInitialization::get_instance();
+
+    const auto moves = string_to_move({"e4", "e5", "Nf3", "Nc6", "Bb5",
+                                       "a6", "O-O"});
+    EXPECT_EQ(moves.size(), 7);
+    EXPECT_THROW(string_to_move({"e4", "Ke7"}), PgnParsingException);
+
+    // An illegal long move ends the game, it is reported when played
+    EXPECT_EQ(string_to_move({"e2-e4", "e7-e4", "d2-d4"}).size(), 2);
+}
+
+TEST(San, Databases)
+{
+    MoveInitialization::get_instance();
+
+    for (const auto name : {"Alburt", "Kasparov", "Tal", "VachierLagrave"})
+    {
+        PgnReader reader(CHESS_TEST_DATA "/eval-pgn/" + std::string(name)
+                         + ".pgn");
+        PgnGameView game;
+        while (reader.next(game))
+            EXPECT_EQ(parse_game(game).moves.size(), game.moves.size());
+        EXPECT_GT(reader.get_game_count(), 0);
+    }
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include "match/sprt.hh"
+
+using namespace match;
+
+TEST(Sprt, Score)
+{
+    EXPECT_EQ(Score{}.games(), 0);
+    EXPECT_DOUBLE_EQ(Score{}.ratio(), 0.5);
+    EXPECT_EQ((Score{3, 2, 1}).games(), 6);
+    EXPECT_DOUBLE_EQ((Score{3, 2, 1}).ratio(), 4.0 / 6);
+}
+
+TEST(Sprt, EloEstimate)
+{
+    EXPECT_DOUBLE_EQ(elo_estimate(Score{}).elo, 0);
+    EXPECT_NEAR(elo_estimate(Score{10, 20, 10}).elo, 0, 1e-9);
+    // 3 points for 1: 400 * log10(3)
+    EXPECT_NEAR(elo_estimate(Score{3, 0, 1}).elo, 190.85, 0.01);
+    EXPECT_NEAR(elo_estimate(Score{1, 0, 3}).elo, -190.85, 0.01);
+
+    // The interval shrinks with the games
+    const auto few = elo_estimate(Score{10, 20, 8});
+    const auto many = elo_estimate(Score{1000, 2000, 800});
+    EXPECT_GT(few.error, many.error);
+    EXPECT_GT(many.error, 0);
+    EXPECT_NEAR(few.elo, many.elo, 1e-9);
+
+    // Finite for a perfect score
+    EXPECT_TRUE(std::isfinite(elo_estimate(Score{5, 0, 0}).elo));
+}
+
+TEST(Sprt, Bounds)
+{
+    const Sprt sprt;
+    EXPECT_NEAR(sprt.lower_bound(), -2.944, 0.001);
+    EXPECT_NEAR(sprt.upper_bound(), 2.944, 0.001);
+
+    Sprt strict;
+    strict.alpha = 0.01;
+    EXPECT_GT(strict.upper_bound(), sprt.upper_bound());
+}
+
+TEST(Sprt, LogLikelihoodRatio)
+{
+    const Sprt sprt;
+    EXPECT_DOUBLE_EQ(sprt.llr(Score{}), 0);
+    EXPECT_DOUBLE_EQ(sprt.llr(Score{0, 10, 0}), 0);
+
+    EXPECT_NEAR(sprt.llr(Score{100, 200, 80}), 0.528, 0.001);
+    EXPECT_NEAR(sprt.llr(Score{80, 200, 100}), -0.695, 0.001);
+    // Proportional to the games for the same ratios
+    EXPECT_NEAR(sprt.llr(Score{1000, 2000, 800}), 5.276, 0.001);
+}
+
+TEST(Sprt, Decide)
+{
+    const Sprt sprt;
+    EXPECT_EQ(sprt.decide(Score{}), Sprt::Decision::NONE);
+    EXPECT_EQ(sprt.decide(Score{100, 200, 80}), Sprt::Decision::NONE);
+    EXPECT_EQ(sprt.decide(Score{1000, 2000, 800}), Sprt::Decision::H1);
+    EXPECT_EQ(sprt.decide(Score{800, 2000, 1000}), Sprt::Decision::H0);
+}
@@ -0,0 +1,318 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "chess_engine/board/chessboard.hh"
+#include "chess_engine/syzygy/tablebase.hh"
+
+using namespace board;
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    // Smallest valid KQvK files: every position holds the same value
+    // White to move: WIN, black to move: LOSS, DTZ of 3 moves
+    std::vector<uint8_t> single_value_file(const bool dtz)
+    {
+        std::vector<uint8_t> data;
+        if (dtz)
+            data = {0xd7, 0x66, 0x0c, 0xa5};
+        else
+            data = {0x71, 0xe8, 0x23, 0x5d};
+
+        data.push_back(0x01); // Different material: split
+        data.push_back(0x00); // Groups order
+        for (uint8_t piece : {0x66, 0x55, 0xee}) // K, Q, k for both sides
+            data.push_back(piece);
+        data.push_back(0x00); // Alignment
+
+        // Single value tables, one per side to move
+        data.push_back(0x80);
+        data.push_back(dtz ? 3 : 4);
+        if (!dtz)
+        {
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+
+        data.resize(80, 0); // Size modulo 64 is 16
+        return data;
+    }
+
+    void write_file(const fs::path& path, const std::vector<uint8_t>& data)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    class SyzygyTest : public ::testing::Test
+    {
+    protected:
+        fs::path directory_ = fs::temp_directory_path() / "syzygy_test";
+
+        void SetUp() override
+        {
+            fs::remove_all(directory_);
+            fs::create_directories(directory_);
+            write_file(directory_ / "KQvK.rtbw", single_value_file(false));
+            write_file(directory_ / "KQvK.rtbz", single_value_file(true));
+            write_file(directory_ / "KRvK.rtbw", {0, 1, 2, 3});
+            write_file(directory_ / "KQvk.rtbw", {});
+            write_file(directory_ / "README.txt", {});
+            syzygy::init(directory_.string());
+        }
+
+        void TearDown() override
+        {
+            syzygy::init("");
+            fs::remove_all(directory_);
+        }
+    };
+
+    // KQvK and KRvK tables generated by tests/syzygy-tables.py
+    class SyzygyTables : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_EQ(syzygy::init(CHESS_TEST_DATA "/syzygy"), 2);
+        }
+
+        void TearDown() override
+        {
+            syzygy::init("");
+        }
+    };
+
+    // King and piece against king, nullopt if the side not to move is in
+    // check or the kings are next to each other
+    std::optional<Chessboard> position(const char piece, const int king,
+                                       const int square, const int black_king,
+                                       const Color side_to_move)
+    {
+        if (king == square || king == black_king || square == black_king)
+            return std::nullopt;
+
+        std::string squares(64, '1');
+        squares[king] = 'K';
+        squares[square] = piece;
+        squares[black_king] = 'k';
+        std::string placement;
+        for (int rank = 7; rank >= 0; --rank)
+        {
+            placement += squares.substr(rank * 8, 8);
+            if (rank)
+                placement += '/';
+        }
+
+        Chessboard other(placement, get_opposite_color(side_to_move));
+        const int files = king % 8 - black_king % 8;
+        const int ranks = king / 8 - black_king / 8;
+        if (other.is_check() || (std::abs(files) <= 1 && std::abs(ranks) <= 1))
+            return std::nullopt;
+        return Chessboard(placement, side_to_move);
+    }
+
+    // Each win of the side to move is one ply longer than the fastest loss
+    // it leads to, and the WDL of the other side to move agrees with DTZ
+    void expect_consistent(const char piece)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> square(0, 63);
+        int checked = 0;
+        while (checked < 100)
+        {
+            const auto board = position(piece, square(random), square(random),
+                                        square(random), Color::WHITE);
+            if (!board.has_value())
+                continue;
+            checked++;
+
+            const auto dtz = syzygy::probe_dtz(board.value());
+            ASSERT_TRUE(dtz.has_value());
+            EXPECT_EQ(syzygy::probe_wdl(board.value()), syzygy::Wdl::WIN);
+            EXPECT_EQ(dtz.value() % 2, 1);
+
+            int fastest = 1000;
+            Chessboard parent = board.value();
+            for (const auto& move : parent.generate_legal_moves())
+            {
+                Chessboard child = board.value();
+                child.do_move(move);
+                const auto child_dtz = syzygy::probe_dtz(child);
+                const auto child_wdl = syzygy::probe_wdl(child);
+                ASSERT_TRUE(child_dtz.has_value());
+                ASSERT_TRUE(child_wdl.has_value());
+                EXPECT_EQ(child_wdl.value() == syzygy::Wdl::LOSS,
+                          child_dtz.value() < 0);
+                EXPECT_EQ(child_wdl.value() == syzygy::Wdl::DRAW,
+                          child_dtz.value() == 0);
+                if (child.is_checkmate())
+                    fastest = 1;
+                else if (child_dtz.value() < 0)
+                    fastest = std::min(fastest, 1 - child_dtz.value());
+            }
+            EXPECT_EQ(dtz.value(), fastest);
+        }
+    }
+} // namespace
+
+TEST(SyzygyInit, MissingDirectory)
+{
+    EXPECT_EQ(syzygy::init("/nonexistent/syzygy"), 0);
+    EXPECT_EQ(syzygy::get_max_pieces(), 0);
+
+    Chessboard board = Chessboard("8/8/8/8/8/8/8/KQ5k", Color::WHITE);
+    EXPECT_FALSE(syzygy::probe_wdl(board).has_value());
+}
+
+TEST_F(SyzygyTest, ScanNames)
+{
+    EXPECT_EQ(syzygy::init(directory_.string() + ":/nonexistent"), 2);
+    EXPECT_EQ(syzygy::get_max_pieces(), 3);
+}
+
+TEST_F(SyzygyTest, CastlingRights)
+{
+    Chessboard board = Chessboard();
+
+    EXPECT_FALSE(syzygy::can_probe(board));
+}
+
+TEST_F(SyzygyTest, Wdl)
+{
+    Chessboard white = Chessboard("8/8/8/3k4/8/8/8/KQ6", Color::WHITE);
+    Chessboard black = Chessboard("8/8/8/3k4/8/8/8/KQ6", Color::BLACK);
+    Chessboard flipped = Chessboard("kq6/8/8/8/3K4/8/8/8", Color::BLACK);
+
+    EXPECT_EQ(syzygy::probe_wdl(white), syzygy::Wdl::WIN);
+    EXPECT_EQ(syzygy::probe_wdl(black), syzygy::Wdl::LOSS);
+    EXPECT_EQ(syzygy::probe_wdl(flipped), syzygy::Wdl::WIN);
+}
+
+TEST_F(SyzygyTest, CaptureIsSearched)
+{
+    // The black king takes the undefended queen: KvK
+    Chessboard board = Chessboard("8/8/8/8/8/3k4/3Q4/K7", Color::BLACK);
+
+    EXPECT_EQ(syzygy::probe_wdl(board), syzygy::Wdl::DRAW);
+}
+
+TEST_F(SyzygyTest, CorruptFile)
+{
+    Chessboard board = Chessboard("8/8/8/3k4/8/8/8/KR6", Color::WHITE);
+
+    EXPECT_FALSE(syzygy::probe_wdl(board).has_value());
+}
+
+TEST_F(SyzygyTest, Dtz)
+{
+    Chessboard white = Chessboard("8/8/8/3k4/8/8/8/KQ6", Color::WHITE);
+    Chessboard black = Chessboard("8/8/8/3k4/8/8/8/KQ6", Color::BLACK);
+
+    // 3 moves stored for white to move, one more ply for black
+    EXPECT_EQ(syzygy::probe_dtz(white), 7);
+    EXPECT_EQ(syzygy::probe_dtz(black), -8);
+}
+
+TEST_F(SyzygyTest, RootMovesMate)
+{
+    // A single ply left before the fifty moves rule
+    Chessboard board = Chessboard::from_fen("k7/2Q5/1K6/8/8/8/8/8 w - - 99 80");
+    std::vector<Move> moves = board.generate_legal_moves();
+
+    ASSERT_TRUE(syzygy::filter_root_moves(board, moves));
+    ASSERT_FALSE(moves.empty());
+    for (const auto& move : moves)
+    {
+        Chessboard child = board;
+        child.do_move(move);
+        EXPECT_TRUE(child.is_checkmate());
+    }
+}
+
+TEST_F(SyzygyTables, KnownResults)
+{
+    // Mate in one
+    const auto mate = Chessboard("7k/8/6K1/8/8/8/8/1Q6", Color::WHITE);
+    EXPECT_EQ(syzygy::probe_wdl(mate), syzygy::Wdl::WIN);
+    EXPECT_EQ(syzygy::probe_dtz(mate), 1);
+    const auto rook_mate = Chessboard("k7/8/1K6/8/8/8/8/7R", Color::WHITE);
+    EXPECT_EQ(syzygy::probe_dtz(rook_mate), 1);
+
+    // Mated
+    const auto mated = Chessboard("7k/6Q1/6K1/8/8/8/8/8", Color::BLACK);
+    EXPECT_EQ(syzygy::probe_wdl(mated), syzygy::Wdl::LOSS);
+    EXPECT_EQ(syzygy::probe_dtz(mated), -1);
+
+    // Stalemate
+    const auto stalemate = Chessboard("7k/5Q2/6K1/8/8/8/8/8", Color::BLACK);
+    EXPECT_EQ(syzygy::probe_wdl(stalemate), syzygy::Wdl::DRAW);
+    EXPECT_EQ(syzygy::probe_dtz(stalemate), 0);
+
+    // The black king takes the undefended rook
+    const auto capture = Chessboard("8/8/8/8/8/2K5/6kR/8", Color::BLACK);
+    EXPECT_EQ(syzygy::probe_wdl(capture), syzygy::Wdl::DRAW);
+
+    // The colors of the table swapped
+    const auto black_mate = Chessboard("1q6/8/8/8/8/6k1/8/7K", Color::BLACK);
+    EXPECT_EQ(syzygy::probe_wdl(black_mate), syzygy::Wdl::WIN);
+    EXPECT_EQ(syzygy::probe_dtz(black_mate), 1);
+    const auto white_mated = Chessboard("1q6/8/8/8/8/6k1/8/7K",
+                                        Color::WHITE);
+    EXPECT_EQ(syzygy::probe_wdl(white_mated), syzygy::Wdl::LOSS);
+}
+
+TEST_F(SyzygyTables, LongestWins)
+{
+    // Mate in 10 for KQvK, in 16 for KRvK
+    const auto queen = Chessboard("8/8/8/5k2/8/8/1Q6/K7", Color::WHITE);
+    EXPECT_EQ(syzygy::probe_dtz(queen), 19);
+    const auto rook = Chessboard("8/8/8/8/8/2k5/1R6/K7", Color::WHITE);
+    EXPECT_EQ(syzygy::probe_wdl(rook), syzygy::Wdl::WIN);
+    EXPECT_EQ(syzygy::probe_dtz(rook), 31);
+}
+
+TEST_F(SyzygyTables, ConsistentQueen)
+{
+    expect_consistent('Q');
+}
+
+TEST_F(SyzygyTables, ConsistentRook)
+{
+    expect_consistent('R');
+}
+
+TEST_F(SyzygyTables, RootMovesClock)
+{
+    const std::string placement = "8/8/8/8/8/2k5/1R6/K7 w - - ";
+    const auto kept = [&placement](const std::string& clock)
+    {
+        auto board = Chessboard::from_fen(placement + clock);
+        std::vector<Move> moves = board.generate_legal_moves();
+        EXPECT_TRUE(syzygy::filter_root_moves(board, moves));
+        return moves;
+    };
+
+    // 8 moves win in 31 plies, 4 in 33, the other ones draw or lose
+    EXPECT_EQ(kept("0 1").size(), 12);
+    // 32 plies left: only the fastest wins are still real
+    EXPECT_EQ(kept("68 40").size(), 8);
+    // Cursed win: the fastest moves are kept anyway
+    const auto cursed = kept("75 50");
+    ASSERT_EQ(cursed.size(), 8);
+    for (const auto& move : cursed)
+    {
+        auto child = Chessboard::from_fen(placement + "75 50");
+        child.do_move(move);
+        EXPECT_EQ(syzygy::probe_dtz(child), -30);
+    }
+}
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <sstream>
+
+#include "utils/trace.hh"
+
+using namespace utils;
+
+namespace
+{
+    size_t count(const std::string& str, const std::string& pattern)
+    {
+        size_t found = 0;
+        for (auto pos = str.find(pattern); pos != std::string::npos;
+             pos = str.find(pattern, pos + 1))
+            found++;
+        return found;
+    }
+} // namespace
+
+TEST(Trace, ChromeFormat)
+{
+    trace::clear();
+    {
+        trace::ScopedTimer timer("scope");
+        trace::record_counter("nodes", 42);
+    }
+    std::thread([]() { trace::ScopedTimer timer("other_thread"); }).join();
+
+    std::ostringstream os;
+    trace::flush(os);
+    const std::string json = os.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_EQ(count(json, "\"ph\":\"X\""), 2);
+    EXPECT_EQ(count(json, "\"name\":\"nodes\",\"ph\":\"C\""), 1);
+    EXPECT_NE(json.find("\"args\":{\"value\":42}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"other_thread\",\"ph\":\"X\",\"pid\":1,"
+                        "\"tid\":1"), std::string::npos);
+}
+
+TEST(Trace, RingBuffer)
+{
+    trace::clear();
+    for (size_t i = 0; i < trace::ring_size + 10; ++i)
+        trace::record_counter("counter", i);
+
+    std::ostringstream os;
+    trace::flush(os);
+    const std::string json = os.str();
+    // Only the last events are kept
+    EXPECT_EQ(count(json, "\"ph\":\"C\""), trace::ring_size);
+    EXPECT_EQ(json.find("\"args\":{\"value\":9}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":10}"), std::string::npos);
+}
+
+// Only the build_trace builds define CHESS_TRACE
+TEST(Trace, EnabledByBuild)
+{
+#ifdef CHESS_TRACE
+    EXPECT_TRUE(trace::enabled());
+#else
+    EXPECT_FALSE(trace::enabled());
+#endif /* CHESS_TRACE */
+
+    trace::clear();
+    {
+        TRACE_SCOPE("macro");
+    }
+    std::ostringstream os;
+    trace::flush(os);
+    EXPECT_EQ(count(os.str(), "\"name\":\"macro\""),
+              trace::enabled() ? 1 : 0);
+}
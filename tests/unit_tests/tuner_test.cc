@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include "tuner/tuner.hh"
+#include "chess_engine/board/move-initialization.hh"
+
+using namespace tuner;
+
+namespace
+{
+    Dataset small_dataset(void)
+    {
+        board::MoveInitialization::get_instance();
+        const auto path = std::filesystem::temp_directory_path()
+                          / "tuner_test.epd";
+        {
+            std::ofstream file(path);
+            file << "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq -"
+                    " 1/2-1/2\n"
+                 << "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w"
+                    " KQkq - 1-0\n"
+                 << "r3k2r/pp3ppp/2n1b3/3q4/8/2N5/PP3PPP/R2QR1K1 w kq - 0-1\n"
+                 << "8/5k2/8/3p4/8/2N5/5K2/8 b - - [0.75]\n"
+                 << "6k1/5ppp/8/8/8/8/1Q3PPP/6K1 w - - 1-0\n"
+                 << "4r1k1/pp3ppp/8/8/8/8/PP3PPP/3R2K1 b - - 1/2-1/2\n";
+        }
+        const Dataset dataset = load_dataset(path, 2);
+        std::filesystem::remove(path);
+        return dataset;
+    }
+} // namespace
+
+TEST(Tuner, GradientFiniteDifferences)
+{
+    const Dataset dataset = small_dataset();
+    ASSERT_EQ(dataset.size(), 6);
+
+    const parameters_t parameters = default_parameters();
+    const double scaling = 1.2;
+    const parameters_t analytic = gradient(dataset, parameters, scaling, 2);
+    ASSERT_EQ(analytic.size(), layout::size);
+
+    // Central differences on the parameters used by the dataset
+    constexpr double step = 1e-3;
+    size_t checked = 0;
+    for (size_t p = 0; p < layout::size; ++p)
+    {
+        parameters_t plus = parameters;
+        parameters_t minus = parameters;
+        plus[p] += step;
+        minus[p] -= step;
+        const double numeric = (mean_squared_error(dataset, plus, scaling, 1)
+                                - mean_squared_error(dataset, minus,
+                                                     scaling, 1))
+                               / (2 * step);
+        EXPECT_NEAR(analytic[p], numeric,
+                    1e-6 + 1e-4 * std::abs(numeric)) << "parameter " << p;
+        checked += numeric != 0;
+    }
+    EXPECT_GT(checked, 10);
+}
+
+TEST(Tuner, ParametersRoundTrip)
+{
+    parameters_t parameters = default_parameters();
+    for (size_t p = 0; p < parameters.size(); ++p)
+        parameters[p] += static_cast<int>(p % 7) - 3;
+
+    std::stringstream header;
+    write_parameters(header, parameters);
+    EXPECT_EQ(read_parameters(header), parameters);
+
+    std::istringstream truncated(header.str().substr(0, 1000));
+    EXPECT_THROW(read_parameters(truncated), std::invalid_argument);
+}
+
+TEST(Tuner, CompiledParameters)
+{
+    // The defaults are the values of the compiled header
+    std::ifstream file(CHESS_TEST_DATA
+                       "/../src/chess_engine/ai/evaluation-params.hh");
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(read_parameters(file), default_parameters());
+}
@@ -1,10 +1,12 @@
 #include "gtest/gtest.h"
 
 #include <string>
+#include <sstream>
 
 #include "chess_engine/board/entity/move.hh"
 #include "chess_engine/board/entity/position.hh"
 #include "chess_engine/board/entity/piece-type.hh"
+#include "chess_engine/ai/uci.hh"
 #include "parsing/pgn_parser/ebnf-parser.hh"
 
 using namespace board;
@@ -76,48 +78,193 @@ TEST(EBNFParser, StringToMoveEnPassant)
 
 TEST(UCIMove, BasePositionNoMove)
 {
-    Chessboard board;
     Chessboard expected;
+    uci::Position position;
 
-    add_move_to_board(board, "position startpos");
-    EXPECT_EQ(expected, board);
+    EXPECT_TRUE(position.set("position startpos"));
+    EXPECT_EQ(expected, position.board());
 }
 
 TEST(UCIMove, basePositionMove)
 {
-    Chessboard board;
     Chessboard expected;
     expected.do_move(Move(Position(File::A, Rank::TWO), Position(File::A, Rank::FOUR), PieceType::PAWN, false, true, false, false, false));
 
-    add_move_to_board(board, "position startpos moves a2a4");
-    EXPECT_EQ(expected, board);
+    uci::Position position;
+    EXPECT_TRUE(position.set("position startpos moves a2a4"));
+    EXPECT_EQ(expected, position.board());
 }
 
 TEST(UCIMove, fenStrNoMove)
 {
-    string str = "r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6";
-    std::vector<std::string> tokens;
-    boost::split(tokens, str, boost::is_any_of(" "));
-    Chessboard expected(parse_fen(tokens));
-    Chessboard board;
+    Chessboard expected = Chessboard::from_fen("r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6");
 
-    add_move_to_board(board, "position fen r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6");
-
-    EXPECT_EQ(expected, board);
+    uci::Position position;
+    EXPECT_TRUE(position.set("position fen r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6"));
+    EXPECT_EQ(expected, position.board());
 }
 
 TEST(UCMove, fenStrMove)
 {
-    string str = "r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6";
-    std::vector<std::string> tokens;
-    boost::split(tokens, str, boost::is_any_of(" "));
-    Chessboard expected(parse_fen(tokens));
-    expected.do_move(Move(Position(File::A, Rank::TWO), Position(File::A, Rank::THREE), PieceType::PAWN, false, false, false, false, false));
+    Chessboard expected = Chessboard::from_fen("r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6");
+    expected.do_move(Move(Position(File::A, Rank::SEVEN), Position(File::A, Rank::SIX), PieceType::PAWN, false, false, false, false, false));
+
+    uci::Position position;
+    EXPECT_TRUE(position.set("position fen r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6 moves a7a6"));
+    EXPECT_EQ(expected, position.board());
+}
+
+TEST(UCIMove, WholeMoveList)
+{
+    uci::Position position;
+    EXPECT_TRUE(position.set("position startpos moves e2e4 e7e5"));
+    EXPECT_EQ(position.moves_played(), 2);
+
+    // The game goes on: only the new moves are played
+    EXPECT_TRUE(position.set("position startpos moves e2e4 e7e5 g1f3 b8c6"));
+    EXPECT_EQ(position.moves_played(), 2);
+    EXPECT_EQ(position.board(),
+              Chessboard::from_fen("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3"));
+
+    // Another game: the board is rebuilt
+    EXPECT_TRUE(position.set("position startpos moves d2d4"));
+    EXPECT_EQ(position.moves_played(), 1);
+    EXPECT_EQ(position.board(),
+              Chessboard::from_fen("rnbqkbnr/pppppppp/8/8/3P4/8/PPP1PPPP/RNBQKBNR b KQkq d3 0 1"));
+
+    EXPECT_TRUE(position.set("position fen 8/8/8/8/8/8/k7/7K w - - 0 1"));
+    EXPECT_EQ(position.moves_played(), 0);
+    EXPECT_EQ(position.board(), Chessboard::from_fen("8/8/8/8/8/8/k7/7K w - -"));
+}
+
+TEST(UCIMove, Repetition)
+{
+    uci::Position position;
+    EXPECT_TRUE(position.set("position startpos moves g1f3 g8f6 f3g1 f6g8"));
+    EXPECT_TRUE(position.set("position startpos moves g1f3 g8f6 f3g1 f6g8 "
+                             "g1f3 g8f6 f3g1 f6g8"));
+    Chessboard board = position.board();
+    EXPECT_TRUE(board.is_draw());
+}
+
+TEST(UCIMove, Invalid)
+{
+    uci::Position position;
+    // The board is the position before the illegal move
+    EXPECT_FALSE(position.set("position startpos moves e2e4 e2e4"));
+    EXPECT_EQ(position.board(),
+              Chessboard::from_fen("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"));
+    EXPECT_FALSE(position.set("position fen 8/8/8 w - - 0 1"));
+    EXPECT_FALSE(position.set("position"));
+}
+
+TEST(UCIGo, Parse)
+{
+    const auto depth = uci::parse_go("go depth 6");
+    EXPECT_EQ(depth.depth, 6);
+    EXPECT_FALSE(depth.movetime.has_value());
+    EXPECT_FALSE(depth.wtime.has_value());
+
+    const auto clock = uci::parse_go("go wtime 60000 btime 58000 winc 1000 "
+                                     "binc 500 movestogo 20");
+    EXPECT_FALSE(clock.depth.has_value());
+    EXPECT_EQ(clock.wtime, std::chrono::milliseconds(60000));
+    EXPECT_EQ(clock.btime, std::chrono::milliseconds(58000));
+    EXPECT_EQ(clock.winc, std::chrono::milliseconds(1000));
+    EXPECT_EQ(clock.binc, std::chrono::milliseconds(500));
+    EXPECT_EQ(clock.movestogo, 20);
+
+    EXPECT_EQ(uci::parse_go("go movetime 250").movetime,
+              std::chrono::milliseconds(250));
+    EXPECT_TRUE(uci::parse_go("go infinite").infinite);
+
+    const auto ponder = uci::parse_go("go ponder wtime 1000 btime 2000");
+    EXPECT_TRUE(ponder.ponder);
+    EXPECT_FALSE(ponder.infinite);
+    EXPECT_EQ(ponder.btime, std::chrono::milliseconds(2000));
+}
+
+TEST(UCILoop, Options)
+{
+    std::vector<std::string> hash_values;
+    int clears = 0;
+    int new_games = 0;
+    std::vector<std::string> positions;
+
+    uci::Engine engine;
+    engine.options = {
+        {"Hash", uci::Option::Type::SPIN, "16", 1, 1024,
+         [&](const std::string& value) { hash_values.push_back(value); }},
+        {"Clear Hash", uci::Option::Type::BUTTON, "", 0, 0,
+         [&](const std::string&) { clears++; }},
+        {"Ponder", uci::Option::Type::CHECK, "false", 0, 0, nullptr},
+        {"BookFile", uci::Option::Type::STRING, "<empty>", 0, 0,
+         [](const std::string& value)
+         {
+             if (!value.empty())
+                 uci::info_string("book " + value + " loaded");
+         }},
+    };
+    engine.on_new_game = [&]() { new_games++; };
+    engine.on_position = [&](const std::string& command)
+    {
+        positions.push_back(command);
+    };
+    engine.on_go = [](const uci::GoCommand&)
+    {
+        uci::play_move("e2e4", "e7e5");
+    };
+    int stops = 0;
+    int ponderhits = 0;
+    engine.on_stop = [&]() { stops++; };
+    engine.on_ponderhit = [&]() { ponderhits++; };
+
+    std::istringstream input("uci\n"
+                             "setoption name hash value 64\n"
+                             "setoption name Hash value 100000\n"
+                             "setoption name Hash value big\n"
+                             "setoption name Clear Hash\n"
+                             "setoption name Ponder value true\n"
+                             "setoption name BookFile value /tmp/book.bin\n"
+                             "isready\n"
+                             "ucinewgame\n"
+                             "position startpos moves e2e4\n"
+                             "go depth 1\n"
+                             "ponderhit\n"
+                             "stop\n"
+                             "quit\n"
+                             "isready\n");
+    testing::internal::CaptureStdout();
+    uci::loop("engine", engine, input);
+    const std::string output = testing::internal::GetCapturedStdout();
 
-    Chessboard board;
-    add_move_to_board(board, "position fen r1bqkb1r/pp2pppp/2np1n2/6B1/3NP3/2N5/PPP2PPP/R2QKB1R b KQkq - 5 6 moves a2a3");
+    EXPECT_NE(output.find("id name engine\n"), std::string::npos);
+    EXPECT_NE(output.find("option name Hash type spin default 16 min 1 "
+                          "max 1024\n"), std::string::npos);
+    EXPECT_NE(output.find("option name Clear Hash type button\n"),
+              std::string::npos);
+    EXPECT_NE(output.find("option name BookFile type string default "
+                          "<empty>\n"), std::string::npos);
+    EXPECT_NE(output.find("uciok\n"), std::string::npos);
+    EXPECT_NE(output.find("info string invalid value big"),
+              std::string::npos);
+    EXPECT_NE(output.find("info string book /tmp/book.bin loaded\n"),
+              std::string::npos);
+    EXPECT_NE(output.find("bestmove e2e4 ponder e7e5\n"), std::string::npos);
+    // Nothing is answered after quit
+    EXPECT_EQ(output.find("readyok"), output.rfind("readyok"));
 
-    EXPECT_EQ(expected, board);
+    // The default, then the clamped values
+    EXPECT_EQ(hash_values, (std::vector<std::string>{"16", "64", "1024"}));
+    EXPECT_EQ(clears, 1);
+    EXPECT_EQ(new_games, 1);
+    EXPECT_EQ(stops, 1);
+    EXPECT_EQ(ponderhits, 1);
+    EXPECT_EQ(positions,
+              std::vector<std::string>{"position startpos moves e2e4"});
+    EXPECT_EQ(uci::option_value("Ponder"), "true");
+    EXPECT_EQ(uci::option_value("BOOKFILE"), "/tmp/book.bin");
+    EXPECT_EQ(uci::option_value("Unknown"), "");
 }
 
 // To start tests